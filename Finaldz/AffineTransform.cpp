@@ -0,0 +1,308 @@
+/**
+ * @file AffineTransform.cpp
+ * @brief Реализация аффинных преобразований
+ */
+
+#include "AffineTransform.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+
+const size_t TRANSFORM_BLOCK = 16384;  ///< Точек в одной задаче
+
+template <typename Func>
+void runBlocks(size_t count, bool parallel, Func func) {
+    if (parallel && count > TRANSFORM_BLOCK) {
+        Parallel::forEachBlock(count, TRANSFORM_BLOCK, func);
+    } else if (count > 0) {
+        func(0, 0, count);
+    }
+}
+
+/**
+ * @brief Применить матрицу 3x4 (или 3x3 при translate = false) к блоку векторов
+ *
+ * Коэффициенты копируются в локальные переменные, чтобы компилятор
+ * держал их в регистрах и не перечитывал из памяти на каждой итерации.
+ */
+void transformBlock(const double* m, size_t stride, bool translate,
+                    const std::vector<Vector3D>& in, std::vector<Vector3D>& out,
+                    size_t begin, size_t end) {
+    const double a00 = m[0], a01 = m[1], a02 = m[2];
+    const double a10 = m[stride], a11 = m[stride + 1], a12 = m[stride + 2];
+    const double a20 = m[2 * stride], a21 = m[2 * stride + 1], a22 = m[2 * stride + 2];
+    const double t0 = translate ? m[3] : 0.0;
+    const double t1 = translate ? m[stride + 3] : 0.0;
+    const double t2 = translate ? m[2 * stride + 3] : 0.0;
+
+    for (size_t i = begin; i < end; ++i) {
+        const double x = in[i].getX();
+        const double y = in[i].getY();
+        const double z = in[i].getZ();
+        out[i].set(a00 * x + a01 * y + a02 * z + t0,
+                   a10 * x + a11 * y + a12 * z + t1,
+                   a20 * x + a21 * y + a22 * z + t2);
+    }
+}
+
+} // namespace
+
+// Конструкторы
+AffineTransform::AffineTransform() {
+    for (int i = 0; i < 12; ++i) {
+        m_[i] = (i == 0 || i == 5 || i == 10) ? 1.0 : 0.0;
+    }
+    updateNormalMatrix();
+}
+
+AffineTransform::AffineTransform(const Matrix& matrix) {
+    if (matrix.getRows() != 4 || matrix.getCols() != 4) {
+        throw std::invalid_argument("Аффинное преобразование задается матрицей 4x4");
+    }
+    const double epsilon = 1e-10;
+    if (std::abs(matrix.get(3, 0)) > epsilon || std::abs(matrix.get(3, 1)) > epsilon ||
+        std::abs(matrix.get(3, 2)) > epsilon || std::abs(matrix.get(3, 3) - 1.0) > epsilon) {
+        throw std::invalid_argument("Последняя строка аффинной матрицы должна быть (0, 0, 0, 1)");
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        const std::vector<double>& row = matrix[i];
+        for (size_t j = 0; j < 4; ++j) {
+            m_[4 * i + j] = row[j];
+        }
+    }
+    updateNormalMatrix();
+}
+
+AffineTransform::AffineTransform(const double linear[9], const Vector3D& translation) {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            m_[4 * i + j] = linear[3 * i + j];
+        }
+    }
+    m_[3] = translation.getX();
+    m_[7] = translation.getY();
+    m_[11] = translation.getZ();
+    updateNormalMatrix();
+}
+
+void AffineTransform::updateNormalMatrix() {
+    // Обратно-транспонированная матрица равна матрице алгебраических
+    // дополнений, деленной на определитель
+    const double* a = m_;
+    double c00 = a[5] * a[10] - a[6] * a[9];
+    double c01 = a[6] * a[8] - a[4] * a[10];
+    double c02 = a[4] * a[9] - a[5] * a[8];
+    double c10 = a[2] * a[9] - a[1] * a[10];
+    double c11 = a[0] * a[10] - a[2] * a[8];
+    double c12 = a[1] * a[8] - a[0] * a[9];
+    double c20 = a[1] * a[6] - a[2] * a[5];
+    double c21 = a[2] * a[4] - a[0] * a[6];
+    double c22 = a[0] * a[5] - a[1] * a[4];
+    double det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+
+    // Порог по абсолютной величине отверг бы малые масштабы (scaling(1e-5)
+    // имеет определитель 1e-15), поэтому отвергается только ноль и
+    // определитель, обратная величина которого не конечна
+    invertible_ = det != 0.0 && std::isfinite(det) && std::isfinite(1.0 / det);
+    double inv = invertible_ ? 1.0 / det : 0.0;
+    normal_[0] = c00 * inv; normal_[1] = c01 * inv; normal_[2] = c02 * inv;
+    normal_[3] = c10 * inv; normal_[4] = c11 * inv; normal_[5] = c12 * inv;
+    normal_[6] = c20 * inv; normal_[7] = c21 * inv; normal_[8] = c22 * inv;
+}
+
+// Методы доступа
+double AffineTransform::get(size_t row, size_t col) const {
+    if (row >= 4 || col >= 4) {
+        throw std::out_of_range("Индекс вне границ матрицы 4x4");
+    }
+    if (row == 3) {
+        return col == 3 ? 1.0 : 0.0;
+    }
+    return m_[4 * row + col];
+}
+
+Matrix AffineTransform::toMatrix() const {
+    Matrix result(4, 4);
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            result.set(i, j, get(i, j));
+        }
+    }
+    return result;
+}
+
+Vector3D AffineTransform::getTranslation() const {
+    return Vector3D(m_[3], m_[7], m_[11]);
+}
+
+bool AffineTransform::isInvertible() const {
+    return invertible_;
+}
+
+// Операции
+AffineTransform AffineTransform::operator*(const AffineTransform& other) const {
+    AffineTransform result;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            double sum = (j == 3) ? m_[4 * i + 3] : 0.0;
+            for (int k = 0; k < 3; ++k) {
+                sum += m_[4 * i + k] * other.m_[4 * k + j];
+            }
+            result.m_[4 * i + j] = sum;
+        }
+    }
+    result.updateNormalMatrix();
+    return result;
+}
+
+AffineTransform AffineTransform::inverse() const {
+    if (!invertible_) {
+        throw std::runtime_error("Преобразование необратимо");
+    }
+    // Обратная линейная часть - транспонированная матрица нормалей
+    double linear[9];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            linear[3 * i + j] = normal_[3 * j + i];
+        }
+    }
+    Vector3D t(-(linear[0] * m_[3] + linear[1] * m_[7] + linear[2] * m_[11]),
+               -(linear[3] * m_[3] + linear[4] * m_[7] + linear[5] * m_[11]),
+               -(linear[6] * m_[3] + linear[7] * m_[7] + linear[8] * m_[11]));
+    return AffineTransform(linear, t);
+}
+
+Vector3D AffineTransform::transformPoint(const Vector3D& point) const {
+    const double x = point.getX(), y = point.getY(), z = point.getZ();
+    return Vector3D(m_[0] * x + m_[1] * y + m_[2] * z + m_[3],
+                    m_[4] * x + m_[5] * y + m_[6] * z + m_[7],
+                    m_[8] * x + m_[9] * y + m_[10] * z + m_[11]);
+}
+
+Vector3D AffineTransform::transformDirection(const Vector3D& direction) const {
+    const double x = direction.getX(), y = direction.getY(), z = direction.getZ();
+    return Vector3D(m_[0] * x + m_[1] * y + m_[2] * z,
+                    m_[4] * x + m_[5] * y + m_[6] * z,
+                    m_[8] * x + m_[9] * y + m_[10] * z);
+}
+
+Vector3D AffineTransform::transformNormal(const Vector3D& normal) const {
+    if (!invertible_) {
+        throw std::runtime_error("Преобразование нормалей требует обратимой матрицы");
+    }
+    const double x = normal.getX(), y = normal.getY(), z = normal.getZ();
+    return Vector3D(normal_[0] * x + normal_[1] * y + normal_[2] * z,
+                    normal_[3] * x + normal_[4] * y + normal_[5] * z,
+                    normal_[6] * x + normal_[7] * y + normal_[8] * z);
+}
+
+// Пакетные операции
+void AffineTransform::transformPoints(const std::vector<Vector3D>& points, std::vector<Vector3D>& result,
+                                      bool parallel) const {
+    result.resize(points.size());
+    runBlocks(points.size(), parallel, [&](size_t, size_t begin, size_t end) {
+        transformBlock(m_, 4, true, points, result, begin, end);
+    });
+}
+
+void AffineTransform::transformDirections(const std::vector<Vector3D>& directions,
+                                          std::vector<Vector3D>& result, bool parallel) const {
+    result.resize(directions.size());
+    runBlocks(directions.size(), parallel, [&](size_t, size_t begin, size_t end) {
+        transformBlock(m_, 4, false, directions, result, begin, end);
+    });
+}
+
+void AffineTransform::transformNormals(const std::vector<Vector3D>& normals, std::vector<Vector3D>& result,
+                                       bool renormalize, bool parallel) const {
+    if (!invertible_) {
+        throw std::runtime_error("Преобразование нормалей требует обратимой матрицы");
+    }
+    result.resize(normals.size());
+    runBlocks(normals.size(), parallel, [&](size_t, size_t begin, size_t end) {
+        transformBlock(normal_, 3, false, normals, result, begin, end);
+        if (!renormalize) return;
+        for (size_t i = begin; i < end; ++i) {
+            double length = result[i].magnitude();
+            if (length > 0.0) {
+                result[i] *= 1.0 / length;
+            }
+        }
+    });
+}
+
+void AffineTransform::transformPoints(double* x, double* y, double* z, size_t count,
+                                      bool parallel) const {
+    const double a00 = m_[0], a01 = m_[1], a02 = m_[2], t0 = m_[3];
+    const double a10 = m_[4], a11 = m_[5], a12 = m_[6], t1 = m_[7];
+    const double a20 = m_[8], a21 = m_[9], a22 = m_[10], t2 = m_[11];
+    runBlocks(count, parallel, [=](size_t, size_t begin, size_t end) {
+        // Массивы не пересекаются (см. объявление)
+        double* MATH_RESTRICT xs = x;
+        double* MATH_RESTRICT ys = y;
+        double* MATH_RESTRICT zs = z;
+        size_t i = begin;
+#if MATH_SIMD
+        const Simd::Doubles b00 = Simd::broadcast(a00), b01 = Simd::broadcast(a01), b02 = Simd::broadcast(a02);
+        const Simd::Doubles b10 = Simd::broadcast(a10), b11 = Simd::broadcast(a11), b12 = Simd::broadcast(a12);
+        const Simd::Doubles b20 = Simd::broadcast(a20), b21 = Simd::broadcast(a21), b22 = Simd::broadcast(a22);
+        const Simd::Doubles s0 = Simd::broadcast(t0), s1 = Simd::broadcast(t1), s2 = Simd::broadcast(t2);
+        for (const size_t last = begin + Simd::vectorEnd(end - begin); i < last; i += Simd::WIDTH) {
+            const Simd::Doubles px = Simd::load(xs + i), py = Simd::load(ys + i), pz = Simd::load(zs + i);
+            Simd::store(xs + i, Simd::add(Simd::add(Simd::add(Simd::mul(b00, px), Simd::mul(b01, py)),
+                                                    Simd::mul(b02, pz)), s0));
+            Simd::store(ys + i, Simd::add(Simd::add(Simd::add(Simd::mul(b10, px), Simd::mul(b11, py)),
+                                                    Simd::mul(b12, pz)), s1));
+            Simd::store(zs + i, Simd::add(Simd::add(Simd::add(Simd::mul(b20, px), Simd::mul(b21, py)),
+                                                    Simd::mul(b22, pz)), s2));
+        }
+#endif
+        for (; i < end; ++i) {
+            const double px = xs[i], py = ys[i], pz = zs[i];
+            xs[i] = a00 * px + a01 * py + a02 * pz + t0;
+            ys[i] = a10 * px + a11 * py + a12 * pz + t1;
+            zs[i] = a20 * px + a21 * py + a22 * pz + t2;
+        }
+    });
+}
+
+// Статические методы
+AffineTransform AffineTransform::identity() {
+    return AffineTransform();
+}
+
+AffineTransform AffineTransform::translation(const Vector3D& offset) {
+    const double linear[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+    return AffineTransform(linear, offset);
+}
+
+AffineTransform AffineTransform::scaling(const Vector3D& factors) {
+    const double linear[9] = { factors.getX(), 0, 0, 0, factors.getY(), 0, 0, 0, factors.getZ() };
+    return AffineTransform(linear, Vector3D());
+}
+
+AffineTransform AffineTransform::rotation(const Vector3D& axis, double angle) {
+    // Формула Родрига
+    Vector3D u = axis.normalize();
+    const double x = u.getX(), y = u.getY(), z = u.getZ();
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    const double k = 1.0 - c;
+    const double linear[9] = {
+        c + x * x * k,     x * y * k - z * s, x * z * k + y * s,
+        y * x * k + z * s, c + y * y * k,     y * z * k - x * s,
+        z * x * k - y * s, z * y * k + x * s, c + z * z * k
+    };
+    return AffineTransform(linear, Vector3D());
+}
+
+// Дружественные функции
+std::ostream& operator<<(std::ostream& os, const AffineTransform& transform) {
+    os << transform.toMatrix();
+    return os;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file AffineTransform.h
+ * @brief Аффинные преобразования трехмерного пространства
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef AFFINETRANSFORM_H
+#define AFFINETRANSFORM_H
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include "Vector3D.h"
+#include "Matrix.h"
+
+/**
+ * @class AffineTransform
+ * @brief Аффинное преобразование, заданное матрицей 4x4 с последней строкой (0, 0, 0, 1)
+ *
+ * Хранит верхние три строки матрицы в плоском массиве, а также заранее
+ * вычисленную обратно-транспонированную матрицу 3x3 для преобразования
+ * нормалей. Пакетные методы обрабатывают массивы точек блоками
+ * в нескольких потоках; внутренние циклы не содержат ветвлений и проверок
+ * границ и векторизуются компилятором.
+ */
+class AffineTransform {
+private:
+    double m_[12];       ///< Строки 0-2 матрицы 4x4 (построчно)
+    double normal_[9];   ///< Обратно-транспонированная матрица 3x3
+    bool invertible_;    ///< Обратима ли линейная часть
+
+    void updateNormalMatrix();
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает тождественное преобразование
+     */
+    AffineTransform();
+
+    /**
+     * @brief Конструктор из матрицы 4x4
+     * @param matrix Матрица 4x4 с последней строкой (0, 0, 0, 1)
+     * @throw std::invalid_argument если матрица не 4x4 или не аффинная
+     */
+    explicit AffineTransform(const Matrix& matrix);
+
+    /**
+     * @brief Конструктор из линейной части и сдвига
+     * @param linear Массив 3x3 (построчно)
+     * @param translation Вектор сдвига
+     */
+    AffineTransform(const double linear[9], const Vector3D& translation);
+
+    // Методы доступа
+    /**
+     * @brief Получить элемент матрицы 4x4
+     * @param row Номер строки (0-3)
+     * @param col Номер столбца (0-3)
+     * @return Значение элемента
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t row, size_t col) const;
+
+    /**
+     * @brief Получить матрицу 4x4
+     * @return Матрица преобразования
+     */
+    Matrix toMatrix() const;
+
+    /**
+     * @brief Получить сдвиг
+     * @return Вектор сдвига
+     */
+    Vector3D getTranslation() const;
+
+    /**
+     * @brief Проверить обратимость линейной части
+     * @return true если определитель линейной части не равен нулю
+     */
+    bool isInvertible() const;
+
+    // Операции
+    /**
+     * @brief Композиция преобразований (сначала other, затем this)
+     * @param other Второе преобразование
+     * @return Композиция
+     */
+    AffineTransform operator*(const AffineTransform& other) const;
+
+    /**
+     * @brief Обратное преобразование
+     * @return Обратное преобразование
+     * @throw std::runtime_error если преобразование необратимо
+     */
+    AffineTransform inverse() const;
+
+    /**
+     * @brief Преобразовать точку (с учетом сдвига)
+     * @param point Точка
+     * @return Преобразованная точка
+     */
+    Vector3D transformPoint(const Vector3D& point) const;
+
+    /**
+     * @brief Преобразовать направление (без сдвига)
+     * @param direction Направление
+     * @return Преобразованное направление
+     */
+    Vector3D transformDirection(const Vector3D& direction) const;
+
+    /**
+     * @brief Преобразовать нормаль обратно-транспонированной матрицей
+     * @param normal Нормаль
+     * @return Преобразованная нормаль (не нормализуется)
+     * @throw std::runtime_error если преобразование необратимо
+     */
+    Vector3D transformNormal(const Vector3D& normal) const;
+
+    // Пакетные операции
+    /**
+     * @brief Преобразовать массив точек
+     * @param points Исходные точки
+     * @param result Выходной массив (размер устанавливается по входному)
+     * @param parallel Использовать несколько потоков
+     */
+    void transformPoints(const std::vector<Vector3D>& points, std::vector<Vector3D>& result,
+                         bool parallel = true) const;
+
+    /**
+     * @brief Преобразовать массив направлений
+     * @param directions Исходные направления
+     * @param result Выходной массив (размер устанавливается по входному)
+     * @param parallel Использовать несколько потоков
+     */
+    void transformDirections(const std::vector<Vector3D>& directions, std::vector<Vector3D>& result,
+                             bool parallel = true) const;
+
+    /**
+     * @brief Преобразовать массив нормалей
+     * @param normals Исходные нормали
+     * @param result Выходной массив (размер устанавливается по входному)
+     * @param renormalize Привести результат к единичной длине
+     * @param parallel Использовать несколько потоков
+     * @throw std::runtime_error если преобразование необратимо
+     */
+    void transformNormals(const std::vector<Vector3D>& normals, std::vector<Vector3D>& result,
+                          bool renormalize = true, bool parallel = true) const;
+
+    /**
+     * @brief Преобразовать точки, хранящиеся раздельными массивами координат
+     * @param x Координаты X (на месте)
+     * @param y Координаты Y (на месте)
+     * @param z Координаты Z (на месте)
+     * @param count Количество точек
+     * @param parallel Использовать несколько потоков
+     *
+     * Самый быстрый вариант: раскладка SoA позволяет обрабатывать
+     * Simd::WIDTH точек одной векторной инструкцией (см. Simd.h).
+     * Массивы x, y и z не должны пересекаться.
+     */
+    void transformPoints(double* x, double* y, double* z, size_t count, bool parallel = true) const;
+
+    // Статические методы
+    /**
+     * @brief Тождественное преобразование
+     * @return Тождественное преобразование
+     */
+    static AffineTransform identity();
+
+    /**
+     * @brief Сдвиг
+     * @param offset Вектор сдвига
+     * @return Преобразование сдвига
+     */
+    static AffineTransform translation(const Vector3D& offset);
+
+    /**
+     * @brief Масштабирование по осям
+     * @param factors Коэффициенты по осям X, Y, Z
+     * @return Преобразование масштабирования
+     */
+    static AffineTransform scaling(const Vector3D& factors);
+
+    /**
+     * @brief Поворот вокруг оси
+     * @param axis Ось поворота
+     * @param angle Угол в радианах
+     * @return Преобразование поворота
+     * @throw std::runtime_error если ось нулевая
+     */
+    static AffineTransform rotation(const Vector3D& axis, double angle);
+
+    // Дружественные функции
+    /**
+     * @brief Оператор вывода в поток
+     * @param os Выходной поток
+     * @param transform Преобразование
+     * @return Ссылка на поток
+     */
+    friend std::ostream& operator<<(std::ostream& os, const AffineTransform& transform);
+};
+
+#endif // AFFINETRANSFORM_H
@@ -0,0 +1,774 @@
+/**
+ * @file BVH.cpp
+ * @brief Реализация иерархии ограничивающих объемов
+ */
+
+#include "BVH.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace {
+
+const size_t PACKET_SIZE = 8;        ///< Количество запросов в пакете
+const size_t MAX_BINS = 64;          ///< Максимальное количество корзин SAH
+const size_t MAX_SAH_DEPTH = 64;     ///< Глубина, после которой делим пополам
+const size_t STACK_SIZE = 128;       ///< Размер стека обхода
+const size_t BATCH_BLOCK = 256;      ///< Количество запросов на одну задачу
+
+inline double boxDistance2(const double* bmin, const double* bmax,
+                           double x, double y, double z) {
+    double dx = x < bmin[0] ? bmin[0] - x : (x > bmax[0] ? x - bmax[0] : 0.0);
+    double dy = y < bmin[1] ? bmin[1] - y : (y > bmax[1] ? y - bmax[1] : 0.0);
+    double dz = z < bmin[2] ? bmin[2] - z : (z > bmax[2] ? z - bmax[2] : 0.0);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+inline bool rayBox(const double* bmin, const double* bmax, const double* origin,
+                   const double* invDir, double tMax, double& tEntry) {
+    double t0 = 0.0;
+    double t1 = tMax;
+    for (int a = 0; a < 3; ++a) {
+        double tNear = (bmin[a] - origin[a]) * invDir[a];
+        double tFar = (bmax[a] - origin[a]) * invDir[a];
+        if (tNear > tFar) std::swap(tNear, tFar);
+        if (tNear > t0) t0 = tNear;
+        if (tFar < t1) t1 = tFar;
+    }
+    tEntry = t0;
+    return t0 <= t1;
+}
+
+/**
+ * @brief Пересечение луча с треугольником (алгоритм Моллера-Трумбора)
+ * @param tri Вершина v0 и ребра e1, e2 (9 чисел)
+ * @return true если найдено пересечение ближе tBest
+ */
+inline bool rayTriangle(const double* tri, const double* o, const double* d,
+                        double tBest, double& t, double& u, double& v) {
+    const double* v0 = tri;
+    const double* e1 = tri + 3;
+    const double* e2 = tri + 6;
+
+    double px = d[1] * e2[2] - d[2] * e2[1];
+    double py = d[2] * e2[0] - d[0] * e2[2];
+    double pz = d[0] * e2[1] - d[1] * e2[0];
+    double det = e1[0] * px + e1[1] * py + e1[2] * pz;
+    if (std::abs(det) < 1e-300) return false;
+    double invDet = 1.0 / det;
+
+    double sx = o[0] - v0[0];
+    double sy = o[1] - v0[1];
+    double sz = o[2] - v0[2];
+    double uu = (sx * px + sy * py + sz * pz) * invDet;
+    if (uu < 0.0 || uu > 1.0) return false;
+
+    double qx = sy * e1[2] - sz * e1[1];
+    double qy = sz * e1[0] - sx * e1[2];
+    double qz = sx * e1[1] - sy * e1[0];
+    double vv = (d[0] * qx + d[1] * qy + d[2] * qz) * invDet;
+    if (vv < 0.0 || uu + vv > 1.0) return false;
+
+    double tt = (e2[0] * qx + e2[1] * qy + e2[2] * qz) * invDet;
+    if (tt < 0.0 || tt >= tBest) return false;
+
+    t = tt;
+    u = uu;
+    v = vv;
+    return true;
+}
+
+struct Bin {
+    BoundingBox box;
+    size_t count;
+    Bin() : count(0) {}
+};
+
+} // namespace
+
+// Параметры и результаты
+BVHBuildOptions::BVHBuildOptions()
+    : maxLeafSize(4), binCount(16), traversalCost(1.0), intersectionCost(1.0),
+      parallel(false), parallelThreshold(4096) {}
+
+BVHRayHit::BVHRayHit() : hit(false), triangle(0), t(0.0), u(0.0), v(0.0) {}
+
+// Конструкторы
+BVH::BVH() : type_(POINTS) {}
+
+BVH::BVH(const std::vector<Vector3D>& points, const BVHBuildOptions& options)
+    : type_(POINTS), options_(options) {
+    const size_t n = points.size();
+    std::vector<BoundingBox> bounds(n);
+    std::vector<double> centroids(3 * n);
+    std::vector<double> raw(3 * n);
+    for (size_t i = 0; i < n; ++i) {
+        double x = points[i].getX();
+        double y = points[i].getY();
+        double z = points[i].getZ();
+        bounds[i].expand(x, y, z);
+        centroids[3 * i] = raw[3 * i] = x;
+        centroids[3 * i + 1] = raw[3 * i + 1] = y;
+        centroids[3 * i + 2] = raw[3 * i + 2] = z;
+    }
+
+    build(bounds, centroids);
+
+    data_.resize(3 * n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t src = primitiveIndex_[i];
+        data_[3 * i] = raw[3 * src];
+        data_[3 * i + 1] = raw[3 * src + 1];
+        data_[3 * i + 2] = raw[3 * src + 2];
+    }
+}
+
+BVH::BVH(const std::vector<Vector3D>& vertices, const std::vector<size_t>& indices,
+         const BVHBuildOptions& options)
+    : type_(TRIANGLES), options_(options) {
+    if (indices.size() % 3 != 0) {
+        throw std::invalid_argument("Количество индексов должно быть кратно трем");
+    }
+
+    const size_t n = indices.size() / 3;
+    std::vector<BoundingBox> bounds(n);
+    std::vector<double> centroids(3 * n);
+    std::vector<double> raw(9 * n);
+    for (size_t i = 0; i < n; ++i) {
+        const Vector3D* v[3];
+        for (int k = 0; k < 3; ++k) {
+            size_t index = indices[3 * i + k];
+            if (index >= vertices.size()) {
+                throw std::invalid_argument("Индекс вершины вне границ массива");
+            }
+            v[k] = &vertices[index];
+            bounds[i].expand(*v[k]);
+        }
+        Vector3D e1 = *v[1] - *v[0];
+        Vector3D e2 = *v[2] - *v[0];
+        Vector3D c = (*v[0] + *v[1] + *v[2]) * (1.0 / 3.0);
+        double* tri = &raw[9 * i];
+        tri[0] = v[0]->getX(); tri[1] = v[0]->getY(); tri[2] = v[0]->getZ();
+        tri[3] = e1.getX();    tri[4] = e1.getY();    tri[5] = e1.getZ();
+        tri[6] = e2.getX();    tri[7] = e2.getY();    tri[8] = e2.getZ();
+        centroids[3 * i] = c.getX();
+        centroids[3 * i + 1] = c.getY();
+        centroids[3 * i + 2] = c.getZ();
+    }
+
+    build(bounds, centroids);
+
+    data_.resize(9 * n);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(raw.begin() + 9 * primitiveIndex_[i],
+                  raw.begin() + 9 * primitiveIndex_[i] + 9,
+                  data_.begin() + 9 * i);
+    }
+}
+
+// Построение
+void BVH::build(const std::vector<BoundingBox>& bounds, const std::vector<double>& centroids) {
+    const size_t n = bounds.size();
+    if (n >= std::numeric_limits<uint32_t>::max() / 2) {
+        throw std::invalid_argument("Слишком много примитивов для BVH");
+    }
+    if (options_.maxLeafSize == 0) options_.maxLeafSize = 1;
+    if (options_.binCount < 2) options_.binCount = 2;
+    if (options_.binCount > MAX_BINS) options_.binCount = MAX_BINS;
+
+    nodes_.clear();
+    primitiveIndex_.clear();
+    if (n == 0) {
+        return;
+    }
+
+    std::vector<uint32_t> order(n);
+    for (size_t i = 0; i < n; ++i) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+
+    nodes_.reserve(2 * n / options_.maxLeafSize + 1);
+    buildRange(order, 0, n, 0, bounds, centroids, nodes_);
+
+    primitiveIndex_.assign(order.begin(), order.end());
+}
+
+void BVH::buildRange(std::vector<uint32_t>& order, size_t begin, size_t end, size_t depth,
+                     const std::vector<BoundingBox>& bounds,
+                     const std::vector<double>& centroids,
+                     std::vector<Node>& out) const {
+    const size_t count = end - begin;
+
+    BoundingBox box;
+    BoundingBox centroidBox;
+    for (size_t i = begin; i < end; ++i) {
+        const double* c = &centroids[3 * order[i]];
+        box.expand(bounds[order[i]]);
+        centroidBox.expand(c[0], c[1], c[2]);
+    }
+
+    const size_t nodeIndex = out.size();
+    Node node;
+    for (int a = 0; a < 3; ++a) {
+        node.bmin[a] = box.minAt(a);
+        node.bmax[a] = box.maxAt(a);
+    }
+    node.offset = static_cast<uint32_t>(begin);
+    node.count = static_cast<uint32_t>(count);
+    node.axis = 0;
+    node.padding = 0;
+    out.push_back(node);
+
+    if (count <= options_.maxLeafSize) {
+        return;
+    }
+
+    // Поиск лучшего разбиения по SAH
+    const size_t bins = options_.binCount;
+    int bestAxis = -1;
+    size_t bestSplit = 0;
+    double bestCost = std::numeric_limits<double>::infinity();
+    const double parentArea = box.surfaceArea();
+
+    if (depth < MAX_SAH_DEPTH && parentArea > 0.0) {
+        for (int axis = 0; axis < 3; ++axis) {
+            double lo = centroidBox.minAt(axis);
+            double hi = centroidBox.maxAt(axis);
+            if (!(hi > lo)) continue;
+
+            double scale = bins / (hi - lo);
+            Bin binData[MAX_BINS];
+            for (size_t i = begin; i < end; ++i) {
+                size_t b = static_cast<size_t>((centroids[3 * order[i] + axis] - lo) * scale);
+                if (b >= bins) b = bins - 1;
+                binData[b].count++;
+                binData[b].box.expand(bounds[order[i]]);
+            }
+
+            double rightArea[MAX_BINS];
+            size_t rightCount[MAX_BINS];
+            BoundingBox accumulated;
+            size_t accumulatedCount = 0;
+            for (size_t j = bins - 1; j > 0; --j) {
+                accumulated.expand(binData[j].box);
+                accumulatedCount += binData[j].count;
+                rightArea[j - 1] = accumulated.surfaceArea();
+                rightCount[j - 1] = accumulatedCount;
+            }
+
+            accumulated = BoundingBox();
+            accumulatedCount = 0;
+            for (size_t j = 0; j + 1 < bins; ++j) {
+                accumulated.expand(binData[j].box);
+                accumulatedCount += binData[j].count;
+                if (accumulatedCount == 0 || rightCount[j] == 0) continue;
+                double cost = accumulated.surfaceArea() * accumulatedCount +
+                              rightArea[j] * rightCount[j];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = j;
+                }
+            }
+        }
+    }
+
+    size_t mid = begin;
+    if (bestAxis >= 0) {
+        double splitCost = options_.traversalCost +
+                           options_.intersectionCost * bestCost / parentArea;
+        double leafCost = options_.intersectionCost * count;
+        if (splitCost >= leafCost && count <= 4 * options_.maxLeafSize) {
+            return;
+        }
+
+        double lo = centroidBox.minAt(bestAxis);
+        double scale = bins / (centroidBox.maxAt(bestAxis) - lo);
+        mid = std::partition(order.begin() + begin, order.begin() + end,
+            [&](uint32_t p) {
+                size_t b = static_cast<size_t>((centroids[3 * p + bestAxis] - lo) * scale);
+                if (b >= bins) b = bins - 1;
+                return b <= bestSplit;
+            }) - order.begin();
+    }
+
+    int axis = bestAxis;
+    if (mid == begin || mid == end) {
+        // SAH не дал разбиения - делим пополам по самой длинной оси
+        axis = centroidBox.longestAxis();
+        mid = begin + count / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+            [&](uint32_t a, uint32_t b) {
+                return centroids[3 * a + axis] < centroids[3 * b + axis];
+            });
+    }
+
+    out[nodeIndex].count = 0;
+    out[nodeIndex].axis = static_cast<uint32_t>(axis);
+
+    bool parallel = options_.parallel && count >= options_.parallelThreshold &&
+                    (size_t(1) << (depth < 16 ? depth : 16)) < 2 * Parallel::getThreadCount();
+    if (parallel) {
+        std::vector<Node> right;
+        Parallel::invoke(
+            [&]() { buildRange(order, begin, mid, depth + 1, bounds, centroids, out); },
+            [&]() { buildRange(order, mid, end, depth + 1, bounds, centroids, right); });
+        const uint32_t base = static_cast<uint32_t>(out.size());
+        for (auto& child : right) {
+            if (child.count == 0) child.offset += base;
+        }
+        out[nodeIndex].offset = base;
+        out.insert(out.end(), right.begin(), right.end());
+    } else {
+        buildRange(order, begin, mid, depth + 1, bounds, centroids, out);
+        out[nodeIndex].offset = static_cast<uint32_t>(out.size());
+        buildRange(order, mid, end, depth + 1, bounds, centroids, out);
+    }
+}
+
+void BVH::requireType(PrimitiveType type) const {
+    if (type_ != type) {
+        throw std::logic_error(type == POINTS
+            ? "Запрос доступен только для BVH над точками"
+            : "Запрос доступен только для BVH над треугольниками");
+    }
+}
+
+// Методы доступа
+BVH::PrimitiveType BVH::getType() const {
+    return type_;
+}
+
+size_t BVH::size() const {
+    return primitiveIndex_.size();
+}
+
+size_t BVH::nodeCount() const {
+    return nodes_.size();
+}
+
+bool BVH::empty() const {
+    return nodes_.empty();
+}
+
+BoundingBox BVH::bounds() const {
+    if (nodes_.empty()) {
+        return BoundingBox();
+    }
+    const Node& root = nodes_[0];
+    return BoundingBox(Vector3D(root.bmin[0], root.bmin[1], root.bmin[2]),
+                       Vector3D(root.bmax[0], root.bmax[1], root.bmax[2]));
+}
+
+// Запросы к точкам
+BVHNeighbor BVH::nearest(const Vector3D& query) const {
+    requireType(POINTS);
+    if (nodes_.empty()) {
+        throw std::runtime_error("Поиск в пустом BVH");
+    }
+
+    const double qx = query.getX();
+    const double qy = query.getY();
+    const double qz = query.getZ();
+
+    struct Entry { uint32_t node; double dist2; };
+    Entry stack[STACK_SIZE];
+    size_t sp = 0;
+
+    double best = std::numeric_limits<double>::infinity();
+    size_t bestPrim = 0;
+    uint32_t index = 0;
+
+    for (;;) {
+        const Node& node = nodes_[index];
+        if (node.count > 0) {
+            const size_t last = node.offset + node.count;
+            for (size_t p = node.offset; p < last; ++p) {
+                double dx = data_[3 * p] - qx;
+                double dy = data_[3 * p + 1] - qy;
+                double dz = data_[3 * p + 2] - qz;
+                double d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 < best || (d2 == best && primitiveIndex_[p] < primitiveIndex_[bestPrim])) {
+                    best = d2;
+                    bestPrim = p;
+                }
+            }
+        } else {
+            uint32_t nearChild = index + 1;
+            uint32_t farChild = node.offset;
+            double dNear = boxDistance2(nodes_[nearChild].bmin, nodes_[nearChild].bmax, qx, qy, qz);
+            double dFar = boxDistance2(nodes_[farChild].bmin, nodes_[farChild].bmax, qx, qy, qz);
+            if (dFar < dNear) {
+                std::swap(nearChild, farChild);
+                std::swap(dNear, dFar);
+            }
+            if (dNear <= best) {
+                if (dFar <= best) {
+                    stack[sp].node = farChild;
+                    stack[sp].dist2 = dFar;
+                    ++sp;
+                }
+                index = nearChild;
+                continue;
+            }
+        }
+
+        bool found = false;
+        while (sp > 0) {
+            const Entry& entry = stack[--sp];
+            if (entry.dist2 <= best) {
+                index = entry.node;
+                found = true;
+                break;
+            }
+        }
+        if (!found) break;
+    }
+
+    BVHNeighbor result;
+    result.index = primitiveIndex_[bestPrim];
+    result.distance = std::sqrt(best);
+    return result;
+}
+
+std::vector<BVHNeighbor> BVH::kNearest(const Vector3D& query, size_t k) const {
+    requireType(POINTS);
+    std::vector<BVHNeighbor> result;
+    if (nodes_.empty() || k == 0) {
+        return result;
+    }
+
+    const double qx = query.getX();
+    const double qy = query.getY();
+    const double qz = query.getZ();
+
+    // Максимальная куча кандидатов: на вершине самый дальний
+    std::vector<std::pair<double, size_t> > heap;
+    heap.reserve(k + 1);
+    auto bound = [&]() {
+        return heap.size() < k ? std::numeric_limits<double>::infinity() : heap.front().first;
+    };
+
+    uint32_t stack[STACK_SIZE];
+    size_t sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0) {
+        const uint32_t index = stack[--sp];
+        const Node& node = nodes_[index];
+        if (boxDistance2(node.bmin, node.bmax, qx, qy, qz) > bound()) continue;
+
+        if (node.count > 0) {
+            const size_t last = node.offset + node.count;
+            for (size_t p = node.offset; p < last; ++p) {
+                double dx = data_[3 * p] - qx;
+                double dy = data_[3 * p + 1] - qy;
+                double dz = data_[3 * p + 2] - qz;
+                std::pair<double, size_t> candidate(dx * dx + dy * dy + dz * dz, primitiveIndex_[p]);
+                if (heap.size() < k) {
+                    heap.push_back(candidate);
+                    std::push_heap(heap.begin(), heap.end());
+                } else if (candidate < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = candidate;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        } else {
+            uint32_t nearChild = index + 1;
+            uint32_t farChild = node.offset;
+            double dNear = boxDistance2(nodes_[nearChild].bmin, nodes_[nearChild].bmax, qx, qy, qz);
+            double dFar = boxDistance2(nodes_[farChild].bmin, nodes_[farChild].bmax, qx, qy, qz);
+            if (dFar < dNear) {
+                std::swap(nearChild, farChild);
+            }
+            stack[sp++] = farChild;
+            stack[sp++] = nearChild;
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    result.resize(heap.size());
+    for (size_t i = 0; i < heap.size(); ++i) {
+        result[i].index = heap[i].second;
+        result[i].distance = std::sqrt(heap[i].first);
+    }
+    return result;
+}
+
+std::vector<BVHNeighbor> BVH::radiusSearch(const Vector3D& query, double radius) const {
+    requireType(POINTS);
+    std::vector<BVHNeighbor> result;
+    if (nodes_.empty() || radius < 0.0) {
+        return result;
+    }
+
+    const double qx = query.getX();
+    const double qy = query.getY();
+    const double qz = query.getZ();
+    const double r2 = radius * radius;
+
+    uint32_t stack[STACK_SIZE];
+    size_t sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0) {
+        const uint32_t index = stack[--sp];
+        const Node& node = nodes_[index];
+        if (boxDistance2(node.bmin, node.bmax, qx, qy, qz) > r2) continue;
+
+        if (node.count > 0) {
+            const size_t last = node.offset + node.count;
+            for (size_t p = node.offset; p < last; ++p) {
+                double dx = data_[3 * p] - qx;
+                double dy = data_[3 * p + 1] - qy;
+                double dz = data_[3 * p + 2] - qz;
+                double d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 <= r2) {
+                    BVHNeighbor neighbor;
+                    neighbor.index = primitiveIndex_[p];
+                    neighbor.distance = std::sqrt(d2);
+                    result.push_back(neighbor);
+                }
+            }
+        } else {
+            stack[sp++] = node.offset;
+            stack[sp++] = index + 1;
+        }
+    }
+    return result;
+}
+
+std::vector<BVHNeighbor> BVH::nearestBatch(const std::vector<Vector3D>& queries) const {
+    requireType(POINTS);
+    if (nodes_.empty() && !queries.empty()) {
+        throw std::runtime_error("Поиск в пустом BVH");
+    }
+
+    std::vector<BVHNeighbor> result(queries.size());
+    Parallel::forEachBlock(queries.size(), BATCH_BLOCK,
+        [&](size_t, size_t blockBegin, size_t blockEnd) {
+        for (size_t first = blockBegin; first < blockEnd; first += PACKET_SIZE) {
+            const size_t lanes = std::min(PACKET_SIZE, blockEnd - first);
+            double qx[PACKET_SIZE], qy[PACKET_SIZE], qz[PACKET_SIZE];
+            double best[PACKET_SIZE];
+            size_t bestPrim[PACKET_SIZE];
+            for (size_t l = 0; l < lanes; ++l) {
+                qx[l] = queries[first + l].getX();
+                qy[l] = queries[first + l].getY();
+                qz[l] = queries[first + l].getZ();
+                best[l] = std::numeric_limits<double>::infinity();
+                bestPrim[l] = 0;
+            }
+
+            uint32_t stack[STACK_SIZE];
+            size_t sp = 0;
+            stack[sp++] = 0;
+
+            while (sp > 0) {
+                const uint32_t index = stack[--sp];
+                const Node& node = nodes_[index];
+
+                bool active = false;
+                for (size_t l = 0; l < lanes && !active; ++l) {
+                    active = boxDistance2(node.bmin, node.bmax, qx[l], qy[l], qz[l]) <= best[l];
+                }
+                if (!active) continue;
+
+                if (node.count > 0) {
+                    const size_t last = node.offset + node.count;
+                    for (size_t p = node.offset; p < last; ++p) {
+                        const double px = data_[3 * p];
+                        const double py = data_[3 * p + 1];
+                        const double pz = data_[3 * p + 2];
+                        for (size_t l = 0; l < lanes; ++l) {
+                            double dx = px - qx[l];
+                            double dy = py - qy[l];
+                            double dz = pz - qz[l];
+                            double d2 = dx * dx + dy * dy + dz * dz;
+                            if (d2 < best[l] ||
+                                (d2 == best[l] && primitiveIndex_[p] < primitiveIndex_[bestPrim[l]])) {
+                                best[l] = d2;
+                                bestPrim[l] = p;
+                            }
+                        }
+                    }
+                } else {
+                    const Node& left = nodes_[index + 1];
+                    const Node& right = nodes_[node.offset];
+                    double dLeft = 0.0;
+                    double dRight = 0.0;
+                    for (size_t l = 0; l < lanes; ++l) {
+                        dLeft += boxDistance2(left.bmin, left.bmax, qx[l], qy[l], qz[l]);
+                        dRight += boxDistance2(right.bmin, right.bmax, qx[l], qy[l], qz[l]);
+                    }
+                    if (dLeft <= dRight) {
+                        stack[sp++] = node.offset;
+                        stack[sp++] = index + 1;
+                    } else {
+                        stack[sp++] = index + 1;
+                        stack[sp++] = node.offset;
+                    }
+                }
+            }
+
+            for (size_t l = 0; l < lanes; ++l) {
+                result[first + l].index = primitiveIndex_[bestPrim[l]];
+                result[first + l].distance = std::sqrt(best[l]);
+            }
+        }
+    });
+    return result;
+}
+
+// Запросы к треугольникам
+BVHRayHit BVH::intersectRay(const Vector3D& origin, const Vector3D& direction, double tMax) const {
+    requireType(TRIANGLES);
+    BVHRayHit hit;
+    if (nodes_.empty()) {
+        return hit;
+    }
+
+    const double o[3] = { origin.getX(), origin.getY(), origin.getZ() };
+    const double d[3] = { direction.getX(), direction.getY(), direction.getZ() };
+    const double inv[3] = { 1.0 / d[0], 1.0 / d[1], 1.0 / d[2] };
+
+    struct Entry { uint32_t node; double tEntry; };
+    Entry stack[STACK_SIZE];
+    size_t sp = 0;
+
+    double best = tMax;
+    double tRoot;
+    if (!rayBox(nodes_[0].bmin, nodes_[0].bmax, o, inv, best, tRoot)) {
+        return hit;
+    }
+    stack[sp].node = 0;
+    stack[sp].tEntry = tRoot;
+    ++sp;
+
+    while (sp > 0) {
+        const Entry entry = stack[--sp];
+        if (entry.tEntry > best) continue;
+        const Node& node = nodes_[entry.node];
+
+        if (node.count > 0) {
+            const size_t last = node.offset + node.count;
+            for (size_t p = node.offset; p < last; ++p) {
+                double t, u, v;
+                if (rayTriangle(&data_[9 * p], o, d, best, t, u, v)) {
+                    best = t;
+                    hit.hit = true;
+                    hit.triangle = primitiveIndex_[p];
+                    hit.t = t;
+                    hit.u = u;
+                    hit.v = v;
+                }
+            }
+        } else {
+            const uint32_t left = entry.node + 1;
+            const uint32_t right = node.offset;
+            double tLeft, tRight;
+            bool hitLeft = rayBox(nodes_[left].bmin, nodes_[left].bmax, o, inv, best, tLeft);
+            bool hitRight = rayBox(nodes_[right].bmin, nodes_[right].bmax, o, inv, best, tRight);
+            if (hitLeft && hitRight) {
+                // Ближний потомок кладется последним, чтобы обойти его первым
+                bool leftFirst = tLeft <= tRight;
+                stack[sp].node = leftFirst ? right : left;
+                stack[sp].tEntry = leftFirst ? tRight : tLeft;
+                ++sp;
+                stack[sp].node = leftFirst ? left : right;
+                stack[sp].tEntry = leftFirst ? tLeft : tRight;
+                ++sp;
+            } else if (hitLeft) {
+                stack[sp].node = left;
+                stack[sp].tEntry = tLeft;
+                ++sp;
+            } else if (hitRight) {
+                stack[sp].node = right;
+                stack[sp].tEntry = tRight;
+                ++sp;
+            }
+        }
+    }
+    return hit;
+}
+
+std::vector<BVHRayHit> BVH::intersectRays(const std::vector<Vector3D>& origins,
+                                          const std::vector<Vector3D>& directions,
+                                          double tMax) const {
+    requireType(TRIANGLES);
+    if (origins.size() != directions.size()) {
+        throw std::invalid_argument("Количество начал и направлений лучей не совпадает");
+    }
+
+    std::vector<BVHRayHit> result(origins.size());
+    if (nodes_.empty()) {
+        return result;
+    }
+
+    Parallel::forEachBlock(origins.size(), BATCH_BLOCK,
+        [&](size_t, size_t blockBegin, size_t blockEnd) {
+        for (size_t first = blockBegin; first < blockEnd; first += PACKET_SIZE) {
+            const size_t lanes = std::min(PACKET_SIZE, blockEnd - first);
+            double o[PACKET_SIZE][3], d[PACKET_SIZE][3], inv[PACKET_SIZE][3];
+            double best[PACKET_SIZE];
+            for (size_t l = 0; l < lanes; ++l) {
+                const Vector3D& origin = origins[first + l];
+                const Vector3D& direction = directions[first + l];
+                o[l][0] = origin.getX();
+                o[l][1] = origin.getY();
+                o[l][2] = origin.getZ();
+                d[l][0] = direction.getX();
+                d[l][1] = direction.getY();
+                d[l][2] = direction.getZ();
+                for (int a = 0; a < 3; ++a) {
+                    inv[l][a] = 1.0 / d[l][a];
+                }
+                best[l] = tMax;
+            }
+
+            uint32_t stack[STACK_SIZE];
+            size_t sp = 0;
+            stack[sp++] = 0;
+
+            while (sp > 0) {
+                const uint32_t index = stack[--sp];
+                const Node& node = nodes_[index];
+
+                bool active = false;
+                for (size_t l = 0; l < lanes && !active; ++l) {
+                    double tEntry;
+                    active = rayBox(node.bmin, node.bmax, o[l], inv[l], best[l], tEntry);
+                }
+                if (!active) continue;
+
+                if (node.count > 0) {
+                    const size_t last = node.offset + node.count;
+                    for (size_t p = node.offset; p < last; ++p) {
+                        const double* tri = &data_[9 * p];
+                        for (size_t l = 0; l < lanes; ++l) {
+                            double t, u, v;
+                            if (rayTriangle(tri, o[l], d[l], best[l], t, u, v)) {
+                                best[l] = t;
+                                BVHRayHit& hit = result[first + l];
+                                hit.hit = true;
+                                hit.triangle = primitiveIndex_[p];
+                                hit.t = t;
+                                hit.u = u;
+                                hit.v = v;
+                            }
+                        }
+                    }
+                } else {
+                    // Порядок потомков выбирается по знаку направления первого луча
+                    bool leftFirst = d[0][node.axis] >= 0.0;
+                    stack[sp++] = leftFirst ? node.offset : index + 1;
+                    stack[sp++] = leftFirst ? index + 1 : node.offset;
+                }
+            }
+        }
+    });
+    return result;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file BVH.h
+ * @brief Иерархия ограничивающих объемов для наборов точек и треугольников
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef BVH_H
+#define BVH_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Vector3D.h"
+#include "BoundingBox.h"
+
+/**
+ * @struct BVHBuildOptions
+ * @brief Параметры построения BVH
+ */
+struct BVHBuildOptions {
+    size_t maxLeafSize;        ///< Максимальное число примитивов в листе
+    size_t binCount;           ///< Количество корзин для SAH
+    double traversalCost;      ///< Стоимость обхода узла в модели SAH
+    double intersectionCost;   ///< Стоимость проверки примитива в модели SAH
+    bool parallel;             ///< Строить поддеревья в нескольких потоках
+    size_t parallelThreshold;  ///< Минимальный размер поддерева для отдельного потока
+
+    /**
+     * @brief Конструктор по умолчанию
+     * Лист до 4 примитивов, 16 корзин, последовательное построение
+     */
+    BVHBuildOptions();
+};
+
+/**
+ * @struct BVHNeighbor
+ * @brief Результат поиска ближайшей точки
+ */
+struct BVHNeighbor {
+    size_t index;     ///< Индекс точки в исходном массиве
+    double distance;  ///< Расстояние до точки запроса
+};
+
+/**
+ * @struct BVHRayHit
+ * @brief Результат пересечения луча с треугольниками
+ */
+struct BVHRayHit {
+    bool hit;         ///< Было ли пересечение
+    size_t triangle;  ///< Индекс треугольника в исходном массиве
+    double t;         ///< Параметр луча: точка = origin + t * direction
+    double u;         ///< Барицентрическая координата u
+    double v;         ///< Барицентрическая координата v
+
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает результат "нет пересечения"
+     */
+    BVHRayHit();
+};
+
+/**
+ * @class BVH
+ * @brief Иерархия ограничивающих объемов (Bounding Volume Hierarchy)
+ *
+ * Строится по эвристике площади поверхности (SAH) с разбиением на корзины.
+ * Узлы хранятся в одном плоском массиве в порядке обхода в глубину:
+ * левый потомок следует сразу за родителем, поэтому при спуске влево
+ * данные уже находятся в кэше. Примитивы переупорядочиваются так, чтобы
+ * каждый лист ссылался на непрерывный участок памяти.
+ *
+ * Дерево над точками отвечает на запросы ближайшего соседа, k ближайших
+ * и поиска в радиусе; дерево над треугольниками - на пересечение с лучом.
+ * После построения все запросы только читают структуру и безопасны
+ * при одновременном вызове из нескольких потоков.
+ */
+class BVH {
+public:
+    /**
+     * @brief Тип примитивов в дереве
+     */
+    enum PrimitiveType {
+        POINTS,     ///< Точки
+        TRIANGLES   ///< Треугольники
+    };
+
+private:
+    /**
+     * @brief Узел дерева (64 байта - одна строка кэша)
+     */
+    struct Node {
+        double bmin[3];   ///< Минимальный угол
+        double bmax[3];   ///< Максимальный угол
+        uint32_t offset;  ///< Лист: первый примитив; узел: индекс правого потомка
+        uint32_t count;   ///< Количество примитивов (0 для внутреннего узла)
+        uint32_t axis;    ///< Ось разбиения
+        uint32_t padding; ///< Выравнивание до 64 байт
+    };
+
+    PrimitiveType type_;                 ///< Тип примитивов
+    std::vector<Node> nodes_;            ///< Узлы в порядке обхода в глубину
+    std::vector<size_t> primitiveIndex_; ///< Исходные индексы примитивов
+    std::vector<double> data_;           ///< Точки (x, y, z) или треугольники (v0, e1, e2)
+    BVHBuildOptions options_;            ///< Параметры построения
+
+    void build(const std::vector<BoundingBox>& bounds,
+               const std::vector<double>& centroids);
+    void buildRange(std::vector<uint32_t>& order, size_t begin, size_t end, size_t depth,
+                    const std::vector<BoundingBox>& bounds,
+                    const std::vector<double>& centroids,
+                    std::vector<Node>& out) const;
+    void requireType(PrimitiveType type) const;
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустое дерево над точками
+     */
+    BVH();
+
+    /**
+     * @brief Построить дерево над набором точек
+     * @param points Точки
+     * @param options Параметры построения
+     * @throw std::invalid_argument если точек слишком много
+     */
+    explicit BVH(const std::vector<Vector3D>& points,
+                 const BVHBuildOptions& options = BVHBuildOptions());
+
+    /**
+     * @brief Построить дерево над треугольной сеткой
+     * @param vertices Вершины
+     * @param indices Индексы вершин, по три на треугольник
+     * @param options Параметры построения
+     * @throw std::invalid_argument если число индексов не кратно трем
+     *        или индекс выходит за границы массива вершин
+     */
+    BVH(const std::vector<Vector3D>& vertices, const std::vector<size_t>& indices,
+        const BVHBuildOptions& options = BVHBuildOptions());
+
+    // Методы доступа
+    /**
+     * @brief Получить тип примитивов
+     * @return Тип примитивов
+     */
+    PrimitiveType getType() const;
+
+    /**
+     * @brief Количество примитивов
+     * @return Количество примитивов
+     */
+    size_t size() const;
+
+    /**
+     * @brief Количество узлов дерева
+     * @return Количество узлов
+     */
+    size_t nodeCount() const;
+
+    /**
+     * @brief Проверить, пусто ли дерево
+     * @return true если примитивов нет
+     */
+    bool empty() const;
+
+    /**
+     * @brief Ограничивающий параллелепипед всего набора
+     * @return Параллелепипед корня (пустой для пустого дерева)
+     */
+    BoundingBox bounds() const;
+
+    // Запросы к точкам
+    /**
+     * @brief Найти ближайшую точку
+     * @param query Точка запроса
+     * @return Индекс и расстояние до ближайшей точки
+     * @throw std::logic_error если дерево построено не над точками
+     * @throw std::runtime_error если дерево пустое
+     */
+    BVHNeighbor nearest(const Vector3D& query) const;
+
+    /**
+     * @brief Найти k ближайших точек
+     * @param query Точка запроса
+     * @param k Количество соседей
+     * @return Соседи в порядке возрастания расстояния (не больше k)
+     * @throw std::logic_error если дерево построено не над точками
+     */
+    std::vector<BVHNeighbor> kNearest(const Vector3D& query, size_t k) const;
+
+    /**
+     * @brief Найти все точки в радиусе
+     * @param query Центр поиска
+     * @param radius Радиус поиска
+     * @return Точки на расстоянии не больше radius (в порядке обхода дерева)
+     * @throw std::logic_error если дерево построено не над точками
+     */
+    std::vector<BVHNeighbor> radiusSearch(const Vector3D& query, double radius) const;
+
+    /**
+     * @brief Найти ближайшие точки для пакета запросов
+     * @param queries Точки запроса
+     * @return Результат для каждого запроса
+     * @throw std::logic_error если дерево построено не над точками
+     * @throw std::runtime_error если дерево пустое
+     *
+     * Запросы обходят дерево пакетами по 8: узел читается один раз для
+     * всего пакета. Пакеты обрабатываются параллельно. Наибольший выигрыш
+     * достигается, когда соседние запросы близки в пространстве.
+     */
+    std::vector<BVHNeighbor> nearestBatch(const std::vector<Vector3D>& queries) const;
+
+    // Запросы к треугольникам
+    /**
+     * @brief Найти ближайшее пересечение луча с треугольниками
+     * @param origin Начало луча
+     * @param direction Направление луча (не обязательно единичное)
+     * @param tMax Максимальное значение параметра луча
+     * @return Информация о пересечении
+     * @throw std::logic_error если дерево построено не над треугольниками
+     */
+    BVHRayHit intersectRay(const Vector3D& origin, const Vector3D& direction,
+                           double tMax = 1e300) const;
+
+    /**
+     * @brief Найти пересечения для пакета лучей
+     * @param origins Начала лучей
+     * @param directions Направления лучей
+     * @param tMax Максимальное значение параметра луча
+     * @return Результат для каждого луча
+     * @throw std::logic_error если дерево построено не над треугольниками
+     * @throw std::invalid_argument если размеры массивов не совпадают
+     *
+     * Лучи обходят дерево пакетами по 8, пакеты обрабатываются параллельно.
+     */
+    std::vector<BVHRayHit> intersectRays(const std::vector<Vector3D>& origins,
+                                         const std::vector<Vector3D>& directions,
+                                         double tMax = 1e300) const;
+};
+
+#endif // BVH_H
@@ -0,0 +1,243 @@
+/**
+ * @file BandMatrix.cpp
+ * @brief Реализация ленточной матрицы и ее LU-разложения
+ */
+
+#include "BandMatrix.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+const size_t BAND_COLUMN_BLOCK = 64;  ///< Столбцов правой части в задаче одного потока
+
+} // namespace
+
+// Конструкторы
+BandMatrix::BandMatrix() : size_(0), lower_(0), upper_(0) {}
+
+BandMatrix::BandMatrix(size_t size, size_t lower, size_t upper)
+    : size_(size), lower_(lower), upper_(upper), data_(size * (lower + upper + 1), 0.0) {}
+
+BandMatrix::BandMatrix(const Matrix& matrix, size_t lower, size_t upper)
+    : size_(matrix.getRows()), lower_(lower), upper_(upper), data_(size_ * (lower + upper + 1), 0.0) {
+    if (!matrix.isSquare()) {
+        throw std::invalid_argument("Ленточная матрица должна быть квадратной");
+    }
+    for (size_t i = 0; i < size_; ++i) {
+        const std::vector<double>& row = matrix[i];
+        const size_t first = bandBegin(i);
+        std::copy(row.begin() + first, row.begin() + bandEnd(i), data_.begin() + i * width() + first + lower_ - i);
+    }
+}
+
+// Методы доступа
+double BandMatrix::get(size_t row, size_t col) const {
+    if (row >= size_ || col >= size_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    if (col < bandBegin(row) || col >= bandEnd(row)) return 0.0;
+    return data_[row * width() + col + lower_ - row];
+}
+
+void BandMatrix::set(size_t row, size_t col, double value) {
+    if (row >= size_ || col >= size_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    if (col < bandBegin(row) || col >= bandEnd(row)) {
+        throw std::invalid_argument("Элемент вне ленты матрицы");
+    }
+    data_[row * width() + col + lower_ - row] = value;
+}
+
+Matrix BandMatrix::toMatrix() const {
+    Matrix result(size_, size_);
+    for (size_t i = 0; i < size_; ++i) {
+        const size_t first = bandBegin(i);
+        const double* band = &data_[i * width() + first + lower_ - i];
+        std::copy(band, band + bandEnd(i) - first, result[i].begin() + first);
+    }
+    return result;
+}
+
+size_t BandMatrix::memoryUsage() const {
+    return sizeof(*this) + data_.size() * sizeof(double);
+}
+
+// Операции
+std::vector<double> BandMatrix::multiply(const std::vector<double>& x) const {
+    if (x.size() != size_) {
+        throw std::invalid_argument("Длина вектора не совпадает с порядком матрицы");
+    }
+    std::vector<double> y(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        const size_t first = bandBegin(i);
+        const size_t length = bandEnd(i) - first;
+        const double* band = &data_[i * width() + first + lower_ - i];
+        const double* xs = &x[first];
+        double sum = 0.0;
+        for (size_t j = 0; j < length; ++j) sum += band[j] * xs[j];
+        y[i] = sum;
+    }
+    return y;
+}
+
+Matrix BandMatrix::multiply(const Matrix& b) const {
+    if (b.getRows() != size_) {
+        throw std::invalid_argument("Несовместимые размеры для умножения матриц");
+    }
+    Matrix result(size_, b.getCols());
+    Parallel::forEachBlock(b.getCols(), BAND_COLUMN_BLOCK, [&](size_t, size_t begin, size_t end) {
+        const size_t count = end - begin;
+        for (size_t i = 0; i < size_; ++i) {
+            const size_t first = bandBegin(i);
+            const double* band = &data_[i * width() + first + lower_ - i];
+            double* ci = &result[i][begin];
+            for (size_t j = first; j < bandEnd(i); ++j) {
+                const double a = band[j - first];
+                const double* bj = &b[j][begin];
+                for (size_t c = 0; c < count; ++c) ci[c] += a * bj[c];
+            }
+        }
+    });
+    return result;
+}
+
+std::vector<double> BandMatrix::solve(const std::vector<double>& b) const {
+    return BandLUDecomposition(*this).solve(b);
+}
+
+// Конструкторы
+BandLUDecomposition::BandLUDecomposition() : size_(0), lower_(0), upper_(0), sign_(1), singular_(false) {}
+
+BandLUDecomposition::BandLUDecomposition(const BandMatrix& matrix)
+    : size_(matrix.size()),
+      lower_(matrix.getLowerBandwidth()),
+      upper_(matrix.getLowerBandwidth() + matrix.getUpperBandwidth()),
+      sign_(1),
+      singular_(false) {
+    const size_t n = size_;
+    const size_t w = width();
+    lu_.assign(n * w, 0.0);
+    pivots_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t first = i > lower_ ? i - lower_ : 0;
+        const size_t last = std::min(n, i + matrix.getUpperBandwidth() + 1);
+        for (size_t j = first; j < last; ++j) lu_[i * w + j + lower_ - i] = matrix.get(i, j);
+    }
+
+    // Строки k и ниже трогаются только в столбцах k..lastColumn(k):
+    // вне этого окна после перестановок остаются нули
+    for (size_t k = 0; k < n; ++k) {
+        const size_t rowEnd = lastRow(k);
+        const size_t colEnd = lastColumn(k);
+        size_t pivot = k;
+        double best = std::abs(lu_[k * w + lower_]);
+        for (size_t i = k + 1; i <= rowEnd; ++i) {
+            const double value = std::abs(lu_[i * w + k + lower_ - i]);
+            if (value > best) {
+                best = value;
+                pivot = i;
+            }
+        }
+        pivots_[k] = pivot;
+        if (pivot != k) {
+            for (size_t j = k; j <= colEnd; ++j) {
+                std::swap(lu_[k * w + j + lower_ - k], lu_[pivot * w + j + lower_ - pivot]);
+            }
+            sign_ = -sign_;
+        }
+        if (best == 0.0) {
+            singular_ = true;
+            continue;
+        }
+
+        const double* rowK = &lu_[k * w + lower_];  // столбец k строки k
+        const double inv = 1.0 / rowK[0];
+        const size_t length = colEnd - k;
+        for (size_t i = k + 1; i <= rowEnd; ++i) {
+            double* rowI = &lu_[i * w + k + lower_ - i];
+            const double factor = rowI[0] * inv;
+            rowI[0] = factor;
+            for (size_t j = 1; j <= length; ++j) rowI[j] -= factor * rowK[j];
+        }
+    }
+}
+
+size_t BandLUDecomposition::memoryUsage() const {
+    return sizeof(*this) + lu_.size() * sizeof(double) + pivots_.size() * sizeof(size_t);
+}
+
+// Операции
+double BandLUDecomposition::determinant() const {
+    if (singular_) return 0.0;
+    double det = static_cast<double>(sign_);
+    for (size_t i = 0; i < size_; ++i) det *= lu_[i * width() + lower_];
+    return det;
+}
+
+std::vector<double> BandLUDecomposition::solve(const std::vector<double>& b) const {
+    if (b.size() != size_) {
+        throw std::invalid_argument("Длина правой части не совпадает с порядком матрицы");
+    }
+    if (singular_) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    const size_t n = size_;
+    const size_t w = width();
+    std::vector<double> x(b);
+    // L * y = P * b: перестановки чередуются с исключением
+    for (size_t k = 0; k < n; ++k) {
+        std::swap(x[k], x[pivots_[k]]);
+        const double xk = x[k];
+        for (size_t i = k + 1; i <= lastRow(k); ++i) x[i] -= lu_[i * w + k + lower_ - i] * xk;
+    }
+    // U * x = y
+    for (size_t i = n; i-- > 0;) {
+        const double* row = &lu_[i * w + lower_];  // столбец i строки i
+        const size_t length = lastColumn(i) - i;
+        double sum = x[i];
+        for (size_t j = 1; j <= length; ++j) sum -= row[j] * x[i + j];
+        x[i] = sum / row[0];
+    }
+    return x;
+}
+
+Matrix BandLUDecomposition::solve(const Matrix& b) const {
+    if (b.getRows() != size_) {
+        throw std::invalid_argument("Число строк правой части не совпадает с порядком матрицы");
+    }
+    if (singular_) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    const size_t n = size_;
+    const size_t w = width();
+    Matrix result(b);
+    Parallel::forEachBlock(b.getCols(), BAND_COLUMN_BLOCK, [&](size_t, size_t begin, size_t end) {
+        const size_t count = end - begin;
+        for (size_t k = 0; k < n; ++k) {
+            double* xk = &result[k][begin];
+            if (pivots_[k] != k) std::swap_ranges(xk, xk + count, &result[pivots_[k]][begin]);
+            for (size_t i = k + 1; i <= lastRow(k); ++i) {
+                const double factor = lu_[i * w + k + lower_ - i];
+                double* xi = &result[i][begin];
+                for (size_t c = 0; c < count; ++c) xi[c] -= factor * xk[c];
+            }
+        }
+        for (size_t i = n; i-- > 0;) {
+            const double* row = &lu_[i * w + lower_];
+            double* xi = &result[i][begin];
+            for (size_t j = i + 1; j <= lastColumn(i); ++j) {
+                const double a = row[j - i];
+                const double* xj = &result[j][begin];
+                for (size_t c = 0; c < count; ++c) xi[c] -= a * xj[c];
+            }
+            const double inv = 1.0 / row[0];
+            for (size_t c = 0; c < count; ++c) xi[c] *= inv;
+        }
+    });
+    return result;
+}
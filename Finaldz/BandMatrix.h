@@ -0,0 +1,177 @@
+/**
+ * @file BandMatrix.h
+ * @brief Ленточная матрица и ее LU-разложение
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef BANDMATRIX_H
+#define BANDMATRIX_H
+
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * @class BandMatrix
+ * @brief Квадратная матрица с ненулевыми элементами только в ленте
+ *
+ * Ненулевыми могут быть элементы (i, j) с i - lower <= j <= i + upper.
+ * Каждая строка хранит lower + upper + 1 чисел ленты подряд, поэтому
+ * трехдиагональная матрица порядка n занимает 3 * n чисел вместо n^2,
+ * а умножение на вектор стоит O(n * (lower + upper)) операций.
+ */
+class BandMatrix {
+private:
+    size_t size_;               ///< Порядок матрицы
+    size_t lower_;              ///< Число поддиагоналей
+    size_t upper_;              ///< Число наддиагоналей
+    std::vector<double> data_;  ///< Ленты строк подряд: (i, j) в i * width + j + lower - i
+
+    size_t width() const { return lower_ + upper_ + 1; }
+    size_t bandBegin(size_t row) const { return row > lower_ ? row - lower_ : 0; }
+    size_t bandEnd(size_t row) const { return row + upper_ + 1 < size_ ? row + upper_ + 1 : size_; }
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустую матрицу
+     */
+    BandMatrix();
+
+    /**
+     * @brief Конструктор нулевой матрицы
+     * @param size Порядок матрицы
+     * @param lower Число поддиагоналей
+     * @param upper Число наддиагоналей
+     */
+    BandMatrix(size_t size, size_t lower, size_t upper);
+
+    /**
+     * @brief Упаковать ленту матрицы
+     * @param matrix Квадратная матрица; элементы вне ленты отбрасываются
+     * @param lower Число поддиагоналей
+     * @param upper Число наддиагоналей
+     * @throw std::invalid_argument если матрица не квадратная
+     */
+    BandMatrix(const Matrix& matrix, size_t lower, size_t upper);
+
+    // Методы доступа
+    size_t size() const { return size_; }
+    size_t getLowerBandwidth() const { return lower_; }
+    size_t getUpperBandwidth() const { return upper_; }
+
+    /**
+     * @brief Получить элемент (вне ленты - ноль)
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t row, size_t col) const;
+
+    /**
+     * @brief Установить элемент ленты
+     * @throw std::out_of_range если индексы вне границ
+     * @throw std::invalid_argument если элемент вне ленты
+     */
+    void set(size_t row, size_t col, double value);
+
+    /**
+     * @brief Развернуть в обычную матрицу
+     */
+    Matrix toMatrix() const;
+
+    /**
+     * @brief Объем занимаемой памяти в байтах
+     */
+    size_t memoryUsage() const;
+
+    // Операции
+    /**
+     * @brief Произведение A * x
+     * @throw std::invalid_argument если длина x не совпадает с порядком
+     */
+    std::vector<double> multiply(const std::vector<double>& x) const;
+
+    /**
+     * @brief Произведение A * B
+     * @throw std::invalid_argument если число строк B не совпадает с порядком
+     */
+    Matrix multiply(const Matrix& b) const;
+
+    /**
+     * @brief Решить систему A * x = b через BandLUDecomposition
+     * @throw std::invalid_argument если длина b не совпадает с порядком
+     *        или матрица вырожденная
+     */
+    std::vector<double> solve(const std::vector<double>& b) const;
+};
+
+/**
+ * @class BandLUDecomposition
+ * @brief Разложение P * A = L * U ленточной матрицы с выбором ведущего элемента
+ *
+ * Перестановки строк расширяют ленту U до lower + upper наддиагоналей,
+ * поэтому строка разложения хранит 2 * lower + upper + 1 чисел; L лежит
+ * в ее первых lower позициях. Разложение стоит O(n * lower * (lower + upper))
+ * операций, решение системы - O(n * (lower + upper)), вместо O(n^3) и O(n^2)
+ * у LUDecomposition.
+ *
+ * Как в LAPACK (gbtrf), перестановка шага k применяется только к столбцам
+ * k и правее, а solve() выполняет перестановки поочередно с исключением.
+ */
+class BandLUDecomposition {
+private:
+    size_t size_;                 ///< Порядок матрицы
+    size_t lower_;                ///< Поддиагоналей L
+    size_t upper_;                ///< Наддиагоналей U (lower + upper исходной матрицы)
+    std::vector<double> lu_;      ///< Строки разложения: (i, j) в i * width + j + lower - i
+    std::vector<size_t> pivots_;  ///< Строка, переставленная со строкой k на шаге k
+    int sign_;                    ///< Четность перестановки: +1 или -1
+    bool singular_;               ///< Встретился нулевой ведущий элемент
+
+    size_t width() const { return lower_ + upper_ + 1; }
+    size_t lastRow(size_t k) const { return k + lower_ < size_ ? k + lower_ : size_ - 1; }
+    size_t lastColumn(size_t k) const { return k + upper_ < size_ ? k + upper_ : size_ - 1; }
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает разложение пустой матрицы
+     */
+    BandLUDecomposition();
+
+    /**
+     * @brief Разложить ленточную матрицу
+     * @param matrix Ленточная матрица
+     */
+    explicit BandLUDecomposition(const BandMatrix& matrix);
+
+    // Методы доступа
+    size_t size() const { return size_; }
+    bool isSingular() const { return singular_; }
+
+    /**
+     * @brief Объем занимаемой памяти в байтах
+     */
+    size_t memoryUsage() const;
+
+    // Операции
+    /**
+     * @brief Определитель исходной матрицы
+     */
+    double determinant() const;
+
+    /**
+     * @brief Решить систему A * x = b
+     * @throw std::invalid_argument если длина b не совпадает с порядком
+     *        или матрица вырожденная
+     */
+    std::vector<double> solve(const std::vector<double>& b) const;
+
+    /**
+     * @brief Решить систему A * X = B для нескольких правых частей
+     * @throw std::invalid_argument если число строк B не совпадает с порядком
+     *        или матрица вырожденная
+     */
+    Matrix solve(const Matrix& b) const;
+};
+
+#endif // BANDMATRIX_H
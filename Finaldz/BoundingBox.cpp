@@ -0,0 +1,103 @@
+/**
+ * @file BoundingBox.cpp
+ * @brief Реализация класса ограничивающего параллелепипеда
+ */
+
+#include "BoundingBox.h"
+#include <limits>
+#include <cmath>
+
+// Конструкторы
+BoundingBox::BoundingBox() {
+    const double inf = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 3; ++i) {
+        min_[i] = inf;
+        max_[i] = -inf;
+    }
+}
+
+BoundingBox::BoundingBox(const Vector3D& min, const Vector3D& max) : BoundingBox() {
+    expand(min);
+    expand(max);
+}
+
+// Методы доступа
+Vector3D BoundingBox::getMin() const {
+    return Vector3D(min_[0], min_[1], min_[2]);
+}
+
+Vector3D BoundingBox::getMax() const {
+    return Vector3D(max_[0], max_[1], max_[2]);
+}
+
+bool BoundingBox::isEmpty() const {
+    return min_[0] > max_[0] || min_[1] > max_[1] || min_[2] > max_[2];
+}
+
+// Операции
+void BoundingBox::expand(const Vector3D& point) {
+    expand(point.getX(), point.getY(), point.getZ());
+}
+
+void BoundingBox::expand(const BoundingBox& other) {
+    for (int i = 0; i < 3; ++i) {
+        if (other.min_[i] < min_[i]) min_[i] = other.min_[i];
+        if (other.max_[i] > max_[i]) max_[i] = other.max_[i];
+    }
+}
+
+Vector3D BoundingBox::center() const {
+    return Vector3D((min_[0] + max_[0]) * 0.5,
+                    (min_[1] + max_[1]) * 0.5,
+                    (min_[2] + max_[2]) * 0.5);
+}
+
+Vector3D BoundingBox::extent() const {
+    if (isEmpty()) {
+        return Vector3D();
+    }
+    return Vector3D(max_[0] - min_[0], max_[1] - min_[1], max_[2] - min_[2]);
+}
+
+double BoundingBox::surfaceArea() const {
+    if (isEmpty()) {
+        return 0.0;
+    }
+    double dx = max_[0] - min_[0];
+    double dy = max_[1] - min_[1];
+    double dz = max_[2] - min_[2];
+    return 2.0 * (dx * dy + dy * dz + dz * dx);
+}
+
+int BoundingBox::longestAxis() const {
+    double dx = max_[0] - min_[0];
+    double dy = max_[1] - min_[1];
+    double dz = max_[2] - min_[2];
+    if (dx >= dy && dx >= dz) return 0;
+    return dy >= dz ? 1 : 2;
+}
+
+bool BoundingBox::contains(const Vector3D& point) const {
+    return point.getX() >= min_[0] && point.getX() <= max_[0] &&
+           point.getY() >= min_[1] && point.getY() <= max_[1] &&
+           point.getZ() >= min_[2] && point.getZ() <= max_[2];
+}
+
+bool BoundingBox::intersects(const BoundingBox& other) const {
+    for (int i = 0; i < 3; ++i) {
+        if (other.min_[i] > max_[i] || other.max_[i] < min_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double BoundingBox::distanceTo(const Vector3D& point) const {
+    return std::sqrt(distanceSquaredTo(point.getX(), point.getY(), point.getZ()));
+}
+
+// Дружественные функции
+std::ostream& operator<<(std::ostream& os, const BoundingBox& box) {
+    os << "[" << box.getMin() << " - " << box.getMax() << "]";
+    return os;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file BoundingBox.h
+ * @brief Класс для работы с ограничивающими параллелепипедами (AABB)
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef BOUNDINGBOX_H
+#define BOUNDINGBOX_H
+
+#include <iostream>
+#include "Vector3D.h"
+
+/**
+ * @class BoundingBox
+ * @brief Ограничивающий параллелепипед, выровненный по осям координат
+ *
+ * Пустой параллелепипед имеет min = +inf и max = -inf, поэтому его можно
+ * расширять точками без отдельной проверки на пустоту.
+ */
+class BoundingBox {
+private:
+    double min_[3];  ///< Минимальные координаты
+    double max_[3];  ///< Максимальные координаты
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустой параллелепипед
+     */
+    BoundingBox();
+
+    /**
+     * @brief Конструктор по двум углам
+     * @param min Минимальный угол
+     * @param max Максимальный угол
+     */
+    BoundingBox(const Vector3D& min, const Vector3D& max);
+
+    // Методы доступа
+    /**
+     * @brief Получить минимальный угол
+     * @return Минимальный угол
+     */
+    Vector3D getMin() const;
+
+    /**
+     * @brief Получить максимальный угол
+     * @return Максимальный угол
+     */
+    Vector3D getMax() const;
+
+    /**
+     * @brief Минимальная координата по оси
+     * @param axis Номер оси (0 - X, 1 - Y, 2 - Z)
+     * @return Минимальная координата
+     */
+    double minAt(int axis) const { return min_[axis]; }
+
+    /**
+     * @brief Максимальная координата по оси
+     * @param axis Номер оси (0 - X, 1 - Y, 2 - Z)
+     * @return Максимальная координата
+     */
+    double maxAt(int axis) const { return max_[axis]; }
+
+    /**
+     * @brief Проверить, пуст ли параллелепипед
+     * @return true если не содержит ни одной точки
+     */
+    bool isEmpty() const;
+
+    // Операции
+    /**
+     * @brief Расширить параллелепипед точкой
+     * @param x Координата X
+     * @param y Координата Y
+     * @param z Координата Z
+     */
+    void expand(double x, double y, double z) {
+        if (x < min_[0]) min_[0] = x;
+        if (y < min_[1]) min_[1] = y;
+        if (z < min_[2]) min_[2] = z;
+        if (x > max_[0]) max_[0] = x;
+        if (y > max_[1]) max_[1] = y;
+        if (z > max_[2]) max_[2] = z;
+    }
+
+    /**
+     * @brief Расширить параллелепипед точкой
+     * @param point Точка
+     */
+    void expand(const Vector3D& point);
+
+    /**
+     * @brief Расширить параллелепипед другим параллелепипедом
+     * @param other Другой параллелепипед
+     */
+    void expand(const BoundingBox& other);
+
+    /**
+     * @brief Центр параллелепипеда
+     * @return Центр
+     */
+    Vector3D center() const;
+
+    /**
+     * @brief Размеры параллелепипеда по осям
+     * @return Вектор размеров
+     */
+    Vector3D extent() const;
+
+    /**
+     * @brief Площадь поверхности (используется в SAH)
+     * @return Площадь поверхности, 0 для пустого
+     */
+    double surfaceArea() const;
+
+    /**
+     * @brief Номер оси наибольшей протяженности
+     * @return 0, 1 или 2
+     */
+    int longestAxis() const;
+
+    /**
+     * @brief Проверить, содержит ли параллелепипед точку
+     * @param point Точка
+     * @return true если точка внутри или на границе
+     */
+    bool contains(const Vector3D& point) const;
+
+    /**
+     * @brief Проверить пересечение с другим параллелепипедом
+     * @param other Другой параллелепипед
+     * @return true если параллелепипеды пересекаются
+     */
+    bool intersects(const BoundingBox& other) const;
+
+    /**
+     * @brief Квадрат расстояния от точки до параллелепипеда
+     * @param x Координата X
+     * @param y Координата Y
+     * @param z Координата Z
+     * @return Квадрат расстояния (0 если точка внутри)
+     */
+    double distanceSquaredTo(double x, double y, double z) const {
+        double dx = x < min_[0] ? min_[0] - x : (x > max_[0] ? x - max_[0] : 0.0);
+        double dy = y < min_[1] ? min_[1] - y : (y > max_[1] ? y - max_[1] : 0.0);
+        double dz = z < min_[2] ? min_[2] - z : (z > max_[2] ? z - max_[2] : 0.0);
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    /**
+     * @brief Расстояние от точки до параллелепипеда
+     * @param point Точка
+     * @return Расстояние (0 если точка внутри)
+     */
+    double distanceTo(const Vector3D& point) const;
+
+    // Дружественные функции
+    /**
+     * @brief Оператор вывода в поток
+     * @param os Выходной поток
+     * @param box Параллелепипед для вывода
+     * @return Ссылка на поток
+     */
+    friend std::ostream& operator<<(std::ostream& os, const BoundingBox& box);
+};
+
+#endif // BOUNDINGBOX_H
@@ -7,24 +7,7 @@
 #include <stdexcept>
 #include <iomanip>
 
-// Конструкторы и деструктор
-Complex::Complex() : real_(0.0), imag_(0.0) {}
-
-Complex::Complex(double real, double imag) : real_(real), imag_(imag) {}
-
-Complex::Complex(const Complex& other) : real_(other.real_), imag_(other.imag_) {}
-
-Complex::~Complex() {}
-
 // Методы доступа
-double Complex::getReal() const {
-    return real_;
-}
-
-double Complex::getImag() const {
-    return imag_;
-}
-
 void Complex::setReal(double real) {
     real_ = real;
 }
@@ -34,14 +17,6 @@ void Complex::setImag(double imag) {
 }
 
 // Арифметические операторы
-Complex& Complex::operator=(const Complex& other) {
-    if (this != &other) {
-        real_ = other.real_;
-        imag_ = other.imag_;
-    }
-    return *this;
-}
-
 Complex Complex::operator+(const Complex& other) const {
     return Complex(real_ + other.real_, imag_ + other.imag_);
 }
@@ -117,6 +92,10 @@ Complex Complex::conjugate() const {
 }
 
 Complex Complex::power(double power) const {
+    // 0^0 = 1, как и у целой степени
+    if (power == 0.0) {
+        return Complex(1.0, 0.0);
+    }
     if (real_ == 0.0 && imag_ == 0.0) {
         return Complex(0.0, 0.0);
     }
@@ -130,8 +109,55 @@ Complex Complex::power(double power) const {
     return Complex(new_r * std::cos(new_theta), new_r * std::sin(new_theta));
 }
 
+Complex Complex::integerPower(unsigned long long exponent, bool negative) const {
+    if (exponent == 0) {
+        return Complex(1.0, 0.0);
+    }
+
+    double base_real = real_;
+    double base_imag = imag_;
+    if (negative) {
+        // Отрицательная степень
+        double denominator = real_ * real_ + imag_ * imag_;
+        if (denominator == 0.0) {
+            throw std::invalid_argument("Нельзя возвести ноль в отрицательную степень");
+        }
+        base_real = real_ / denominator;
+        base_imag = -imag_ / denominator;
+    }
+
+    // Возведение в квадрат по битам показателя
+    double result_real = 1.0;
+    double result_imag = 0.0;
+    while (true) {
+        if (exponent & 1ull) {
+            double t = result_real * base_real - result_imag * base_imag;
+            result_imag = result_real * base_imag + result_imag * base_real;
+            result_real = t;
+        }
+        exponent >>= 1;
+        if (exponent == 0) {
+            break;
+        }
+        double t = base_real * base_real - base_imag * base_imag;
+        base_imag = 2.0 * base_real * base_imag;
+        base_real = t;
+    }
+    return Complex(result_real, result_imag);
+}
+
 Complex Complex::sqrt() const {
-    return power(0.5);
+    if (real_ == 0.0 && imag_ == 0.0) {
+        return Complex(0.0, 0.0);
+    }
+
+    // sqrt(z) = t + i * imag / (2t), t = sqrt((|z| + real) / 2);
+    // при real < 0 части меняются местами, чтобы избежать вычитания близких чисел
+    double t = std::sqrt((std::abs(real_) + magnitude()) * 0.5);
+    if (real_ >= 0.0) {
+        return Complex(t, imag_ / (2.0 * t));
+    }
+    return Complex(std::abs(imag_) / (2.0 * t), std::signbit(imag_) ? -t : t);
 }
 
 // Дружественные функции для ввода/вывода
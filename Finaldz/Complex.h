@@ -10,6 +10,7 @@
 
 #include <iostream>
 #include <cmath>
+#include <type_traits>
 
 /**
  * @class Complex
@@ -23,43 +24,48 @@ private:
     double real_;  ///<    
     double imag_;  ///<    
 
+    /**
+     * @brief        
+     */
+    Complex integerPower(unsigned long long exponent, bool negative) const;
+
 public:
     /**
      * @brief   
      *    0 + 0i
      */
-    Complex();
+    constexpr Complex() : real_(0.0), imag_(0.0) {}
 
     /**
      * @brief   
      * @param real  
      * @param imag  
      */
-    Complex(double real, double imag = 0.0);
+    constexpr Complex(double real, double imag = 0.0) : real_(real), imag_(imag) {}
 
     /**
      * @brief  
      * @param other  
      */
-    Complex(const Complex& other);
+    Complex(const Complex& other) = default;
 
     /**
      * @brief 
      */
-    ~Complex();
+    ~Complex() = default;
 
     //  
     /**
      * @brief   
      * @return   
      */
-    double getReal() const;
+    constexpr double getReal() const { return real_; }
 
     /**
      * @brief   
      * @return   
      */
-    double getImag() const;
+    constexpr double getImag() const { return imag_; }
 
     /**
      * @brief   
@@ -79,7 +85,7 @@ public:
      * @param other  
      * @return    
      */
-    Complex& operator=(const Complex& other);
+    Complex& operator=(const Complex& other) = default;
 
     /**
      * @brief  
@@ -180,9 +186,30 @@ public:
      */
     Complex power(double power) const;
 
+    /**
+     * @brief    
+     * @param power     
+     * @return    
+     * @throw std::invalid_argument      
+     *
+     *       
+     *   : O(log |power|)    
+     *     .    
+     * ,    unsigned, long  size_t  
+     *      power(double).
+     */
+    template <typename Integer>
+    typename std::enable_if<std::is_integral<Integer>::value, Complex>::type power(Integer power) const {
+        const bool negative = power < static_cast<Integer>(0);
+        const unsigned long long magnitude = static_cast<unsigned long long>(power);
+        return integerPower(negative ? 0ull - magnitude : magnitude, negative);
+    }
+
     /**
      * @brief   
      * @return    
+     *
+     *  ,   .
      */
     Complex sqrt() const;
 
@@ -0,0 +1,331 @@
+/**
+ * @file ComplexArray.cpp
+ * @brief Реализация массива комплексных чисел с раздельным хранением частей
+ */
+
+#include "ComplexArray.h"
+#include "Simd.h"
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// Конструкторы
+ComplexArray::ComplexArray() {}
+
+ComplexArray::ComplexArray(size_t size) : real_(size, 0.0), imag_(size, 0.0) {}
+
+ComplexArray::ComplexArray(const std::vector<Complex>& values)
+    : real_(values.size()), imag_(values.size()) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        real_[i] = values[i].getReal();
+        imag_[i] = values[i].getImag();
+    }
+}
+
+ComplexArray::ComplexArray(const std::vector<double>& real, const std::vector<double>& imag)
+    : real_(real), imag_(imag) {
+    if (real.size() != imag.size()) {
+        throw std::invalid_argument("Длины действительной и мнимой частей различаются");
+    }
+}
+
+// Методы доступа
+size_t ComplexArray::size() const {
+    return real_.size();
+}
+
+void ComplexArray::resize(size_t size) {
+    real_.resize(size, 0.0);
+    imag_.resize(size, 0.0);
+}
+
+Complex ComplexArray::get(size_t index) const {
+    if (index >= real_.size()) {
+        throw std::out_of_range("Индекс вне границ массива");
+    }
+    return Complex(real_[index], imag_[index]);
+}
+
+void ComplexArray::set(size_t index, const Complex& value) {
+    if (index >= real_.size()) {
+        throw std::out_of_range("Индекс вне границ массива");
+    }
+    real_[index] = value.getReal();
+    imag_[index] = value.getImag();
+}
+
+double* ComplexArray::realData() {
+    return real_.empty() ? 0 : &real_[0];
+}
+
+const double* ComplexArray::realData() const {
+    return real_.empty() ? 0 : &real_[0];
+}
+
+double* ComplexArray::imagData() {
+    return imag_.empty() ? 0 : &imag_[0];
+}
+
+const double* ComplexArray::imagData() const {
+    return imag_.empty() ? 0 : &imag_[0];
+}
+
+std::vector<Complex> ComplexArray::toVector() const {
+    std::vector<Complex> result;
+    result.reserve(real_.size());
+    for (size_t i = 0; i < real_.size(); ++i) {
+        result.push_back(Complex(real_[i], imag_[i]));
+    }
+    return result;
+}
+
+// Пакетные операции
+unsigned ComplexArray::multiply(const ComplexArray& other, ComplexArray& result) const {
+    const size_t n = size();
+    if (other.size() != n) return SIZE_MISMATCH;
+    result.resize(n);
+
+    const double* ar = realData();
+    const double* ai = imagData();
+    const double* br = other.realData();
+    const double* bi = other.imagData();
+    double* rr = result.realData();
+    double* ri = result.imagData();
+    size_t i = 0;
+#if MATH_SIMD
+    // Результат может совпадать с операндом: элементы i читаются до записи
+    for (const size_t end = Simd::vectorEnd(n); i < end; i += Simd::WIDTH) {
+        const Simd::Doubles xr = Simd::load(ar + i), xi = Simd::load(ai + i);
+        const Simd::Doubles yr = Simd::load(br + i), yi = Simd::load(bi + i);
+        Simd::store(rr + i, Simd::sub(Simd::mul(xr, yr), Simd::mul(xi, yi)));
+        Simd::store(ri + i, Simd::add(Simd::mul(xr, yi), Simd::mul(xi, yr)));
+    }
+#endif
+    for (; i < n; ++i) {
+        const double xr = ar[i], xi = ai[i], yr = br[i], yi = bi[i];
+        rr[i] = xr * yr - xi * yi;
+        ri[i] = xr * yi + xi * yr;
+    }
+    return OK;
+}
+
+unsigned ComplexArray::multiplyConjugate(const ComplexArray& other, ComplexArray& result) const {
+    const size_t n = size();
+    if (other.size() != n) return SIZE_MISMATCH;
+    result.resize(n);
+
+    const double* ar = realData();
+    const double* ai = imagData();
+    const double* br = other.realData();
+    const double* bi = other.imagData();
+    double* rr = result.realData();
+    double* ri = result.imagData();
+    size_t i = 0;
+#if MATH_SIMD
+    for (const size_t end = Simd::vectorEnd(n); i < end; i += Simd::WIDTH) {
+        const Simd::Doubles xr = Simd::load(ar + i), xi = Simd::load(ai + i);
+        const Simd::Doubles yr = Simd::load(br + i), yi = Simd::load(bi + i);
+        Simd::store(rr + i, Simd::add(Simd::mul(xr, yr), Simd::mul(xi, yi)));
+        Simd::store(ri + i, Simd::sub(Simd::mul(xi, yr), Simd::mul(xr, yi)));
+    }
+#endif
+    for (; i < n; ++i) {
+        const double xr = ar[i], xi = ai[i], yr = br[i], yi = bi[i];
+        rr[i] = xr * yr + xi * yi;
+        ri[i] = xi * yr - xr * yi;
+    }
+    return OK;
+}
+
+unsigned ComplexArray::divide(const ComplexArray& other, ComplexArray& result) const {
+    const size_t n = size();
+    if (other.size() != n) return SIZE_MISMATCH;
+    result.resize(n);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double* ar = realData();
+    const double* ai = imagData();
+    const double* br = other.realData();
+    const double* bi = other.imagData();
+    double* rr = result.realData();
+    double* ri = result.imagData();
+
+    // Вместо исключения - выбор значения и накопление флага: цикл остается
+    // без переходов, выбор выполняется операцией смешивания
+    int zero = 0;
+    size_t i = 0;
+#if MATH_SIMD
+    const Simd::Doubles one = Simd::broadcast(1.0);
+    const Simd::Doubles nanValue = Simd::broadcast(nan);
+    const Simd::Doubles zeroValue = Simd::broadcast(0.0);
+    const Simd::Doubles largest = Simd::broadcast(std::numeric_limits<double>::max());
+    for (const size_t end = Simd::vectorEnd(n); i < end; i += Simd::WIDTH) {
+        const Simd::Doubles xr = Simd::load(ar + i), xi = Simd::load(ai + i);
+        const Simd::Doubles yr = Simd::load(br + i), yi = Simd::load(bi + i);
+        const Simd::Doubles denominator = Simd::add(Simd::mul(yr, yr), Simd::mul(yi, yi));
+        const Simd::Mask good = Simd::both(Simd::greater(denominator, zeroValue),
+                                           Simd::lessEqual(denominator, largest));
+        const Simd::Doubles inv = Simd::div(one, Simd::select(good, denominator, one));
+        const Simd::Doubles qr = Simd::mul(Simd::add(Simd::mul(xr, yr), Simd::mul(xi, yi)), inv);
+        const Simd::Doubles qi = Simd::mul(Simd::sub(Simd::mul(xi, yr), Simd::mul(xr, yi)), inv);
+        Simd::store(rr + i, Simd::select(good, qr, nanValue));
+        Simd::store(ri + i, Simd::select(good, qi, nanValue));
+        zero |= static_cast<int>(!Simd::all(good));
+    }
+#endif
+    for (; i < n; ++i) {
+        const double xr = ar[i], xi = ai[i], yr = br[i], yi = bi[i];
+        const double denominator = yr * yr + yi * yi;
+        // Только |b|^2 == 0 или не конечный: то же правило, что у integerPower
+        const bool bad = !(denominator > 0.0 && denominator <= std::numeric_limits<double>::max());
+        const double inv = 1.0 / (bad ? 1.0 : denominator);
+        const double qr = (xr * yr + xi * yi) * inv;
+        const double qi = (xi * yr - xr * yi) * inv;
+        rr[i] = bad ? nan : qr;
+        ri[i] = bad ? nan : qi;
+        zero |= static_cast<int>(bad);
+    }
+    return zero ? DIVISION_BY_ZERO : OK;
+}
+
+unsigned ComplexArray::magnitude(std::vector<double>& result) const {
+    const size_t n = size();
+    result.resize(n);
+    const double* ar = realData();
+    const double* ai = imagData();
+    double* out = result.empty() ? 0 : &result[0];
+    size_t i = 0;
+#if MATH_SIMD
+    for (const size_t end = Simd::vectorEnd(n); i < end; i += Simd::WIDTH) {
+        const Simd::Doubles xr = Simd::load(ar + i), xi = Simd::load(ai + i);
+        Simd::store(out + i, Simd::sqrt(Simd::add(Simd::mul(xr, xr), Simd::mul(xi, xi))));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = std::sqrt(ar[i] * ar[i] + ai[i] * ai[i]);
+    }
+    return OK;
+}
+
+unsigned ComplexArray::argument(std::vector<double>& result) const {
+    const size_t n = size();
+    result.resize(n);
+    const double* ar = realData();
+    const double* ai = imagData();
+    for (size_t i = 0; i < n; ++i) {
+        result[i] = std::atan2(ai[i], ar[i]);
+    }
+    return OK;
+}
+
+unsigned ComplexArray::toPolar(std::vector<double>& magnitudes, std::vector<double>& angles) const {
+    return magnitude(magnitudes) | argument(angles);
+}
+
+unsigned ComplexArray::integerPower(unsigned long long exponent, bool negative, ComplexArray& result) const {
+    const size_t n = size();
+    result.resize(n);
+    const double* ar = realData();
+    const double* ai = imagData();
+    double* rr = result.realData();
+    double* ri = result.imagData();
+
+    if (n == 0) {
+        return OK;
+    }
+    if (exponent == 0) {
+        std::fill(result.real_.begin(), result.real_.end(), 1.0);
+        std::fill(result.imag_.begin(), result.imag_.end(), 0.0);
+        return OK;
+    }
+
+    // Основание хранится в отдельных массивах: результат может совпадать с this
+    std::vector<double> baseR(ar, ar + n), baseI(ai, ai + n);
+    int zero = 0;
+    if (negative) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        for (size_t i = 0; i < n; ++i) {
+            const double norm = baseR[i] * baseR[i] + baseI[i] * baseI[i];
+            const bool bad = norm == 0.0;
+            const double inv = 1.0 / (bad ? 1.0 : norm);
+            baseR[i] = bad ? nan : baseR[i] * inv;
+            baseI[i] = bad ? nan : -baseI[i] * inv;
+            zero |= static_cast<int>(bad);
+        }
+    }
+
+    std::fill(rr, rr + n, 1.0);
+    std::fill(ri, ri + n, 0.0);
+    double* br = &baseR[0];
+    double* bi = &baseI[0];
+    while (true) {
+        if (exponent & 1ull) {
+            for (size_t i = 0; i < n; ++i) {
+                const double t = rr[i] * br[i] - ri[i] * bi[i];
+                ri[i] = rr[i] * bi[i] + ri[i] * br[i];
+                rr[i] = t;
+            }
+        }
+        exponent >>= 1;
+        if (exponent == 0) break;
+        for (size_t i = 0; i < n; ++i) {
+            const double t = br[i] * br[i] - bi[i] * bi[i];
+            bi[i] = 2.0 * br[i] * bi[i];
+            br[i] = t;
+        }
+    }
+    return zero ? DIVISION_BY_ZERO : OK;
+}
+
+unsigned ComplexArray::power(double power, ComplexArray& result) const {
+    const size_t n = size();
+    result.resize(n);
+    const double* ar = realData();
+    const double* ai = imagData();
+    double* rr = result.realData();
+    double* ri = result.imagData();
+    for (size_t i = 0; i < n; ++i) {
+        const double xr = ar[i], xi = ai[i];
+        const double norm = xr * xr + xi * xi;
+        // |z|^p = exp(p * ln|z|^2 / 2); ноль остается нулем, кроме 0^0 = 1, как в Complex::power
+        const double magnitude = norm == 0.0 ? (power == 0.0 ? 1.0 : 0.0) : std::exp(0.5 * power * std::log(norm));
+        const double angle = power * std::atan2(xi, xr);
+        rr[i] = magnitude * std::cos(angle);
+        ri[i] = magnitude * std::sin(angle);
+    }
+    return OK;
+}
+
+unsigned ComplexArray::sqrt(ComplexArray& result) const {
+    const size_t n = size();
+    result.resize(n);
+    const double* ar = realData();
+    const double* ai = imagData();
+    double* rr = result.realData();
+    double* ri = result.imagData();
+    for (size_t i = 0; i < n; ++i) {
+        const double xr = ar[i], xi = ai[i];
+        const double t = std::sqrt((std::abs(xr) + std::sqrt(xr * xr + xi * xi)) * 0.5);
+        const double other = t == 0.0 ? 0.0 : std::abs(xi) / (2.0 * t);
+        const bool positive = xr >= 0.0;
+        rr[i] = positive ? t : other;
+        ri[i] = positive ? (t == 0.0 ? 0.0 : xi / (2.0 * t)) : (std::signbit(xi) ? -t : t);
+    }
+    return OK;
+}
+
+// Статические методы
+unsigned ComplexArray::fromPolar(const std::vector<double>& magnitudes, const std::vector<double>& angles,
+                                 ComplexArray& result) {
+    const size_t n = magnitudes.size();
+    if (angles.size() != n) return SIZE_MISMATCH;
+    result.resize(n);
+    double* rr = result.realData();
+    double* ri = result.imagData();
+    for (size_t i = 0; i < n; ++i) {
+        rr[i] = magnitudes[i] * std::cos(angles[i]);
+        ri[i] = magnitudes[i] * std::sin(angles[i]);
+    }
+    return OK;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file ComplexArray.h
+ * @brief Массив комплексных чисел с раздельным хранением частей
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef COMPLEXARRAY_H
+#define COMPLEXARRAY_H
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include "Complex.h"
+
+/**
+ * @class ComplexArray
+ * @brief Массив комплексных чисел в раскладке SoA (отдельно re и im)
+ *
+ * Действительные и мнимые части хранятся в двух непрерывных массивах,
+ * поэтому поэлементные операции сводятся к простым циклам без
+ * перемешивания компонент. Умножение, деление и модуль обрабатывают
+ * по Simd::WIDTH элементов векторными командами (см. Simd.h), хвост
+ * массива - скалярным циклом.
+ *
+ * Пакетные операции не бросают исключений на данных: внутренние циклы
+ * не содержат ветвлений, а о проблемах сообщают флаги ошибок
+ * (см. ErrorFlags), возвращаемые каждой операцией. Флаги объединяются
+ * побитовым ИЛИ, так что цепочку операций можно проверить один раз.
+ */
+class ComplexArray {
+public:
+    /**
+     * @brief Флаги ошибок пакетных операций
+     */
+    enum ErrorFlags {
+        OK = 0,                ///< Ошибок нет
+        SIZE_MISMATCH = 1,     ///< Длины операндов различаются, результат не вычислен
+        DIVISION_BY_ZERO = 2   ///< Деление на ноль, такие элементы результата равны NaN
+    };
+
+private:
+    std::vector<double> real_;  ///< Действительные части
+    std::vector<double> imag_;  ///< Мнимые части
+
+    /**
+     * @brief Целая степень по модулю показателя и его знаку
+     */
+    unsigned integerPower(unsigned long long exponent, bool negative, ComplexArray& result) const;
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустой массив
+     */
+    ComplexArray();
+
+    /**
+     * @brief Создать массив заданной длины, заполненный нулями
+     * @param size Длина массива
+     */
+    explicit ComplexArray(size_t size);
+
+    /**
+     * @brief Создать массив из вектора комплексных чисел
+     * @param values Исходные значения
+     */
+    explicit ComplexArray(const std::vector<Complex>& values);
+
+    /**
+     * @brief Создать массив из раздельных частей
+     * @param real Действительные части
+     * @param imag Мнимые части
+     * @throw std::invalid_argument если длины частей различаются
+     */
+    ComplexArray(const std::vector<double>& real, const std::vector<double>& imag);
+
+    // Методы доступа
+    /**
+     * @brief Получить длину массива
+     * @return Количество элементов
+     */
+    size_t size() const;
+
+    /**
+     * @brief Изменить длину массива (новые элементы равны нулю)
+     * @param size Новая длина
+     */
+    void resize(size_t size);
+
+    /**
+     * @brief Получить элемент
+     * @param index Индекс
+     * @return Комплексное число
+     * @throw std::out_of_range если индекс вне границ
+     */
+    Complex get(size_t index) const;
+
+    /**
+     * @brief Установить элемент
+     * @param index Индекс
+     * @param value Новое значение
+     * @throw std::out_of_range если индекс вне границ
+     */
+    void set(size_t index, const Complex& value);
+
+    /**
+     * @brief Указатель на действительные части
+     * @return Указатель на size() чисел (нулевой для пустого массива)
+     */
+    double* realData();
+    const double* realData() const;
+
+    /**
+     * @brief Указатель на мнимые части
+     * @return Указатель на size() чисел (нулевой для пустого массива)
+     */
+    double* imagData();
+    const double* imagData() const;
+
+    /**
+     * @brief Преобразовать в вектор комплексных чисел
+     * @return Вектор значений
+     */
+    std::vector<Complex> toVector() const;
+
+    // Пакетные операции
+    /**
+     * @brief Поэлементное произведение
+     * @param other Второй операнд
+     * @param result Результат (размер устанавливается, может совпадать с операндами)
+     * @return Флаги ошибок
+     */
+    unsigned multiply(const ComplexArray& other, ComplexArray& result) const;
+
+    /**
+     * @brief Поэлементное произведение на сопряженный второй операнд: a * conj(b)
+     * @param other Второй операнд
+     * @param result Результат (размер устанавливается, может совпадать с операндами)
+     * @return Флаги ошибок
+     */
+    unsigned multiplyConjugate(const ComplexArray& other, ComplexArray& result) const;
+
+    /**
+     * @brief Поэлементное деление
+     * @param other Делитель
+     * @param result Результат (размер устанавливается, может совпадать с операндами)
+     * @return Флаги ошибок; при делении на ноль элемент результата равен (NaN, NaN)
+     *
+     * Делением на ноль считается только |b|^2, равный нулю или не конечный
+     * (в том числе после переполнения или исчезновения порядка); малые, но
+     * ненулевые делители делятся, в отличие от Complex::operator/.
+     */
+    unsigned divide(const ComplexArray& other, ComplexArray& result) const;
+
+    /**
+     * @brief Модули элементов
+     * @param result Результат (размер устанавливается)
+     * @return Флаги ошибок
+     */
+    unsigned magnitude(std::vector<double>& result) const;
+
+    /**
+     * @brief Аргументы элементов
+     * @param result Результат в радианах (размер устанавливается)
+     * @return Флаги ошибок
+     */
+    unsigned argument(std::vector<double>& result) const;
+
+    /**
+     * @brief Перевести в полярную форму
+     * @param magnitudes Модули (размер устанавливается)
+     * @param angles Аргументы в радианах (размер устанавливается)
+     * @return Флаги ошибок
+     */
+    unsigned toPolar(std::vector<double>& magnitudes, std::vector<double>& angles) const;
+
+    /**
+     * @brief Возвести все элементы в целую степень
+     * @param power Показатель степени любого целого типа
+     * @param result Результат (размер устанавливается, может совпадать с this)
+     * @return Флаги ошибок; ноль в отрицательной степени дает DIVISION_BY_ZERO и (NaN, NaN)
+     *
+     * Показатель общий для всех элементов, поэтому ветвления по его битам
+     * одинаковы для всех элементов и вынесены из внутреннего цикла.
+     * Как и у Complex::power, шаблон исключает неоднозначность с
+     * power(double) для аргументов unsigned, long и size_t.
+     */
+    template <typename Integer>
+    typename std::enable_if<std::is_integral<Integer>::value, unsigned>::type
+    power(Integer power, ComplexArray& result) const {
+        const bool negative = power < static_cast<Integer>(0);
+        const unsigned long long magnitude = static_cast<unsigned long long>(power);
+        return integerPower(negative ? 0ull - magnitude : magnitude, negative, result);
+    }
+
+    /**
+     * @brief Возвести все элементы в вещественную степень (главное значение)
+     * @param power Показатель степени
+     * @param result Результат (размер устанавливается, может совпадать с this)
+     * @return Флаги ошибок
+     *
+     * Синус и косинус одного угла вычисляются в одном цикле, что позволяет
+     * компилятору объединить их в один вызов sincos.
+     */
+    unsigned power(double power, ComplexArray& result) const;
+
+    /**
+     * @brief Главные значения квадратных корней
+     * @param result Результат (размер устанавливается, может совпадать с this)
+     * @return Флаги ошибок
+     */
+    unsigned sqrt(ComplexArray& result) const;
+
+    // Статические методы
+    /**
+     * @brief Построить массив из полярной формы
+     * @param magnitudes Модули
+     * @param angles Аргументы в радианах
+     * @param result Результат (размер устанавливается)
+     * @return Флаги ошибок
+     */
+    static unsigned fromPolar(const std::vector<double>& magnitudes, const std::vector<double>& angles,
+                              ComplexArray& result);
+};
+
+#endif // COMPLEXARRAY_H
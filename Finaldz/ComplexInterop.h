@@ -0,0 +1,157 @@
+/**
+ * @file ComplexInterop.h
+ * @brief Совместимость Complex и std::complex<double> без копирования
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef COMPLEXINTEROP_H
+#define COMPLEXINTEROP_H
+
+#include <complex>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include "Complex.h"
+
+// Complex и std::complex<double> - это пара double (re, im) без заполнения,
+// поэтому массивы одного типа можно рассматривать как массивы другого
+static_assert(sizeof(Complex) == 2 * sizeof(double), "Complex должен состоять ровно из двух double");
+static_assert(sizeof(Complex) == sizeof(std::complex<double>), "Размеры Complex и std::complex<double> различаются");
+static_assert(alignof(Complex) == alignof(std::complex<double>), "Выравнивание Complex и std::complex<double> различается");
+static_assert(std::is_standard_layout<Complex>::value, "Complex должен иметь стандартную раскладку");
+static_assert(std::is_trivially_copyable<Complex>::value, "Complex должен копироваться побайтно");
+
+/**
+ * @class ArrayView
+ * @brief Невладеющее представление непрерывного массива (аналог std::span)
+ * @tparam T Тип элементов (может быть const)
+ */
+template <typename T>
+class ArrayView {
+private:
+    T* data_;       ///< Начало массива
+    size_t size_;   ///< Количество элементов
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустое представление
+     */
+    constexpr ArrayView() : data_(nullptr), size_(0) {}
+
+    /**
+     * @brief Конструктор из указателя и длины
+     * @param data Начало массива
+     * @param size Количество элементов
+     */
+    constexpr ArrayView(T* data, size_t size) : data_(data), size_(size) {}
+
+    // Методы доступа
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+
+    /**
+     * @brief Доступ к элементу без проверки границ
+     * @param index Индекс
+     * @return Ссылка на элемент
+     */
+    constexpr T& operator[](size_t index) const { return data_[index]; }
+};
+
+/**
+ * @class ComplexInterop
+ * @brief Преобразования между Complex и std::complex<double>
+ *
+ * Одиночные значения преобразуются constexpr-функциями. Массивы не
+ * копируются: возвращается представление той же памяти с другим типом
+ * элементов, что допустимо благодаря проверенной выше совместимости
+ * раскладок. Представления не владеют памятью и действительны, пока
+ * жив исходный буфер (для std::vector - до изменения его размера).
+ */
+class ComplexInterop {
+public:
+    // Одиночные значения
+    /**
+     * @brief Преобразовать в std::complex<double>
+     * @param value Комплексное число
+     * @return То же число
+     */
+    static constexpr std::complex<double> toStd(const Complex& value) {
+        return std::complex<double>(value.getReal(), value.getImag());
+    }
+
+    /**
+     * @brief Преобразовать из std::complex<double>
+     * @param value Комплексное число
+     * @return То же число
+     */
+    static constexpr Complex fromStd(const std::complex<double>& value) {
+        return Complex(value.real(), value.imag());
+    }
+
+    // Представления массивов
+    /**
+     * @brief Представить массив Complex как массив std::complex<double>
+     * @param data Начало массива
+     * @param size Количество элементов
+     * @return Представление той же памяти
+     */
+    static ArrayView<std::complex<double> > asStd(Complex* data, size_t size) {
+        return ArrayView<std::complex<double> >(reinterpret_cast<std::complex<double>*>(data), size);
+    }
+
+    static ArrayView<const std::complex<double> > asStd(const Complex* data, size_t size) {
+        return ArrayView<const std::complex<double> >(reinterpret_cast<const std::complex<double>*>(data), size);
+    }
+
+    static ArrayView<std::complex<double> > asStd(std::vector<Complex>& values) {
+        return asStd(values.empty() ? nullptr : &values[0], values.size());
+    }
+
+    static ArrayView<const std::complex<double> > asStd(const std::vector<Complex>& values) {
+        return asStd(values.empty() ? nullptr : &values[0], values.size());
+    }
+
+    /**
+     * @brief Представить массив std::complex<double> как массив Complex
+     * @param data Начало массива
+     * @param size Количество элементов
+     * @return Представление той же памяти
+     */
+    static ArrayView<Complex> asComplex(std::complex<double>* data, size_t size) {
+        return ArrayView<Complex>(reinterpret_cast<Complex*>(data), size);
+    }
+
+    static ArrayView<const Complex> asComplex(const std::complex<double>* data, size_t size) {
+        return ArrayView<const Complex>(reinterpret_cast<const Complex*>(data), size);
+    }
+
+    static ArrayView<Complex> asComplex(std::vector<std::complex<double> >& values) {
+        return asComplex(values.empty() ? nullptr : &values[0], values.size());
+    }
+
+    static ArrayView<const Complex> asComplex(const std::vector<std::complex<double> >& values) {
+        return asComplex(values.empty() ? nullptr : &values[0], values.size());
+    }
+
+    /**
+     * @brief Представить массив Complex как чередующийся массив double (re, im)
+     * @param values Массив комплексных чисел
+     * @return Представление из 2 * size() чисел, например для FFTPlan::execute
+     */
+    static ArrayView<double> asInterleaved(std::vector<Complex>& values) {
+        return ArrayView<double>(values.empty() ? nullptr : reinterpret_cast<double*>(&values[0]),
+                                 2 * values.size());
+    }
+
+    static ArrayView<const double> asInterleaved(const std::vector<Complex>& values) {
+        return ArrayView<const double>(values.empty() ? nullptr : reinterpret_cast<const double*>(&values[0]),
+                                       2 * values.size());
+    }
+};
+
+#endif // COMPLEXINTEROP_H
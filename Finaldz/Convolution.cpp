@@ -0,0 +1,387 @@
+/**
+ * @file Convolution.cpp
+ * @brief Реализация свертки и корреляции
+ */
+
+#include "Convolution.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double FFT_COST = 2.5;        ///< Операций на отсчет и уровень БПФ относительно умножения-сложения
+const size_t BLOCKS_PER_TASK = 4;   ///< Блоков overlap-save в одной параллельной задаче
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+/**
+ * @brief Стоимость блочной свертки с БПФ размера fftSize
+ */
+double blockCost(size_t fftSize, size_t kernelSize, size_t outputSize) {
+    const size_t step = fftSize - kernelSize + 1;
+    const double blocks = static_cast<double>((outputSize + step - 1) / step);
+    const double n = static_cast<double>(fftSize);
+    return blocks * (FFT_COST * n * std::log2(n) + 3.0 * n);
+}
+
+/**
+ * @brief Подобрать размер БПФ с наименьшей стоимостью
+ * @param kernelSize Длина фильтра
+ * @param outputSize Длина результата (0 - неограниченный поток)
+ */
+size_t chooseFFTSize(size_t kernelSize, size_t outputSize, double& cost) {
+    size_t best = nextPowerOfTwo(2 * kernelSize);
+    // Для потока сравнивается стоимость на отсчет: берем условную длину
+    const size_t length = outputSize != 0 ? outputSize : 1024 * best;
+    const size_t limit = std::max(best, nextPowerOfTwo(length));
+    cost = blockCost(best, kernelSize, length);
+    for (size_t size = best * 2; size <= limit; size *= 2) {
+        double current = blockCost(size, kernelSize, length);
+        if (current < cost) {
+            cost = current;
+            best = size;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Фильтр вещественного сигнала: умножение спектра блока на спектр ядра
+ */
+class RealBlockFilter {
+private:
+    size_t size_;
+    std::shared_ptr<const RealFFTPlan> plan_;
+    std::vector<double> kernelSpectrum_;
+
+public:
+    static const size_t WIDTH = 1;  ///< Чисел double на отсчет
+
+    RealBlockFilter(const double* kernel, size_t kernelSize, size_t fftSize)
+        : size_(fftSize), plan_(RealFFTPlan::get(fftSize)), kernelSpectrum_(2 * (fftSize / 2 + 1)) {
+        std::vector<double> padded(fftSize, 0.0);
+        std::copy(kernel, kernel + kernelSize, padded.begin());
+        plan_->forward(&padded[0], &kernelSpectrum_[0]);
+    }
+
+    size_t size() const { return size_; }
+    size_t workSize() const { return kernelSpectrum_.size(); }
+
+    void run(double* data, double* work) const {
+        plan_->forward(data, work);
+        const double* h = &kernelSpectrum_[0];
+        for (size_t k = 0; k < kernelSpectrum_.size(); k += 2) {
+            const double xr = work[k], xi = work[k + 1];
+            work[k] = xr * h[k] - xi * h[k + 1];
+            work[k + 1] = xr * h[k + 1] + xi * h[k];
+        }
+        plan_->inverse(work, data);
+    }
+};
+
+/**
+ * @brief Фильтр комплексного сигнала в чередующемся формате (re, im)
+ */
+class ComplexBlockFilter {
+private:
+    size_t size_;
+    std::shared_ptr<const FFTPlan> plan_;
+    std::vector<double> kernelSpectrum_;
+
+public:
+    static const size_t WIDTH = 2;
+
+    ComplexBlockFilter(const double* kernel, size_t kernelSize, size_t fftSize)
+        : size_(fftSize), plan_(FFTPlan::get(fftSize)), kernelSpectrum_(2 * fftSize, 0.0) {
+        std::copy(kernel, kernel + 2 * kernelSize, kernelSpectrum_.begin());
+        // Нормировка обратного преобразования переносится в спектр ядра
+        const double scale = 1.0 / static_cast<double>(fftSize);
+        for (size_t k = 0; k < kernelSpectrum_.size(); ++k) kernelSpectrum_[k] *= scale;
+        plan_->execute(&kernelSpectrum_[0], &kernelSpectrum_[0], false);
+    }
+
+    size_t size() const { return size_; }
+    size_t workSize() const { return 0; }
+
+    void run(double* data, double*) const {
+        plan_->execute(data, data, false);
+        const double* h = &kernelSpectrum_[0];
+        for (size_t k = 0; k < kernelSpectrum_.size(); k += 2) {
+            const double xr = data[k], xi = data[k + 1];
+            data[k] = xr * h[k] - xi * h[k + 1];
+            data[k + 1] = xr * h[k + 1] + xi * h[k];
+        }
+        plan_->execute(data, data, true);
+    }
+};
+
+/**
+ * @brief Overlap-save: каждый блок дает step готовых отсчетов результата
+ */
+template <typename Filter>
+void overlapSave(const double* x, size_t n, size_t m, const Filter& filter, double* y) {
+    const size_t W = Filter::WIDTH;
+    const size_t fftSize = filter.size();
+    const size_t step = fftSize - m + 1;
+    const size_t total = n + m - 1;
+    const size_t blocks = Parallel::blockCount(total, step);
+
+    Parallel::forEachBlock(blocks, BLOCKS_PER_TASK, [&](size_t, size_t first, size_t last) {
+        std::vector<double> buffer(W * fftSize);
+        std::vector<double> work(filter.workSize() + 1);
+        for (size_t b = first; b < last; ++b) {
+            // Вход блока начинается на m - 1 отсчетов раньше его выхода
+            const size_t outBegin = b * step;
+            for (size_t t = 0; t < fftSize; ++t) {
+                const size_t pos = outBegin + t;
+                const bool inside = pos >= m - 1 && pos - (m - 1) < n;
+                for (size_t c = 0; c < W; ++c) {
+                    buffer[W * t + c] = inside ? x[W * (pos - (m - 1)) + c] : 0.0;
+                }
+            }
+            filter.run(&buffer[0], &work[0]);
+            const size_t count = std::min(step, total - outBegin);
+            std::copy(buffer.begin() + W * (m - 1), buffer.begin() + W * (m - 1 + count), y + W * outBegin);
+        }
+    });
+}
+
+/**
+ * @brief Overlap-add: блоки входа длины step, хвосты складываются
+ */
+template <typename Filter>
+void overlapAdd(const double* x, size_t n, size_t m, const Filter& filter, double* y) {
+    const size_t W = Filter::WIDTH;
+    const size_t fftSize = filter.size();
+    const size_t step = fftSize - m + 1;
+    const size_t total = n + m - 1;
+    std::vector<double> buffer(W * fftSize);
+    std::vector<double> work(filter.workSize() + 1);
+
+    std::fill(y, y + W * total, 0.0);
+    for (size_t begin = 0; begin < n; begin += step) {
+        const size_t count = std::min(step, n - begin);
+        std::fill(buffer.begin(), buffer.end(), 0.0);
+        std::copy(x + W * begin, x + W * (begin + count), buffer.begin());
+        filter.run(&buffer[0], &work[0]);
+        const size_t produced = std::min(fftSize, total - begin);
+        for (size_t t = 0; t < W * produced; ++t) {
+            y[W * begin + t] += buffer[t];
+        }
+    }
+}
+
+void directReal(const double* x, size_t n, const double* h, size_t m, double* y) {
+    for (size_t k = 0; k < n + m - 1; ++k) {
+        const size_t jBegin = k >= n ? k - n + 1 : 0;
+        const size_t jEnd = std::min(k + 1, m);
+        double sum = 0.0;
+        for (size_t j = jBegin; j < jEnd; ++j) {
+            sum += h[j] * x[k - j];
+        }
+        y[k] = sum;
+    }
+}
+
+void directComplex(const double* x, size_t n, const double* h, size_t m, double* y) {
+    for (size_t k = 0; k < n + m - 1; ++k) {
+        const size_t jBegin = k >= n ? k - n + 1 : 0;
+        const size_t jEnd = std::min(k + 1, m);
+        double sr = 0.0, si = 0.0;
+        for (size_t j = jBegin; j < jEnd; ++j) {
+            const double hr = h[2 * j], hi = h[2 * j + 1];
+            const double xr = x[2 * (k - j)], xi = x[2 * (k - j) + 1];
+            sr += hr * xr - hi * xi;
+            si += hr * xi + hi * xr;
+        }
+        y[2 * k] = sr;
+        y[2 * k + 1] = si;
+    }
+}
+
+/**
+ * @brief Общая часть свертки для вещественных и комплексных данных
+ */
+template <typename Filter, typename Direct>
+void convolveData(const double* x, size_t n, const double* h, size_t m, double* y,
+                  Convolution::Method method, Direct direct) {
+    // Свертка коммутативна: фильтром делаем более короткий операнд
+    if (m > n) {
+        std::swap(x, h);
+        std::swap(n, m);
+    }
+    if (method == Convolution::AUTO) {
+        method = Convolution::chooseMethod(n, m);
+    }
+    if (method == Convolution::DIRECT) {
+        direct(x, n, h, m, y);
+        return;
+    }
+
+    double cost;
+    Filter filter(h, m, chooseFFTSize(m, n + m - 1, cost));
+    if (method == Convolution::OVERLAP_ADD) {
+        overlapAdd(x, n, m, filter, y);
+    } else {
+        overlapSave(x, n, m, filter, y);
+    }
+}
+
+std::vector<double> toInterleaved(const std::vector<Complex>& values, bool conjugateReversed) {
+    const size_t n = values.size();
+    std::vector<double> result(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+        const Complex& value = conjugateReversed ? values[n - 1 - i] : values[i];
+        result[2 * i] = value.getReal();
+        result[2 * i + 1] = conjugateReversed ? -value.getImag() : value.getImag();
+    }
+    return result;
+}
+
+std::vector<Complex> convolveComplex(const std::vector<double>& x, size_t n, const std::vector<double>& h,
+                                     size_t m, Convolution::Method method) {
+    std::vector<double> y(2 * (n + m - 1));
+    convolveData<ComplexBlockFilter>(&x[0], n, &h[0], m, &y[0], method, directComplex);
+    std::vector<Complex> result;
+    result.reserve(n + m - 1);
+    for (size_t k = 0; k < n + m - 1; ++k) {
+        result.push_back(Complex(y[2 * k], y[2 * k + 1]));
+    }
+    return result;
+}
+
+} // namespace
+
+// Convolution
+Convolution::Method Convolution::chooseMethod(size_t signalSize, size_t kernelSize) {
+    const size_t n = std::max(signalSize, kernelSize);
+    const size_t m = std::min(signalSize, kernelSize);
+    if (m == 0) return DIRECT;
+
+    double cost;
+    const size_t total = n + m - 1;
+    const size_t fftSize = chooseFFTSize(m, total, cost);
+    if (static_cast<double>(n) * static_cast<double>(m) <= cost) {
+        return DIRECT;
+    }
+    return fftSize - m + 1 >= total ? OVERLAP_ADD : OVERLAP_SAVE;
+}
+
+std::vector<double> Convolution::convolve(const std::vector<double>& signal, const std::vector<double>& kernel,
+                                          Method method) {
+    if (signal.empty() || kernel.empty()) return std::vector<double>();
+    std::vector<double> result(signal.size() + kernel.size() - 1);
+    convolveData<RealBlockFilter>(&signal[0], signal.size(), &kernel[0], kernel.size(), &result[0],
+                                  method, directReal);
+    return result;
+}
+
+std::vector<Complex> Convolution::convolve(const std::vector<Complex>& signal, const std::vector<Complex>& kernel,
+                                           Method method) {
+    if (signal.empty() || kernel.empty()) return std::vector<Complex>();
+    return convolveComplex(toInterleaved(signal, false), signal.size(),
+                           toInterleaved(kernel, false), kernel.size(), method);
+}
+
+std::vector<double> Convolution::correlate(const std::vector<double>& signal, const std::vector<double>& kernel,
+                                           Method method) {
+    std::vector<double> reversed(kernel.rbegin(), kernel.rend());
+    return convolve(signal, reversed, method);
+}
+
+std::vector<Complex> Convolution::correlate(const std::vector<Complex>& signal, const std::vector<Complex>& kernel,
+                                            Method method) {
+    if (signal.empty() || kernel.empty()) return std::vector<Complex>();
+    return convolveComplex(toInterleaved(signal, false), signal.size(),
+                           toInterleaved(kernel, true), kernel.size(), method);
+}
+
+// StreamingConvolver
+StreamingConvolver::StreamingConvolver(const std::vector<double>& kernel, size_t blockSize)
+    : kernelSize_(kernel.size()), filled_(0) {
+    if (kernel.empty()) {
+        throw std::invalid_argument("Фильтр не может быть пустым");
+    }
+    if (blockSize == 0) {
+        double cost;
+        fftSize_ = chooseFFTSize(kernelSize_, 0, cost);
+    } else {
+        fftSize_ = std::max<size_t>(2, nextPowerOfTwo(blockSize + kernelSize_ - 1));
+    }
+    step_ = fftSize_ - kernelSize_ + 1;
+    plan_ = RealFFTPlan::get(fftSize_);
+
+    kernelSpectrum_.resize(2 * (fftSize_ / 2 + 1));
+    std::vector<double> padded(fftSize_, 0.0);
+    std::copy(kernel.begin(), kernel.end(), padded.begin());
+    plan_->forward(&padded[0], &kernelSpectrum_[0]);
+
+    buffer_.assign(fftSize_, 0.0);
+    spectrum_.resize(kernelSpectrum_.size());
+    result_.resize(fftSize_);
+}
+
+size_t StreamingConvolver::blockSize() const {
+    return step_;
+}
+
+void StreamingConvolver::processBlock(size_t emit, std::vector<double>& output) {
+    const size_t history = kernelSize_ - 1;
+    std::fill(buffer_.begin() + history + filled_, buffer_.end(), 0.0);
+
+    plan_->forward(&buffer_[0], &spectrum_[0]);
+    const double* h = &kernelSpectrum_[0];
+    for (size_t k = 0; k < spectrum_.size(); k += 2) {
+        const double xr = spectrum_[k], xi = spectrum_[k + 1];
+        spectrum_[k] = xr * h[k] - xi * h[k + 1];
+        spectrum_[k + 1] = xr * h[k + 1] + xi * h[k];
+    }
+    plan_->inverse(&spectrum_[0], &result_[0]);
+    output.insert(output.end(), result_.begin() + history, result_.begin() + history + emit);
+
+    // Последние m - 1 отсчетов входа становятся историей следующего блока
+    std::copy(buffer_.begin() + step_, buffer_.begin() + step_ + history, buffer_.begin());
+    filled_ = 0;
+}
+
+void StreamingConvolver::process(const double* input, size_t count, std::vector<double>& output) {
+    const size_t history = kernelSize_ - 1;
+    while (count > 0) {
+        const size_t take = std::min(count, step_ - filled_);
+        std::copy(input, input + take, buffer_.begin() + history + filled_);
+        filled_ += take;
+        input += take;
+        count -= take;
+        if (filled_ == step_) {
+            processBlock(step_, output);
+        }
+    }
+}
+
+void StreamingConvolver::process(const std::vector<double>& input, std::vector<double>& output) {
+    if (!input.empty()) {
+        process(&input[0], input.size(), output);
+    }
+}
+
+void StreamingConvolver::flush(std::vector<double>& output) {
+    // Недостающий вход дополняется нулями, пока не выдан хвост фильтра
+    size_t remaining = filled_ + kernelSize_ - 1;
+    while (remaining > 0) {
+        const size_t emit = std::min(step_, remaining);
+        processBlock(emit, output);
+        remaining -= emit;
+    }
+    reset();
+}
+
+void StreamingConvolver::reset() {
+    std::fill(buffer_.begin(), buffer_.end(), 0.0);
+    filled_ = 0;
+}
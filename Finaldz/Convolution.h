@@ -0,0 +1,158 @@
+/**
+ * @file Convolution.h
+ * @brief Линейная свертка и взаимная корреляция с выбором алгоритма
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef CONVOLUTION_H
+#define CONVOLUTION_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "Complex.h"
+#include "FFT.h"
+
+/**
+ * @class Convolution
+ * @brief Свертка и корреляция последовательностей double и Complex
+ *
+ * Короткие фильтры сворачиваются прямым суммированием. Для длинных
+ * используется блочная свертка через БПФ: перекрытие со сложением
+ * (overlap-add) или перекрытие с отбрасыванием (overlap-save). Размер
+ * БПФ подбирается по простой модели стоимости, которая сравнивает
+ * n * m умножений прямого метода с числом операций блочных БПФ.
+ * Блоки overlap-save записывают непересекающиеся части результата
+ * и обрабатываются параллельно.
+ */
+class Convolution {
+public:
+    /**
+     * @brief Алгоритм вычисления свертки
+     */
+    enum Method {
+        AUTO,          ///< Выбрать по длинам операндов
+        DIRECT,        ///< Прямое суммирование, O(n * m)
+        OVERLAP_ADD,   ///< БПФ блоков входа, сложение перекрывающихся хвостов
+        OVERLAP_SAVE   ///< БПФ перекрывающихся блоков, отбрасывание краев
+    };
+
+    /**
+     * @brief Выбрать алгоритм для заданных длин
+     * @param signalSize Длина сигнала
+     * @param kernelSize Длина фильтра
+     * @return DIRECT, OVERLAP_ADD (один блок покрывает весь сигнал) или OVERLAP_SAVE
+     */
+    static Method chooseMethod(size_t signalSize, size_t kernelSize);
+
+    /**
+     * @brief Линейная свертка
+     * @param signal Сигнал длины n
+     * @param kernel Фильтр длины m
+     * @param method Алгоритм
+     * @return Результат длины n + m - 1 (пустой, если операнд пуст)
+     */
+    static std::vector<double> convolve(const std::vector<double>& signal, const std::vector<double>& kernel,
+                                        Method method = AUTO);
+
+    /**
+     * @brief Линейная свертка комплексных последовательностей
+     * @param signal Сигнал длины n
+     * @param kernel Фильтр длины m
+     * @param method Алгоритм
+     * @return Результат длины n + m - 1 (пустой, если операнд пуст)
+     */
+    static std::vector<Complex> convolve(const std::vector<Complex>& signal, const std::vector<Complex>& kernel,
+                                         Method method = AUTO);
+
+    /**
+     * @brief Взаимная корреляция
+     * @param signal Сигнал x длины n
+     * @param kernel Шаблон h длины m
+     * @param method Алгоритм
+     * @return Результат длины n + m - 1: r[k] = sum x[i + k - (m - 1)] * h[i]
+     */
+    static std::vector<double> correlate(const std::vector<double>& signal, const std::vector<double>& kernel,
+                                         Method method = AUTO);
+
+    /**
+     * @brief Взаимная корреляция комплексных последовательностей
+     * @param signal Сигнал x длины n
+     * @param kernel Шаблон h длины m
+     * @param method Алгоритм
+     * @return Результат длины n + m - 1: r[k] = sum x[i + k - (m - 1)] * conj(h[i])
+     */
+    static std::vector<Complex> correlate(const std::vector<Complex>& signal, const std::vector<Complex>& kernel,
+                                          Method method = AUTO);
+};
+
+/**
+ * @class StreamingConvolver
+ * @brief Потоковая свертка длинного сигнала с фиксированным фильтром
+ *
+ * Сигнал подается блоками произвольной длины; выход вычисляется методом
+ * overlap-save и выдается порциями по мере накопления входа. Память
+ * ограничена одним буфером размера БПФ независимо от длины сигнала.
+ * Объединение всех выходов process() и flush() совпадает с результатом
+ * Convolution::convolve() для всего сигнала.
+ */
+class StreamingConvolver {
+private:
+    size_t kernelSize_;                             ///< Длина фильтра m
+    size_t fftSize_;                                ///< Размер БПФ N
+    size_t step_;                                   ///< Новых отсчетов на блок: N - m + 1
+    std::shared_ptr<const RealFFTPlan> plan_;       ///< План БПФ размера N
+    std::vector<double> kernelSpectrum_;            ///< Спектр фильтра
+    std::vector<double> buffer_;                    ///< m - 1 предыдущих отсчетов и новые
+    std::vector<double> spectrum_;                  ///< Рабочий буфер спектра
+    std::vector<double> result_;                    ///< Рабочий буфер выхода блока
+    size_t filled_;                                 ///< Новых отсчетов в буфере
+
+    void processBlock(size_t emit, std::vector<double>& output);
+
+public:
+    /**
+     * @brief Создать потоковый свертыватель
+     * @param kernel Фильтр
+     * @param blockSize Желаемое число новых отсчетов на блок (0 - подобрать автоматически)
+     * @throw std::invalid_argument если фильтр пуст
+     */
+    explicit StreamingConvolver(const std::vector<double>& kernel, size_t blockSize = 0);
+
+    /**
+     * @brief Получить размер блока входа
+     * @return Количество отсчетов, после накопления которых выдается выход
+     */
+    size_t blockSize() const;
+
+    /**
+     * @brief Обработать очередную порцию сигнала
+     * @param input Отсчеты сигнала
+     * @param count Количество отсчетов
+     * @param output Вектор, в конец которого дописывается готовый выход
+     */
+    void process(const double* input, size_t count, std::vector<double>& output);
+
+    /**
+     * @brief Обработать очередную порцию сигнала
+     * @param input Отсчеты сигнала
+     * @param output Вектор, в конец которого дописывается готовый выход
+     */
+    void process(const std::vector<double>& input, std::vector<double>& output);
+
+    /**
+     * @brief Завершить сигнал: выдать оставшийся выход и хвост длины m - 1
+     * @param output Вектор, в конец которого дописывается выход
+     *
+     * После вызова свертыватель готов к обработке нового сигнала.
+     */
+    void flush(std::vector<double>& output);
+
+    /**
+     * @brief Сбросить состояние без выдачи выхода
+     */
+    void reset();
+};
+
+#endif // CONVOLUTION_H
@@ -0,0 +1,496 @@
+/**
+ * @file FFT.cpp
+ * @brief Реализация быстрого преобразования Фурье
+ */
+
+#include "FFT.h"
+#include <stdexcept>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <algorithm>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const size_t MAX_RADIX = 61;  ///< Наибольший простой множитель без Блюстейна
+
+std::mutex g_planMutex;
+std::map<size_t, std::shared_ptr<const FFTPlan> > g_plans;
+std::map<size_t, std::shared_ptr<const RealFFTPlan> > g_realPlans;
+
+/**
+ * @brief Найти или создать план в кэше
+ *
+ * План создается без удержания блокировки: конструктор Блюстейна сам
+ * обращается к кэшу за планом степени двойки.
+ */
+template <typename Plan>
+std::shared_ptr<const Plan> cachedPlan(std::map<size_t, std::shared_ptr<const Plan> >& cache, size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(g_planMutex);
+        auto it = cache.find(size);
+        if (it != cache.end()) return it->second;
+    }
+    std::shared_ptr<const Plan> plan = std::make_shared<Plan>(size);
+    std::lock_guard<std::mutex> lock(g_planMutex);
+    auto inserted = cache.insert(std::make_pair(size, plan));
+    return inserted.first->second;
+}
+
+inline void cmul(double ar, double ai, double br, double bi, double& r, double& i) {
+    r = ar * br - ai * bi;
+    i = ar * bi + ai * br;
+}
+
+/**
+ * @brief Бабочка произвольного основания (прямое преобразование)
+ * @param v Данные (re, im), radix элементов, результат на месте
+ * @param roots exp(-2*pi*i*k/radix), radix элементов
+ */
+void genericButterfly(double* v, size_t radix, const double* roots) {
+    double out[2 * MAX_RADIX];
+    for (size_t k = 0; k < radix; ++k) {
+        double sr = 0.0, si = 0.0;
+        for (size_t r = 0, idx = 0; r < radix; ++r, idx = (idx + k) % radix) {
+            double pr, pi;
+            cmul(v[2 * r], v[2 * r + 1], roots[2 * idx], roots[2 * idx + 1], pr, pi);
+            sr += pr;
+            si += pi;
+        }
+        out[2 * k] = sr;
+        out[2 * k + 1] = si;
+    }
+    std::copy(out, out + 2 * radix, v);
+}
+
+void butterfly(double* v, size_t radix, const double* roots) {
+    switch (radix) {
+    case 2: {
+        double r0 = v[0], i0 = v[1];
+        v[0] = r0 + v[2]; v[1] = i0 + v[3];
+        v[2] = r0 - v[2]; v[3] = i0 - v[3];
+        break;
+    }
+    case 3: {
+        const double c = -0.5;
+        const double s = -0.86602540378443864676;
+        double tr = v[2] + v[4], ti = v[3] + v[5];
+        double dr = v[2] - v[4], di = v[3] - v[5];
+        double mr = v[0] + c * tr, mi = v[1] + c * ti;
+        v[0] += tr; v[1] += ti;
+        // X1 = m + i*s*d, X2 = m - i*s*d
+        v[2] = mr - s * di; v[3] = mi + s * dr;
+        v[4] = mr + s * di; v[5] = mi - s * dr;
+        break;
+    }
+    case 4: {
+        double a0r = v[0] + v[4], a0i = v[1] + v[5];
+        double a1r = v[0] - v[4], a1i = v[1] - v[5];
+        double a2r = v[2] + v[6], a2i = v[3] + v[7];
+        // (v1 - v3) * (-i)
+        double a3r = v[3] - v[7], a3i = v[6] - v[2];
+        v[0] = a0r + a2r; v[1] = a0i + a2i;
+        v[2] = a1r + a3r; v[3] = a1i + a3i;
+        v[4] = a0r - a2r; v[5] = a0i - a2i;
+        v[6] = a1r - a3r; v[7] = a1i - a3i;
+        break;
+    }
+    case 5: {
+        const double c1 = 0.30901699437494742410;   // cos(2pi/5)
+        const double c2 = -0.80901699437494742410;  // cos(4pi/5)
+        const double s1 = -0.95105651629515357212;  // -sin(2pi/5)
+        const double s2 = -0.58778525229247312917;  // -sin(4pi/5)
+        double p1r = v[2] + v[8], p1i = v[3] + v[9];
+        double m1r = v[2] - v[8], m1i = v[3] - v[9];
+        double p2r = v[4] + v[6], p2i = v[5] + v[7];
+        double m2r = v[4] - v[6], m2i = v[5] - v[7];
+        double ar = v[0] + c1 * p1r + c2 * p2r, ai = v[1] + c1 * p1i + c2 * p2i;
+        double br = v[0] + c2 * p1r + c1 * p2r, bi = v[1] + c2 * p1i + c1 * p2i;
+        // Мнимые добавки: i * (s1*m1 + s2*m2) и i * (s2*m1 - s1*m2)
+        double er = s1 * m1r + s2 * m2r, ei = s1 * m1i + s2 * m2i;
+        double fr = s2 * m1r - s1 * m2r, fi = s2 * m1i - s1 * m2i;
+        v[0] += p1r + p2r; v[1] += p1i + p2i;
+        v[2] = ar - ei; v[3] = ai + er;
+        v[8] = ar + ei; v[9] = ai - er;
+        v[4] = br - fi; v[5] = bi + fr;
+        v[6] = br + fi; v[7] = bi - fr;
+        break;
+    }
+    default:
+        genericButterfly(v, radix, roots);
+        break;
+    }
+}
+
+} // namespace
+
+// FFTPlan
+FFTPlan::FFTPlan(size_t size) : size_(size), bluestein_(false) {
+    if (size == 0) {
+        throw std::invalid_argument("Длина преобразования должна быть положительной");
+    }
+
+    // Разложение длины на основания этапов
+    size_t rest = size;
+    while (rest % 4 == 0) { factors_.push_back(4); rest /= 4; }
+    while (rest % 2 == 0) { factors_.push_back(2); rest /= 2; }
+    while (rest % 3 == 0) { factors_.push_back(3); rest /= 3; }
+    while (rest % 5 == 0) { factors_.push_back(5); rest /= 5; }
+    for (size_t p = 7; p * p <= rest; p += 2) {
+        while (rest % p == 0) { factors_.push_back(p); rest /= p; }
+    }
+    if (rest > 1) factors_.push_back(rest);
+
+    if (factors_.empty() || *std::max_element(factors_.begin(), factors_.end()) <= MAX_RADIX) {
+        // Таблицы поворачивающих множителей для каждого этапа
+        size_t ns = 1;
+        for (size_t s = 0; s < factors_.size(); ++s) {
+            const size_t radix = factors_[s];
+            twiddleOffsets_.push_back(twiddles_.size());
+            for (size_t k = 0; k < ns; ++k) {
+                for (size_t r = 1; r < radix; ++r) {
+                    double angle = -2.0 * PI * static_cast<double>(r * k) / static_cast<double>(ns * radix);
+                    twiddles_.push_back(std::cos(angle));
+                    twiddles_.push_back(std::sin(angle));
+                }
+            }
+            std::vector<double> roots;
+            if (radix > 5) {
+                for (size_t k = 0; k < radix; ++k) {
+                    double angle = -2.0 * PI * static_cast<double>(k) / static_cast<double>(radix);
+                    roots.push_back(std::cos(angle));
+                    roots.push_back(std::sin(angle));
+                }
+            }
+            roots_.push_back(roots);
+            ns *= radix;
+        }
+        return;
+    }
+
+    // Алгоритм Блюстейна: свертка с чирпом через БПФ степени двойки
+    bluestein_ = true;
+    factors_.clear();
+    size_t m = 1;
+    while (m < 2 * size - 1) m <<= 1;
+    inner_ = FFTPlan::get(m);
+
+    chirp_.resize(2 * size);
+    const size_t period = 2 * size;
+    size_t square = 0;  // k^2 mod 2n, считается приращениями без переполнения
+    for (size_t k = 0; k < size; ++k) {
+        double angle = -PI * static_cast<double>(square) / static_cast<double>(size);
+        chirp_[2 * k] = std::cos(angle);
+        chirp_[2 * k + 1] = std::sin(angle);
+        square = (square + 2 * k + 1) % period;
+    }
+
+    chirpSpectrum_.assign(2 * m, 0.0);
+    for (size_t k = 0; k < size; ++k) {
+        chirpSpectrum_[2 * k] = chirp_[2 * k];
+        chirpSpectrum_[2 * k + 1] = -chirp_[2 * k + 1];
+        if (k > 0) {
+            chirpSpectrum_[2 * (m - k)] = chirp_[2 * k];
+            chirpSpectrum_[2 * (m - k) + 1] = -chirp_[2 * k + 1];
+        }
+    }
+    inner_->execute(&chirpSpectrum_[0], &chirpSpectrum_[0], false);
+}
+
+size_t FFTPlan::size() const {
+    return size_;
+}
+
+const std::vector<size_t>& FFTPlan::getFactors() const {
+    return factors_;
+}
+
+bool FFTPlan::usesBluestein() const {
+    return bluestein_;
+}
+
+void FFTPlan::executeStockham(double* data, double* work) const {
+    const size_t n = size_;
+    double* src = data;
+    double* dst = work;
+    double v[2 * MAX_RADIX];
+    size_t ns = 1;
+
+    for (size_t s = 0; s < factors_.size(); ++s) {
+        const size_t radix = factors_[s];
+        const size_t stride = n / radix;
+        const size_t groups = stride / ns;
+        const double* tw = &twiddles_[twiddleOffsets_[s]];
+        const double* roots = roots_[s].empty() ? 0 : &roots_[s][0];
+
+        for (size_t q = 0; q < groups; ++q) {
+            for (size_t k = 0; k < ns; ++k) {
+                const size_t j = q * ns + k;
+                const double* w = tw + 2 * k * (radix - 1);
+                v[0] = src[2 * j];
+                v[1] = src[2 * j + 1];
+                for (size_t r = 1; r < radix; ++r) {
+                    const double xr = src[2 * (j + r * stride)];
+                    const double xi = src[2 * (j + r * stride) + 1];
+                    cmul(xr, xi, w[2 * (r - 1)], w[2 * (r - 1) + 1], v[2 * r], v[2 * r + 1]);
+                }
+                butterfly(v, radix, roots);
+                const size_t base = q * ns * radix + k;
+                for (size_t r = 0; r < radix; ++r) {
+                    dst[2 * (base + r * ns)] = v[2 * r];
+                    dst[2 * (base + r * ns) + 1] = v[2 * r + 1];
+                }
+            }
+        }
+        std::swap(src, dst);
+        ns *= radix;
+    }
+
+    if (src != data) {
+        std::copy(src, src + 2 * n, data);
+    }
+}
+
+void FFTPlan::executeBluestein(double* data) const {
+    const size_t n = size_;
+    const size_t m = inner_->size();
+    std::vector<double> a(2 * m, 0.0);
+    for (size_t k = 0; k < n; ++k) {
+        cmul(data[2 * k], data[2 * k + 1], chirp_[2 * k], chirp_[2 * k + 1], a[2 * k], a[2 * k + 1]);
+    }
+    inner_->execute(&a[0], &a[0], false);
+    for (size_t k = 0; k < m; ++k) {
+        double r, i;
+        cmul(a[2 * k], a[2 * k + 1], chirpSpectrum_[2 * k], chirpSpectrum_[2 * k + 1], r, i);
+        a[2 * k] = r;
+        a[2 * k + 1] = i;
+    }
+    inner_->execute(&a[0], &a[0], true);
+    const double scale = 1.0 / static_cast<double>(m);
+    for (size_t k = 0; k < n; ++k) {
+        cmul(a[2 * k] * scale, a[2 * k + 1] * scale, chirp_[2 * k], chirp_[2 * k + 1],
+             data[2 * k], data[2 * k + 1]);
+    }
+}
+
+void FFTPlan::execute(const double* input, double* output, bool inverse) const {
+    const size_t n = size_;
+    if (input != output) {
+        std::copy(input, input + 2 * n, output);
+    }
+    // Обратное преобразование через сопряжение: IDFT(x) = conj(DFT(conj(x)))
+    if (inverse) {
+        for (size_t k = 0; k < n; ++k) output[2 * k + 1] = -output[2 * k + 1];
+    }
+
+    if (bluestein_) {
+        executeBluestein(output);
+    } else if (n > 1) {
+        std::vector<double> work(2 * n);
+        executeStockham(output, &work[0]);
+    }
+
+    if (inverse) {
+        for (size_t k = 0; k < n; ++k) output[2 * k + 1] = -output[2 * k + 1];
+    }
+}
+
+void FFTPlan::forward(const std::vector<Complex>& input, std::vector<Complex>& output) const {
+    if (input.size() != size_) {
+        throw std::invalid_argument("Длина входа не совпадает с длиной плана");
+    }
+    std::vector<double> buffer(2 * size_);
+    for (size_t k = 0; k < size_; ++k) {
+        buffer[2 * k] = input[k].getReal();
+        buffer[2 * k + 1] = input[k].getImag();
+    }
+    execute(&buffer[0], &buffer[0], false);
+    output.resize(size_);
+    for (size_t k = 0; k < size_; ++k) {
+        output[k] = Complex(buffer[2 * k], buffer[2 * k + 1]);
+    }
+}
+
+void FFTPlan::inverse(const std::vector<Complex>& input, std::vector<Complex>& output) const {
+    if (input.size() != size_) {
+        throw std::invalid_argument("Длина входа не совпадает с длиной плана");
+    }
+    std::vector<double> buffer(2 * size_);
+    for (size_t k = 0; k < size_; ++k) {
+        buffer[2 * k] = input[k].getReal();
+        buffer[2 * k + 1] = input[k].getImag();
+    }
+    execute(&buffer[0], &buffer[0], true);
+    const double scale = 1.0 / static_cast<double>(size_);
+    output.resize(size_);
+    for (size_t k = 0; k < size_; ++k) {
+        output[k] = Complex(buffer[2 * k] * scale, buffer[2 * k + 1] * scale);
+    }
+}
+
+std::shared_ptr<const FFTPlan> FFTPlan::get(size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("Длина преобразования должна быть положительной");
+    }
+    return cachedPlan(g_plans, size);
+}
+
+void FFTPlan::clearCache() {
+    std::lock_guard<std::mutex> lock(g_planMutex);
+    g_plans.clear();
+    g_realPlans.clear();
+}
+
+size_t FFTPlan::cachedPlanCount() {
+    std::lock_guard<std::mutex> lock(g_planMutex);
+    return g_plans.size() + g_realPlans.size();
+}
+
+// RealFFTPlan
+RealFFTPlan::RealFFTPlan(size_t size) : size_(size) {
+    if (size == 0) {
+        throw std::invalid_argument("Длина преобразования должна быть положительной");
+    }
+    if (size % 2 != 0) {
+        plan_ = FFTPlan::get(size);
+        return;
+    }
+
+    const size_t half = size / 2;
+    plan_ = FFTPlan::get(half);
+    twiddles_.resize(2 * half);
+    for (size_t k = 0; k < half; ++k) {
+        double angle = -2.0 * PI * static_cast<double>(k) / static_cast<double>(size);
+        twiddles_[2 * k] = std::cos(angle);
+        twiddles_[2 * k + 1] = std::sin(angle);
+    }
+}
+
+size_t RealFFTPlan::size() const {
+    return size_;
+}
+
+void RealFFTPlan::forward(const double* input, double* output) const {
+    const size_t n = size_;
+    if (n % 2 != 0) {
+        std::vector<double> buffer(2 * n, 0.0);
+        for (size_t k = 0; k < n; ++k) buffer[2 * k] = input[k];
+        plan_->execute(&buffer[0], &buffer[0], false);
+        std::copy(buffer.begin(), buffer.begin() + 2 * (n / 2 + 1), output);
+        return;
+    }
+
+    // Четные отсчеты - действительная часть, нечетные - мнимая
+    const size_t half = n / 2;
+    std::vector<double> z(input, input + n);
+    plan_->execute(&z[0], &z[0], false);
+
+    for (size_t k = 0; k <= half; ++k) {
+        const size_t a = k % half;
+        const size_t b = (half - k) % half;
+        const double zr = z[2 * a], zi = z[2 * a + 1];
+        const double cr = z[2 * b], ci = -z[2 * b + 1];
+        // E = (Z_k + conj(Z_{h-k})) / 2, O = -i * (Z_k - conj(Z_{h-k})) / 2
+        const double er = 0.5 * (zr + cr), ei = 0.5 * (zi + ci);
+        const double orr = 0.5 * (zi - ci), oi = -0.5 * (zr - cr);
+        double wr = -1.0, wi = 0.0;
+        if (k < half) {
+            wr = twiddles_[2 * k];
+            wi = twiddles_[2 * k + 1];
+        }
+        double pr, pi;
+        cmul(wr, wi, orr, oi, pr, pi);
+        output[2 * k] = er + pr;
+        output[2 * k + 1] = ei + pi;
+    }
+}
+
+void RealFFTPlan::inverse(const double* input, double* output) const {
+    const size_t n = size_;
+    if (n % 2 != 0) {
+        // Восстановление эрмитово-симметричного спектра
+        std::vector<double> buffer(2 * n);
+        for (size_t k = 0; k <= n / 2; ++k) {
+            buffer[2 * k] = input[2 * k];
+            buffer[2 * k + 1] = input[2 * k + 1];
+        }
+        for (size_t k = n / 2 + 1; k < n; ++k) {
+            buffer[2 * k] = input[2 * (n - k)];
+            buffer[2 * k + 1] = -input[2 * (n - k) + 1];
+        }
+        plan_->execute(&buffer[0], &buffer[0], true);
+        const double scale = 1.0 / static_cast<double>(n);
+        for (size_t k = 0; k < n; ++k) output[k] = buffer[2 * k] * scale;
+        return;
+    }
+
+    const size_t half = n / 2;
+    std::vector<double> z(n);
+    for (size_t k = 0; k < half; ++k) {
+        const double xr = input[2 * k], xi = input[2 * k + 1];
+        const double cr = input[2 * (half - k)], ci = -input[2 * (half - k) + 1];
+        const double er = 0.5 * (xr + cr), ei = 0.5 * (xi + ci);
+        double orr, oi;
+        // O = (X_k - conj(X_{h-k})) / 2 * conj(w_k)
+        cmul(0.5 * (xr - cr), 0.5 * (xi - ci), twiddles_[2 * k], -twiddles_[2 * k + 1], orr, oi);
+        // Z = E + i * O
+        z[2 * k] = er - oi;
+        z[2 * k + 1] = ei + orr;
+    }
+    plan_->execute(&z[0], &z[0], true);
+    const double scale = 1.0 / static_cast<double>(half);
+    for (size_t k = 0; k < n; ++k) {
+        output[k] = z[k] * scale;
+    }
+}
+
+std::shared_ptr<const RealFFTPlan> RealFFTPlan::get(size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("Длина преобразования должна быть положительной");
+    }
+    return cachedPlan(g_realPlans, size);
+}
+
+// FFT
+std::vector<Complex> FFT::forward(const std::vector<Complex>& input) {
+    std::vector<Complex> output;
+    if (input.empty()) return output;
+    FFTPlan::get(input.size())->forward(input, output);
+    return output;
+}
+
+std::vector<Complex> FFT::inverse(const std::vector<Complex>& input) {
+    std::vector<Complex> output;
+    if (input.empty()) return output;
+    FFTPlan::get(input.size())->inverse(input, output);
+    return output;
+}
+
+std::vector<Complex> FFT::forwardReal(const std::vector<double>& input) {
+    std::vector<Complex> output;
+    if (input.empty()) return output;
+    const size_t bins = input.size() / 2 + 1;
+    std::vector<double> buffer(2 * bins);
+    RealFFTPlan::get(input.size())->forward(&input[0], &buffer[0]);
+    output.reserve(bins);
+    for (size_t k = 0; k < bins; ++k) {
+        output.push_back(Complex(buffer[2 * k], buffer[2 * k + 1]));
+    }
+    return output;
+}
+
+std::vector<double> FFT::inverseReal(const std::vector<Complex>& spectrum, size_t size) {
+    if (size == 0) return std::vector<double>();
+    if (spectrum.size() != size / 2 + 1) {
+        throw std::invalid_argument("Длина спектра должна быть равна n / 2 + 1");
+    }
+    std::vector<double> buffer(2 * spectrum.size());
+    for (size_t k = 0; k < spectrum.size(); ++k) {
+        buffer[2 * k] = spectrum[k].getReal();
+        buffer[2 * k + 1] = spectrum[k].getImag();
+    }
+    std::vector<double> output(size);
+    RealFFTPlan::get(size)->inverse(&buffer[0], &output[0]);
+    return output;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file FFT.h
+ * @brief Быстрое преобразование Фурье над комплексными и вещественными массивами
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "Complex.h"
+
+/**
+ * @class FFTPlan
+ * @brief Заранее вычисленный план БПФ для заданной длины
+ *
+ * Длина раскладывается на множители 4, 2, 3, 5 и малые простые числа;
+ * каждый множитель обрабатывается этапом алгоритма Стокхэма, который
+ * не требует перестановки с обращением битов. Таблицы поворачивающих
+ * множителей всех этапов вычисляются один раз при создании плана.
+ * Если длина содержит большой простой множитель, используется
+ * алгоритм Блюстейна через план степени двойки.
+ *
+ * План неизменяем после создания, поэтому один и тот же план можно
+ * одновременно использовать из нескольких потоков.
+ */
+class FFTPlan {
+private:
+    size_t size_;                                  ///< Длина преобразования
+    std::vector<size_t> factors_;                  ///< Основания этапов
+    std::vector<size_t> twiddleOffsets_;           ///< Начало таблицы каждого этапа
+    std::vector<double> twiddles_;                 ///< Поворачивающие множители (re, im)
+    std::vector<std::vector<double> > roots_;      ///< Корни из единицы для общих оснований
+    bool bluestein_;                               ///< Используется алгоритм Блюстейна
+    std::vector<double> chirp_;                    ///< exp(-i*pi*k^2/n) для Блюстейна
+    std::vector<double> chirpSpectrum_;            ///< Спектр сопряженного чирпа
+    std::shared_ptr<const FFTPlan> inner_;         ///< План степени двойки для Блюстейна
+
+    void executeStockham(double* data, double* work) const;
+    void executeBluestein(double* data) const;
+
+public:
+    /**
+     * @brief Создать план
+     * @param size Длина преобразования
+     * @throw std::invalid_argument если длина равна нулю
+     */
+    explicit FFTPlan(size_t size);
+
+    // Методы доступа
+    /**
+     * @brief Получить длину преобразования
+     * @return Длина
+     */
+    size_t size() const;
+
+    /**
+     * @brief Получить разложение длины на основания этапов
+     * @return Основания этапов (пусто для Блюстейна)
+     */
+    const std::vector<size_t>& getFactors() const;
+
+    /**
+     * @brief Проверить, используется ли алгоритм Блюстейна
+     * @return true для длин с большим простым множителем
+     */
+    bool usesBluestein() const;
+
+    // Выполнение
+    /**
+     * @brief Выполнить преобразование над чередующимся массивом (re, im)
+     * @param input Входные данные, 2 * size() чисел
+     * @param output Выходные данные, 2 * size() чисел (может совпадать с input)
+     * @param inverse true - обратное преобразование (без деления на size())
+     */
+    void execute(const double* input, double* output, bool inverse = false) const;
+
+    /**
+     * @brief Прямое преобразование
+     * @param input Входной массив длины size()
+     * @param output Выходной массив (размер устанавливается)
+     * @throw std::invalid_argument если длина входа не совпадает с планом
+     */
+    void forward(const std::vector<Complex>& input, std::vector<Complex>& output) const;
+
+    /**
+     * @brief Обратное преобразование с нормировкой 1/n
+     * @param input Входной массив длины size()
+     * @param output Выходной массив (размер устанавливается)
+     * @throw std::invalid_argument если длина входа не совпадает с планом
+     */
+    void inverse(const std::vector<Complex>& input, std::vector<Complex>& output) const;
+
+    // Статические методы
+    /**
+     * @brief Получить план из общего кэша (создается при первом обращении)
+     * @param size Длина преобразования
+     * @return Разделяемый неизменяемый план
+     * @throw std::invalid_argument если длина равна нулю
+     */
+    static std::shared_ptr<const FFTPlan> get(size_t size);
+
+    /**
+     * @brief Очистить кэш планов
+     * Планы, которые еще используются, остаются живы до освобождения
+     */
+    static void clearCache();
+
+    /**
+     * @brief Количество планов в кэше
+     * @return Количество планов
+     */
+    static size_t cachedPlanCount();
+};
+
+/**
+ * @class RealFFTPlan
+ * @brief План БПФ вещественного сигнала длины n в n/2 + 1 комплексных отсчетов
+ *
+ * Для четных n сигнал упаковывается в комплексный массив длины n/2,
+ * преобразуется планом половинной длины и разделяется по симметрии
+ * спектра, что примерно вдвое быстрее комплексного преобразования.
+ * Нечетные длины обрабатываются полным комплексным планом.
+ */
+class RealFFTPlan {
+private:
+    size_t size_;                            ///< Длина вещественного сигнала
+    std::shared_ptr<const FFTPlan> plan_;    ///< План половинной (или полной) длины
+    std::vector<double> twiddles_;           ///< exp(-2*pi*i*k/n), k < n/2
+
+public:
+    /**
+     * @brief Создать план
+     * @param size Длина вещественного сигнала
+     * @throw std::invalid_argument если длина равна нулю
+     */
+    explicit RealFFTPlan(size_t size);
+
+    /**
+     * @brief Получить длину сигнала
+     * @return Длина
+     */
+    size_t size() const;
+
+    /**
+     * @brief Прямое преобразование
+     * @param input Вещественный сигнал, size() чисел
+     * @param output Спектр, 2 * (size() / 2 + 1) чисел (re, im)
+     */
+    void forward(const double* input, double* output) const;
+
+    /**
+     * @brief Обратное преобразование с нормировкой 1/n
+     * @param input Спектр, 2 * (size() / 2 + 1) чисел (re, im)
+     * @param output Вещественный сигнал, size() чисел
+     */
+    void inverse(const double* input, double* output) const;
+
+    /**
+     * @brief Получить план из общего кэша
+     * @param size Длина сигнала
+     * @return Разделяемый неизменяемый план
+     */
+    static std::shared_ptr<const RealFFTPlan> get(size_t size);
+};
+
+/**
+ * @class FFT
+ * @brief Удобный интерфейс к кэшированным планам БПФ
+ */
+class FFT {
+public:
+    /**
+     * @brief Прямое преобразование Фурье
+     * @param input Комплексный сигнал
+     * @return Спектр той же длины
+     */
+    static std::vector<Complex> forward(const std::vector<Complex>& input);
+
+    /**
+     * @brief Обратное преобразование Фурье с нормировкой 1/n
+     * @param input Спектр
+     * @return Сигнал той же длины
+     */
+    static std::vector<Complex> inverse(const std::vector<Complex>& input);
+
+    /**
+     * @brief Прямое преобразование вещественного сигнала
+     * @param input Вещественный сигнал длины n
+     * @return Неотрицательные частоты: n / 2 + 1 комплексных отсчетов
+     */
+    static std::vector<Complex> forwardReal(const std::vector<double>& input);
+
+    /**
+     * @brief Обратное преобразование в вещественный сигнал
+     * @param spectrum Неотрицательные частоты: n / 2 + 1 отсчетов
+     * @param size Длина восстанавливаемого сигнала n
+     * @return Вещественный сигнал длины n
+     * @throw std::invalid_argument если длина спектра не равна n / 2 + 1
+     */
+    static std::vector<double> inverseReal(const std::vector<Complex>& spectrum, size_t size);
+};
+
+#endif // FFT_H
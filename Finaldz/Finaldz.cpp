@@ -3,6 +3,7 @@
 #include <iostream>
 #include <iomanip>
 #include <locale>
+#include <chrono>
 
 using namespace std;
 
@@ -163,6 +164,107 @@ void demonstrateFraction() {
     cout << "Дробная часть: " << mixed.getFractionalPart() << endl;
 }
 
+/**
+ * @brief Демонстрация работы с классом BVH
+ */
+void demonstrateBVH() {
+    cout << "\n=== ДЕМОНСТРАЦИЯ КЛАССА BVH ===" << endl;
+
+    // Точки на регулярной сетке 10x10x10
+    vector<Vector3D> points;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            for (int k = 0; k < 10; ++k) {
+                points.push_back(Vector3D(i, j, k));
+            }
+        }
+    }
+
+    BVH tree(points);
+    cout << "Точек: " << tree.size() << ", узлов: " << tree.nodeCount() << endl;
+    cout << "Границы: " << tree.bounds() << endl;
+
+    Vector3D query(2.2, 3.7, 4.1);
+    BVHNeighbor nearest = tree.nearest(query);
+    cout << "Ближайшая к " << query << ": " << points[nearest.index]
+         << " (расстояние " << nearest.distance << ")" << endl;
+    cout << "Точек в радиусе 1.0: " << tree.radiusSearch(query, 1.0).size() << endl;
+
+    // Пересечение луча с треугольником
+    vector<Vector3D> vertices;
+    vertices.push_back(Vector3D(0, 0, 5));
+    vertices.push_back(Vector3D(4, 0, 5));
+    vertices.push_back(Vector3D(0, 4, 5));
+    vector<size_t> indices;
+    indices.push_back(0);
+    indices.push_back(1);
+    indices.push_back(2);
+
+    BVH mesh(vertices, indices);
+    BVHRayHit hit = mesh.intersectRay(Vector3D(1, 1, 0), Vector3D(0, 0, 1));
+    cout << "Луч из (1, 1, 0) вдоль Z: "
+         << (hit.hit ? "пересечение при t = " : "нет пересечения");
+    if (hit.hit) cout << hit.t;
+    cout << endl;
+}
+
+/**
+ * @brief Демонстрация построения фрактала и замер скорости итераций Complex
+ *
+ * Сравнивает поточечный цикл на операторах Complex с плиточным
+ * построителем; заметное падение любого из значений указывает
+ * на регрессию производительности комплексной арифметики.
+ */
+void demonstrateFractal() {
+    cout << "\n=== ДЕМОНСТРАЦИЯ ПОСТРОЕНИЯ ФРАКТАЛА ===" << endl;
+
+    FractalOptions preview;
+    preview.width = 48;
+    preview.height = 27;
+    preview.pixelSize = 0.09;
+    preview.maxIterations = 64;
+    vector<unsigned> image = FractalRenderer::render(preview);
+    const char palette[] = " .:-=+*#%@";
+    for (size_t row = 0; row < preview.height; ++row) {
+        for (size_t column = 0; column < preview.width; ++column) {
+            unsigned count = image[row * preview.width + column];
+            cout << (count == preview.maxIterations ? '@' : palette[count * 9 / preview.maxIterations]);
+        }
+        cout << endl;
+    }
+
+    // Замер производительности
+    FractalOptions bench;
+    bench.width = 400;
+    bench.height = 300;
+    bench.pixelSize = 3.0 / 400.0;
+    bench.maxIterations = 256;
+
+    auto start = chrono::steady_clock::now();
+    unsigned long long referenceIterations = 0;
+    for (size_t row = 0; row < bench.height; ++row) {
+        for (size_t column = 0; column < bench.width; ++column) {
+            Complex c = FractalRenderer::pixelToPoint(bench, column, row);
+            referenceIterations += FractalRenderer::iterate(Complex(0.0, 0.0), c, bench.maxIterations);
+        }
+    }
+    auto middle = chrono::steady_clock::now();
+    vector<unsigned> fast = FractalRenderer::render(bench);
+    auto finish = chrono::steady_clock::now();
+
+    unsigned long long fastIterations = 0;
+    for (size_t i = 0; i < fast.size(); ++i) {
+        fastIterations += fast[i];
+    }
+    double referenceMs = chrono::duration<double, milli>(middle - start).count();
+    double fastMs = chrono::duration<double, milli>(finish - middle).count();
+    cout << "Операторы Complex: " << referenceMs << " мс ("
+         << referenceIterations / (referenceMs * 1000.0) << " млн итераций/с)" << endl;
+    cout << "Плиточный построитель: " << fastMs << " мс ("
+         << fastIterations / (fastMs * 1000.0) << " млн итераций/с)" << endl;
+    cout << "Результаты совпадают: " << (referenceIterations == fastIterations ? "да" : "нет") << endl;
+}
+
 /**
  * @brief Основная функция программы
  */
@@ -182,6 +284,8 @@ int main() {
         demonstrateVector3D();
         demonstrateMatrix();
         demonstrateFraction();
+        demonstrateBVH();
+        demonstrateFractal();
         
        
         
@@ -0,0 +1,263 @@
+/**
+ * @file Fractal.cpp
+ * @brief Реализация построения фракталов
+ */
+
+#include "Fractal.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+const size_t LANES = 8;               ///< Пикселей, итерируемых одновременно
+const unsigned ITERATION_CHUNK = 16;  ///< Итераций между проверками выхода всех точек
+
+/**
+ * @brief Итерации для группы пикселей без ветвлений по отдельным точкам
+ *
+ * Проверка "все точки вышли" выполняется раз в ITERATION_CHUNK итераций,
+ * поэтому внутренний цикл не содержит выходов, а вышедшие точки
+ * замораживаются смешиванием векторов. С векторными командами (Simd.h)
+ * группа занимает LANES / Simd::WIDTH регистров; без них тот же порядок
+ * операций выполняет скалярный цикл.
+ */
+void iterateLanes(const double* startR, const double* startI, const double* cr, const double* ci,
+                  unsigned maxIterations, double bailout, unsigned* counts) {
+#if MATH_SIMD
+    const size_t VECTORS = LANES / Simd::WIDTH;
+    const Simd::Doubles limit = Simd::broadcast(bailout);
+    const Simd::Doubles one = Simd::broadcast(1.0);
+    const Simd::Doubles zero = Simd::broadcast(0.0);
+    const Simd::Doubles two = Simd::broadcast(2.0);
+    Simd::Doubles zr[VECTORS], zi[VECTORS], pr[VECTORS], pi[VECTORS], count[VECTORS];
+    for (size_t v = 0; v < VECTORS; ++v) {
+        zr[v] = Simd::load(startR + v * Simd::WIDTH);
+        zi[v] = Simd::load(startI + v * Simd::WIDTH);
+        pr[v] = Simd::load(cr + v * Simd::WIDTH);
+        pi[v] = Simd::load(ci + v * Simd::WIDTH);
+        count[v] = zero;
+    }
+
+    for (unsigned iteration = 0; iteration < maxIterations; iteration += ITERATION_CHUNK) {
+        const unsigned chunk = std::min(ITERATION_CHUNK, maxIterations - iteration);
+        for (unsigned step = 0; step < chunk; ++step) {
+            for (size_t v = 0; v < VECTORS; ++v) {
+                const Simd::Doubles r2 = Simd::mul(zr[v], zr[v]);
+                const Simd::Doubles i2 = Simd::mul(zi[v], zi[v]);
+                const Simd::Mask inside = Simd::lessEqual(Simd::add(r2, i2), limit);
+                const Simd::Doubles nextI = Simd::add(Simd::mul(Simd::mul(two, zr[v]), zi[v]), pi[v]);
+                const Simd::Doubles nextR = Simd::add(Simd::sub(r2, i2), pr[v]);
+                // Вышедшие точки замораживаются, чтобы не переполниться
+                zr[v] = Simd::select(inside, nextR, zr[v]);
+                zi[v] = Simd::select(inside, nextI, zi[v]);
+                count[v] = Simd::add(count[v], Simd::select(inside, one, zero));
+            }
+        }
+        bool active = false;
+        for (size_t v = 0; v < VECTORS; ++v) {
+            const Simd::Doubles norm = Simd::add(Simd::mul(zr[v], zr[v]), Simd::mul(zi[v], zi[v]));
+            active |= Simd::any(Simd::lessEqual(norm, limit));
+        }
+        if (!active) break;
+    }
+
+    double result[LANES];
+    for (size_t v = 0; v < VECTORS; ++v) {
+        Simd::store(result + v * Simd::WIDTH, count[v]);
+    }
+#else
+    double zr[LANES], zi[LANES], result[LANES];
+    for (size_t l = 0; l < LANES; ++l) {
+        zr[l] = startR[l];
+        zi[l] = startI[l];
+        result[l] = 0.0;
+    }
+
+    for (unsigned iteration = 0; iteration < maxIterations; iteration += ITERATION_CHUNK) {
+        const unsigned chunk = std::min(ITERATION_CHUNK, maxIterations - iteration);
+        for (unsigned step = 0; step < chunk; ++step) {
+            for (size_t l = 0; l < LANES; ++l) {
+                const double r2 = zr[l] * zr[l];
+                const double i2 = zi[l] * zi[l];
+                const bool inside = r2 + i2 <= bailout;
+                const double nextI = 2.0 * zr[l] * zi[l] + ci[l];
+                const double nextR = r2 - i2 + cr[l];
+                // Вышедшие точки замораживаются, чтобы не переполниться
+                zr[l] = inside ? nextR : zr[l];
+                zi[l] = inside ? nextI : zi[l];
+                result[l] += inside ? 1.0 : 0.0;
+            }
+        }
+        bool active = false;
+        for (size_t l = 0; l < LANES; ++l) {
+            active |= zr[l] * zr[l] + zi[l] * zi[l] <= bailout;
+        }
+        if (!active) break;
+    }
+#endif
+
+    for (size_t l = 0; l < LANES; ++l) {
+        counts[l] = static_cast<unsigned>(result[l]);
+    }
+}
+
+/**
+ * @brief Опорная орбита в центре изображения
+ */
+struct ReferenceOrbit {
+    std::vector<double> re;
+    std::vector<double> im;
+    double cr;
+    double ci;
+};
+
+ReferenceOrbit computeReference(const FractalOptions& options, double bailout) {
+    ReferenceOrbit orbit;
+    double zr = options.julia ? options.centerReal : 0.0;
+    double zi = options.julia ? options.centerImag : 0.0;
+    orbit.cr = options.julia ? options.juliaConstant.getReal() : options.centerReal;
+    orbit.ci = options.julia ? options.juliaConstant.getImag() : options.centerImag;
+
+    orbit.re.reserve(options.maxIterations + 1);
+    orbit.im.reserve(options.maxIterations + 1);
+    for (unsigned n = 0; n <= options.maxIterations; ++n) {
+        orbit.re.push_back(zr);
+        orbit.im.push_back(zi);
+        if (zr * zr + zi * zi > bailout) break;
+        const double t = zr * zr - zi * zi + orbit.cr;
+        zi = 2.0 * zr * zi + orbit.ci;
+        zr = t;
+    }
+    return orbit;
+}
+
+/**
+ * @brief Итерации одного пикселя по отклонению от опорной орбиты
+ * @param dcr, dci Отклонение параметра c (ноль для Жюлиа)
+ * @param dzr, dzi Начальное отклонение z (ноль для Мандельброта)
+ */
+unsigned iteratePerturbed(const ReferenceOrbit& orbit, double dcr, double dci, double dzr, double dzi,
+                          unsigned maxIterations, double bailout) {
+    const double* Zr = &orbit.re[0];
+    const double* Zi = &orbit.im[0];
+    const size_t last = orbit.re.size() - 1;
+    size_t n = 0;
+
+    for (unsigned iteration = 0; iteration < maxIterations; ++iteration) {
+        const double zr = Zr[n] + dzr;
+        const double zi = Zi[n] + dzi;
+        const double magnitude2 = zr * zr + zi * zi;
+        if (magnitude2 > bailout) {
+            return iteration;
+        }
+        // Перенос на начало орбиты, если отклонение сравнялось с самой точкой
+        // или опорная орбита закончилась
+        if (magnitude2 < dzr * dzr + dzi * dzi || n == last) {
+            dzr = zr - Zr[0];
+            dzi = zi - Zi[0];
+            n = 0;
+        }
+        // dz' = 2 Z dz + dz^2 + dc
+        const double tr = 2.0 * (Zr[n] * dzr - Zi[n] * dzi) + dzr * dzr - dzi * dzi + dcr;
+        dzi = 2.0 * (Zr[n] * dzi + Zi[n] * dzr) + 2.0 * dzr * dzi + dci;
+        dzr = tr;
+        ++n;
+    }
+    return maxIterations;
+}
+
+} // namespace
+
+Complex FractalRenderer::pixelToPoint(const FractalOptions& options, size_t column, size_t row) {
+    const double dx = (static_cast<double>(column) - 0.5 * static_cast<double>(options.width - 1)) * options.pixelSize;
+    const double dy = (0.5 * static_cast<double>(options.height - 1) - static_cast<double>(row)) * options.pixelSize;
+    return Complex(options.centerReal + dx, options.centerImag + dy);
+}
+
+unsigned FractalRenderer::iterate(Complex z, const Complex& c, unsigned maxIterations, double escapeRadius) {
+    for (unsigned iteration = 0; iteration < maxIterations; ++iteration) {
+        if (z.magnitude() > escapeRadius) {
+            return iteration;
+        }
+        z = z * z + c;
+    }
+    return maxIterations;
+}
+
+std::vector<unsigned> FractalRenderer::render(const FractalOptions& options) {
+    if (options.width == 0 || options.height == 0) {
+        throw std::invalid_argument("Размер изображения должен быть положительным");
+    }
+    if (!(options.pixelSize > 0.0) || options.maxIterations == 0 || !(options.escapeRadius >= 2.0)) {
+        throw std::invalid_argument("Некорректные параметры фрактала");
+    }
+
+    const size_t width = options.width;
+    const size_t height = options.height;
+    const size_t tile = std::max<size_t>(options.tileSize, 1);
+    const size_t tilesX = Parallel::blockCount(width, tile);
+    const size_t tilesY = Parallel::blockCount(height, tile);
+    const double bailout = options.escapeRadius * options.escapeRadius;
+    const double halfWidth = 0.5 * static_cast<double>(width - 1);
+    const double halfHeight = 0.5 * static_cast<double>(height - 1);
+    const double jr = options.juliaConstant.getReal();
+    const double ji = options.juliaConstant.getImag();
+
+    ReferenceOrbit orbit;
+    if (options.perturbation) {
+        orbit = computeReference(options, bailout);
+    }
+
+    std::vector<unsigned> result(width * height);
+    auto renderTiles = [&](size_t, size_t begin, size_t end) {
+        double startR[LANES], startI[LANES], cr[LANES], ci[LANES];
+        unsigned counts[LANES];
+        for (size_t t = begin; t < end; ++t) {
+            const size_t x0 = (t % tilesX) * tile;
+            const size_t y0 = (t / tilesX) * tile;
+            const size_t x1 = std::min(x0 + tile, width);
+            const size_t y1 = std::min(y0 + tile, height);
+
+            for (size_t row = y0; row < y1; ++row) {
+                // Отклонения от центра вычисляются отдельно от координат центра
+                const double dy = (halfHeight - static_cast<double>(row)) * options.pixelSize;
+                unsigned* out = &result[row * width];
+
+                if (options.perturbation) {
+                    for (size_t column = x0; column < x1; ++column) {
+                        const double dx = (static_cast<double>(column) - halfWidth) * options.pixelSize;
+                        out[column] = options.julia
+                            ? iteratePerturbed(orbit, 0.0, 0.0, dx, dy, options.maxIterations, bailout)
+                            : iteratePerturbed(orbit, dx, dy, 0.0, 0.0, options.maxIterations, bailout);
+                    }
+                    continue;
+                }
+
+                for (size_t column = x0; column < x1; column += LANES) {
+                    const size_t lanes = std::min(LANES, x1 - column);
+                    for (size_t l = 0; l < LANES; ++l) {
+                        // Лишние дорожки повторяют последний пиксель строки
+                        const size_t c = column + std::min(l, lanes - 1);
+                        const double x = options.centerReal + (static_cast<double>(c) - halfWidth) * options.pixelSize;
+                        const double y = options.centerImag + dy;
+                        startR[l] = options.julia ? x : 0.0;
+                        startI[l] = options.julia ? y : 0.0;
+                        cr[l] = options.julia ? jr : x;
+                        ci[l] = options.julia ? ji : y;
+                    }
+                    iterateLanes(startR, startI, cr, ci, options.maxIterations, bailout, counts);
+                    std::copy(counts, counts + lanes, out + column);
+                }
+            }
+        }
+    };
+
+    if (options.parallel) {
+        Parallel::forEachBlock(tilesX * tilesY, 1, renderTiles);
+    } else {
+        renderTiles(0, 0, tilesX * tilesY);
+    }
+    return result;
+}
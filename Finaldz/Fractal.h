@@ -0,0 +1,89 @@
+/**
+ * @file Fractal.h
+ * @brief Построение множеств Мандельброта и Жюлиа методом времени выхода
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef FRACTAL_H
+#define FRACTAL_H
+
+#include <vector>
+#include <cstddef>
+#include "Complex.h"
+
+/**
+ * @brief Параметры построения фрактала
+ */
+struct FractalOptions {
+    size_t width;              ///< Ширина изображения в пикселях
+    size_t height;             ///< Высота изображения в пикселях
+    double centerReal;         ///< Действительная часть центра изображения
+    double centerImag;         ///< Мнимая часть центра изображения
+    double pixelSize;          ///< Размер пикселя в комплексной плоскости
+    unsigned maxIterations;    ///< Максимальное число итераций
+    double escapeRadius;       ///< Радиус выхода (не меньше 2)
+    bool julia;                ///< true - множество Жюлиа, false - Мандельброта
+    Complex juliaConstant;     ///< Параметр c множества Жюлиа
+    size_t tileSize;           ///< Сторона квадратной плитки в пикселях
+    bool parallel;             ///< Обрабатывать плитки в нескольких потоках
+    bool perturbation;         ///< Считать отклонения от опорной орбиты в центре
+
+    FractalOptions()
+        : width(800), height(600), centerReal(-0.5), centerImag(0.0), pixelSize(3.0 / 800.0),
+          maxIterations(256), escapeRadius(2.0), julia(false), juliaConstant(-0.8, 0.156),
+          tileSize(32), parallel(true), perturbation(false) {}
+};
+
+/**
+ * @class FractalRenderer
+ * @brief Построение фрактала по числу итераций до выхода z -> z^2 + c
+ *
+ * Изображение делится на квадратные плитки, которые распределяются между
+ * потоками. Внутри плитки пиксели итерируются группами по восемь:
+ * действительные и мнимые части хранятся в отдельных массивах (как
+ * в ComplexArray), вышедшие точки маскируются, а не ветвятся, поэтому
+ * внутренний цикл векторизуется компилятором.
+ *
+ * В режиме возмущений опорная орбита вычисляется один раз в центре
+ * изображения, а для пикселей итерируются только малые отклонения
+ * от нее. Отклонения пикселей не теряют точности при сложении
+ * с большими координатами центра, что важно при глубоком увеличении.
+ * Когда отклонение становится больше самой орбиты, оно переносится
+ * на начало опорной орбиты (rebasing), что устраняет артефакты.
+ */
+class FractalRenderer {
+public:
+    /**
+     * @brief Построить изображение
+     * @param options Параметры построения
+     * @return Число итераций для каждого пикселя по строкам сверху вниз
+     *         (maxIterations для точек, не вышедших за радиус)
+     * @throw std::invalid_argument если параметры некорректны
+     */
+    static std::vector<unsigned> render(const FractalOptions& options);
+
+    /**
+     * @brief Точка комплексной плоскости, соответствующая пикселю
+     * @param options Параметры построения
+     * @param column Столбец
+     * @param row Строка (0 - верхняя)
+     * @return Координата центра пикселя
+     */
+    static Complex pixelToPoint(const FractalOptions& options, size_t column, size_t row);
+
+    /**
+     * @brief Число итераций для одной точки средствами класса Complex
+     * @param z Начальное значение
+     * @param c Параметр
+     * @param maxIterations Максимальное число итераций
+     * @param escapeRadius Радиус выхода
+     * @return Число итераций до выхода
+     *
+     * Эталонная реализация через операторы Complex; используется
+     * для проверки и сравнения производительности.
+     */
+    static unsigned iterate(Complex z, const Complex& c, unsigned maxIterations, double escapeRadius = 2.0);
+};
+
+#endif // FRACTAL_H
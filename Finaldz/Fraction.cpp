@@ -3,6 +3,8 @@
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include "Parallel.h"
 
 // Приватные методы
 void Fraction::simplify() {
@@ -43,11 +45,13 @@ Fraction::Fraction(long long numerator, long long denominator)
 
 Fraction::Fraction(double value, int precision) {
     if (precision < 0) precision = 6;
-    
-    long long multiplier = static_cast<long long>(std::pow(10, precision));
-    numerator_ = static_cast<long long>(std::round(value * multiplier));
-    denominator_ = multiplier;
-    simplify();
+    if (precision > 18) precision = 18;
+
+    long long max_denominator = 1;
+    for (int i = 0; i < precision; ++i) {
+        max_denominator *= 10;
+    }
+    *this = approximate(value, max_denominator);
 }
 
 Fraction::Fraction(const Fraction& other) 
@@ -247,3 +251,68 @@ std::istream& operator>>(std::istream& is, Fraction& fraction) {
     fraction.simplify();
     return is;
 }
+
+// Статические методы
+Fraction Fraction::approximate(double value, long long maxDenominator) {
+    if (maxDenominator < 1) {
+        throw std::invalid_argument("Наибольший знаменатель должен быть положительным");
+    }
+    const double limit = static_cast<double>(std::numeric_limits<long long>::max() / 2);
+    if (!(std::abs(value) < limit)) {
+        throw std::invalid_argument("Число не представимо обыкновенной дробью");
+    }
+    // Числитель не должен выйти за пределы long long
+    const double largest = limit / (std::abs(value) + 1.0);
+    if (static_cast<double>(maxDenominator) > largest) {
+        maxDenominator = static_cast<long long>(largest);
+        if (maxDenominator < 1) maxDenominator = 1;
+    }
+
+    // Подходящие дроби p/q: p_k = a_k * p_(k-1) + p_(k-2)
+    long long p0 = 0, q0 = 1;  // p_(k-2), q_(k-2)
+    long long p1 = 1, q1 = 0;  // p_(k-1), q_(k-1)
+    double x = value;
+    for (int iteration = 0; iteration < 64; ++iteration) {
+        const double whole = std::floor(x);
+        if (q1 != 0 && whole > static_cast<double>((maxDenominator - q0) / q1)) {
+            // Следующая подходящая дробь превышает границу: берем наибольшую
+            // допустимую промежуточную дробь, если она ближе последней подходящей
+            const long long k = (maxDenominator - q0) / q1;
+            const long long pk = p0 + k * p1;
+            const long long qk = q0 + k * q1;
+            const double errorK = std::abs(value - static_cast<double>(pk) / static_cast<double>(qk));
+            const double error1 = std::abs(value - static_cast<double>(p1) / static_cast<double>(q1));
+            return errorK < error1 ? Fraction(pk, qk) : Fraction(p1, q1);
+        }
+        const long long a = static_cast<long long>(whole);
+        const long long p2 = a * p1 + p0;
+        const long long q2 = a * q1 + q0;
+        p0 = p1;
+        q0 = q1;
+        p1 = p2;
+        q1 = q2;
+
+        const double fractional = x - whole;
+        if (fractional <= 0.0 || static_cast<double>(p1) / static_cast<double>(q1) == value) {
+            break;
+        }
+        x = 1.0 / fractional;
+    }
+    return Fraction(p1, q1);
+}
+
+std::vector<Fraction> Fraction::approximate(const std::vector<double>& values, long long maxDenominator,
+                                            bool parallel) {
+    std::vector<Fraction> result(values.size());
+    auto convert = [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = approximate(values[i], maxDenominator);
+        }
+    };
+    if (parallel) {
+        Parallel::forEachBlock(values.size(), 4096, convert);
+    } else {
+        convert(0, 0, values.size());
+    }
+    return result;
+}
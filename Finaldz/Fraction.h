@@ -4,6 +4,8 @@
 #define FRACTION_H
 
 #include <iostream>
+#include <vector>
+#include <type_traits>
 
 /**
  * @class Fraction
@@ -61,10 +63,31 @@ public:
      */
     Fraction(long long numerator, long long denominator);
 
+    /**
+     * @brief Конструктор из пары целых чисел любых целых типов
+     * @param numerator Числитель
+     * @param denominator Знаменатель
+     * @throw std::invalid_argument если знаменатель равен нулю
+     *
+     * Без этого шаблона вызов Fraction(7, 3) выбирал бы конструктор
+     * из вещественного числа (точное совпадение второго аргумента int).
+     */
+    template <typename N, typename D>
+    Fraction(N numerator, D denominator,
+             typename std::enable_if<std::is_integral<N>::value && std::is_integral<D>::value>::type* = 0)
+        : numerator_(static_cast<long long>(numerator)), denominator_(static_cast<long long>(denominator)) {
+        simplify();
+    }
+
     /**
      * @brief Конструктор из вещественного числа
      * @param value Вещественное число
-     * @param precision Точность (количество знаков после запятой)
+     * @param precision Точность (количество знаков после запятой, не более 18)
+     * @throw std::invalid_argument если число не конечно или слишком велико
+     *
+     * Возвращает наилучшее приближение со знаменателем не больше
+     * 10^precision (см. approximate), поэтому погрешность не превышает
+     * 0.5 * 10^(-precision), а знаменатель минимален.
      */
     explicit Fraction(double value, int precision = 6);
 
@@ -285,6 +308,33 @@ public:
      */
     Fraction getFractionalPart() const;
 
+    // Статические методы
+    /**
+     * @brief Наилучшее рациональное приближение с ограниченным знаменателем
+     * @param value Вещественное число
+     * @param maxDenominator Наибольший допустимый знаменатель (не меньше 1)
+     * @return Ближайшая к value дробь со знаменателем не больше maxDenominator
+     * @throw std::invalid_argument если число не конечно, слишком велико
+     *        или maxDenominator меньше 1
+     *
+     * Используется разложение в цепную дробь (спуск по дереву
+     * Штерна-Броко): подходящие дроби строятся до превышения границы
+     * знаменателя, затем проверяется последняя промежуточная дробь.
+     * Требуется не более нескольких десятков итераций без вызовов pow.
+     */
+    static Fraction approximate(double value, long long maxDenominator);
+
+    /**
+     * @brief Пакетное приближение массива чисел
+     * @param values Вещественные числа
+     * @param maxDenominator Наибольший допустимый знаменатель
+     * @param parallel Использовать несколько потоков
+     * @return Приближения в том же порядке
+     * @throw std::invalid_argument если какое-либо число не представимо
+     */
+    static std::vector<Fraction> approximate(const std::vector<double>& values, long long maxDenominator,
+                                             bool parallel = true);
+
     // Дружественные функции
     /**
      * @brief Оператор вывода в поток
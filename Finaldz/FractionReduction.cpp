@@ -0,0 +1,184 @@
+/**
+ * @file FractionReduction.cpp
+ * @brief Реализация точного суммирования массивов дробей
+ */
+
+#include "FractionReduction.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <limits>
+
+namespace {
+
+const size_t FRACTION_BLOCK = 1024;  ///< Дробей в одном блоке
+
+/**
+ * @brief Несокращаемая дробь со знаменателем больше нуля
+ */
+struct Rational {
+    long long num;
+    long long den;
+};
+
+void overflow() {
+    throw std::overflow_error("Переполнение при точном суммировании дробей");
+}
+
+long long gcd(long long a, long long b) {
+    if (a < 0) a = -a;
+    while (b != 0) {
+        long long t = a % b;
+        a = b;
+        b = t;
+    }
+    return a < 0 ? -a : a;
+}
+
+long long checkedMul(long long a, long long b) {
+    const long long max = std::numeric_limits<long long>::max();
+    if (a != 0 && b != 0) {
+        const long long ua = a < 0 ? -a : a;
+        const long long ub = b < 0 ? -b : b;
+        if (a == std::numeric_limits<long long>::min() || b == std::numeric_limits<long long>::min() ||
+            ua > max / ub) {
+            overflow();
+        }
+    }
+    return a * b;
+}
+
+long long checkedAdd(long long a, long long b) {
+    if ((b > 0 && a > std::numeric_limits<long long>::max() - b) ||
+        (b < 0 && a < std::numeric_limits<long long>::min() - b)) {
+        overflow();
+    }
+    return a + b;
+}
+
+/**
+ * @brief Сумма двух несократимых дробей
+ *
+ * a/b + c/d: g = gcd(b, d), t = a*(d/g) + c*(b/g), g2 = gcd(t, g),
+ * результат (t/g2) / ((b/g)*(d/g2)) уже несократим.
+ */
+Rational add(const Rational& x, const Rational& y) {
+    if (x.num == 0) return y;
+    if (y.num == 0) return x;
+    if (x.den == y.den) {
+        // Общий знаменатель: достаточно сложить числители и сократить
+        long long t = checkedAdd(x.num, y.num);
+        long long g = gcd(t, x.den);
+        Rational r = { t / g, x.den / g };
+        if (t == 0) r.den = 1;
+        return r;
+    }
+    long long g = gcd(x.den, y.den);
+    long long t = checkedAdd(checkedMul(x.num, y.den / g), checkedMul(y.num, x.den / g));
+    if (t == 0) {
+        Rational zero = { 0, 1 };
+        return zero;
+    }
+    long long g2 = gcd(t, g);
+    Rational r = { t / g2, checkedMul(x.den / g, y.den / g2) };
+    return r;
+}
+
+/**
+ * @brief Произведение двух несократимых дробей с перекрестным сокращением
+ */
+Rational multiply(const Rational& x, const Rational& y) {
+    if (x.num == 0 || y.num == 0) {
+        Rational zero = { 0, 1 };
+        return zero;
+    }
+    long long g1 = gcd(x.num, y.den);
+    long long g2 = gcd(y.num, x.den);
+    Rational r = { checkedMul(x.num / g1, y.num / g2), checkedMul(x.den / g2, y.den / g1) };
+    return r;
+}
+
+Rational toRational(const Fraction& value) {
+    Rational r = { value.getNumerator(), value.getDenominator() };
+    return r;
+}
+
+/**
+ * @brief Сбалансированное попарное дерево сложений
+ */
+Rational treeSum(std::vector<Rational>& parts) {
+    if (parts.empty()) {
+        Rational zero = { 0, 1 };
+        return zero;
+    }
+    for (size_t step = 1; step < parts.size(); step *= 2) {
+        for (size_t i = 0; i + step < parts.size(); i += 2 * step) {
+            parts[i] = add(parts[i], parts[i + step]);
+        }
+    }
+    return parts[0];
+}
+
+/**
+ * @brief Сумма блока: подряд идущие дроби с общим знаменателем
+ *        складываются числителями, затем группы - деревом
+ */
+template <typename Term>
+Rational blockSum(size_t begin, size_t end, Term term, std::vector<Rational>& runs) {
+    runs.clear();
+    size_t i = begin;
+    while (i < end) {
+        Rational run = term(i++);
+        while (i < end) {
+            Rational next = term(i);
+            if (next.den != run.den) break;
+            run.num = checkedAdd(run.num, next.num);
+            ++i;
+        }
+        long long g = gcd(run.num, run.den);
+        if (run.num == 0) {
+            run.den = 1;
+        } else {
+            run.num /= g;
+            run.den /= g;
+        }
+        runs.push_back(run);
+    }
+    return treeSum(runs);
+}
+
+template <typename Term>
+Fraction reduce(size_t count, bool parallel, Term term) {
+    std::vector<Rational> parts(Parallel::blockCount(count, FRACTION_BLOCK));
+    auto process = [&](size_t, size_t first, size_t last) {
+        std::vector<Rational> runs;
+        for (size_t b = first; b < last; ++b) {
+            const size_t begin = b * FRACTION_BLOCK;
+            const size_t end = begin + FRACTION_BLOCK < count ? begin + FRACTION_BLOCK : count;
+            parts[b] = blockSum(begin, end, term, runs);
+        }
+    };
+    if (parallel) {
+        Parallel::forEachBlock(parts.size(), 1, process);
+    } else {
+        process(0, 0, parts.size());
+    }
+    Rational total = treeSum(parts);
+    return Fraction(total.num, total.den);
+}
+
+} // namespace
+
+Fraction FractionReduction::sum(const std::vector<Fraction>& values, bool parallel) {
+    return reduce(values.size(), parallel, [&](size_t i) {
+        return toRational(values[i]);
+    });
+}
+
+Fraction FractionReduction::dot(const std::vector<Fraction>& a, const std::vector<Fraction>& b, bool parallel) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("Длины массивов должны совпадать");
+    }
+    return reduce(a.size(), parallel, [&](size_t i) {
+        return multiply(toRational(a[i]), toRational(b[i]));
+    });
+}
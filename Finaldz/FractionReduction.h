@@ -0,0 +1,53 @@
+/**
+ * @file FractionReduction.h
+ * @brief Точное параллельное суммирование массивов дробей
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef FRACTIONREDUCTION_H
+#define FRACTIONREDUCTION_H
+
+#include <vector>
+#include "Fraction.h"
+
+/**
+ * @class FractionReduction
+ * @brief Точные сумма и скалярное произведение массивов Fraction
+ *
+ * Последовательное сложение через operator+= приводит к быстрому росту
+ * знаменателей: каждая новая дробь умножает общий знаменатель. Здесь
+ * массив делится на блоки фиксированного размера; соседние дроби
+ * с одинаковым знаменателем сначала складываются одними числителями,
+ * затем частичные суммы объединяются сбалансированным попарным деревом,
+ * в котором складываются дроби сопоставимого размера. Сложение
+ * сокращает общий множитель знаменателей до умножения (метод Кнута).
+ *
+ * Результат точный, поэтому не зависит от числа потоков; порядок
+ * объединения также фиксирован, так что переполнение, если оно
+ * возникает, возникает одинаково при любом числе потоков.
+ */
+class FractionReduction {
+public:
+    /**
+     * @brief Точная сумма дробей
+     * @param values Массив дробей
+     * @param parallel Использовать несколько потоков
+     * @return Сумма (0 для пустого массива)
+     * @throw std::overflow_error если числитель или знаменатель не помещается в long long
+     */
+    static Fraction sum(const std::vector<Fraction>& values, bool parallel = true);
+
+    /**
+     * @brief Точное скалярное произведение
+     * @param a Первый массив
+     * @param b Второй массив
+     * @param parallel Использовать несколько потоков
+     * @return Сумма a[i] * b[i]
+     * @throw std::invalid_argument если длины массивов различаются
+     * @throw std::overflow_error если числитель или знаменатель не помещается в long long
+     */
+    static Fraction dot(const std::vector<Fraction>& a, const std::vector<Fraction>& b, bool parallel = true);
+};
+
+#endif // FRACTIONREDUCTION_H
@@ -0,0 +1,211 @@
+/**
+ * @file Gemm.cpp
+ * @brief Реализация блочного умножения плотных матриц
+ */
+
+#include "Gemm.h"
+#include "Parallel.h"
+#include <cstring>
+#include <algorithm>
+
+const size_t Gemm::STRASSEN_CROSSOVER;
+
+namespace {
+
+const size_t GEMM_MC = 32;    ///< Строк C в задаче одного потока
+const size_t GEMM_KC = 256;   ///< Глубина панели по K
+const size_t GEMM_NC = 256;   ///< Ширина панели по N
+const size_t GEMM_MR = 4;     ///< Строк A, обновляемых за один проход по B
+const size_t GEMM_PARALLEL_WORK = 64 * 64 * 64;  ///< Меньшие произведения считаются в одном потоке
+
+/**
+ * @brief Полоса строк [rowBegin, rowEnd) произведения, C уже обнулена или накоплена
+ */
+void multiplyRows(size_t rowBegin, size_t rowEnd, size_t n, size_t k,
+                  const double* a, size_t lda, const double* b, size_t ldb,
+                  double* c, size_t ldc) {
+    // Локальный накопитель не пересекается с A, B и C, что позволяет
+    // компилятору векторизовать внутренний цикл без проверок наложения
+    double acc[GEMM_MR * GEMM_NC];
+
+    for (size_t jc = 0; jc < n; jc += GEMM_NC) {
+        const size_t nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;
+        for (size_t pc = 0; pc < k; pc += GEMM_KC) {
+            const size_t kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;
+            size_t i = rowBegin;
+            for (; i + GEMM_MR <= rowEnd; i += GEMM_MR) {
+                std::memset(acc, 0, sizeof(acc));
+                const double* a0 = a + i * lda + pc;
+                for (size_t p = 0; p < kc; ++p) {
+                    const double x0 = a0[p];
+                    const double x1 = a0[lda + p];
+                    const double x2 = a0[2 * lda + p];
+                    const double x3 = a0[3 * lda + p];
+                    const double* bp = b + (pc + p) * ldb + jc;
+                    for (size_t j = 0; j < nc; ++j) {
+                        const double y = bp[j];
+                        acc[j] += x0 * y;
+                        acc[GEMM_NC + j] += x1 * y;
+                        acc[2 * GEMM_NC + j] += x2 * y;
+                        acc[3 * GEMM_NC + j] += x3 * y;
+                    }
+                }
+                for (size_t r = 0; r < GEMM_MR; ++r) {
+                    double* cr = c + (i + r) * ldc + jc;
+                    const double* ar = acc + r * GEMM_NC;
+                    for (size_t j = 0; j < nc; ++j) cr[j] += ar[j];
+                }
+            }
+            // Оставшиеся строки по одной
+            for (; i < rowEnd; ++i) {
+                std::memset(acc, 0, nc * sizeof(double));
+                const double* ai = a + i * lda + pc;
+                for (size_t p = 0; p < kc; ++p) {
+                    const double x = ai[p];
+                    const double* bp = b + (pc + p) * ldb + jc;
+                    for (size_t j = 0; j < nc; ++j) acc[j] += x * bp[j];
+                }
+                double* ci = c + i * ldc + jc;
+                for (size_t j = 0; j < nc; ++j) ci[j] += acc[j];
+            }
+        }
+    }
+}
+
+// Поэлементные операции над блоками (z может совпадать с x или y)
+void addBlocks(size_t m, size_t n, const double* x, size_t ldx, const double* y, size_t ldy,
+               double* z, size_t ldz) {
+    for (size_t i = 0; i < m; ++i) {
+        const double* xi = x + i * ldx;
+        const double* yi = y + i * ldy;
+        double* zi = z + i * ldz;
+        for (size_t j = 0; j < n; ++j) zi[j] = xi[j] + yi[j];
+    }
+}
+
+void subtractBlocks(size_t m, size_t n, const double* x, size_t ldx, const double* y, size_t ldy,
+                    double* z, size_t ldz) {
+    for (size_t i = 0; i < m; ++i) {
+        const double* xi = x + i * ldx;
+        const double* yi = y + i * ldy;
+        double* zi = z + i * ldz;
+        for (size_t j = 0; j < n; ++j) zi[j] = xi[j] - yi[j];
+    }
+}
+
+bool strassenLeaf(size_t m, size_t n, size_t k, size_t crossover) {
+    return m <= crossover || n <= crossover || k <= crossover;
+}
+
+/**
+ * @brief Рекурсия Штрассена - Винограда
+ *
+ * Порядок вычислений - схема с двумя временными блоками из работы
+ * Boyer, Dumas, Pernet, Zhou "Memory efficient scheduling of
+ * Strassen-Winograd's matrix multiplication algorithm" (2009):
+ * X вмещает квадрант A или квадрант C, Y - квадрант B, остальные
+ * промежуточные значения хранятся в квадрантах C.
+ */
+void strassen(size_t m, size_t n, size_t k,
+              const double* a, size_t lda, const double* b, size_t ldb,
+              double* c, size_t ldc, double* workspace, size_t crossover, bool parallel) {
+    if (strassenLeaf(m, n, k, crossover)) {
+        Gemm::multiply(m, n, k, a, lda, b, ldb, c, ldc, false, parallel);
+        return;
+    }
+    const size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+    const double* a11 = a;
+    const double* a12 = a + k2;
+    const double* a21 = a + m2 * lda;
+    const double* a22 = a21 + k2;
+    const double* b11 = b;
+    const double* b12 = b + n2;
+    const double* b21 = b + k2 * ldb;
+    const double* b22 = b21 + n2;
+    double* c11 = c;
+    double* c12 = c + n2;
+    double* c21 = c + m2 * ldc;
+    double* c22 = c21 + n2;
+    double* x = workspace;
+    double* y = workspace + m2 * std::max(k2, n2);
+    double* rest = y + k2 * n2;
+
+    subtractBlocks(m2, k2, a11, lda, a21, lda, x, k2);                          // S3 = A11 - A21
+    subtractBlocks(k2, n2, b22, ldb, b12, ldb, y, n2);                          // T3 = B22 - B12
+    strassen(m2, n2, k2, x, k2, y, n2, c21, ldc, rest, crossover, parallel);   // P7 = S3 * T3
+    addBlocks(m2, k2, a21, lda, a22, lda, x, k2);                               // S1 = A21 + A22
+    subtractBlocks(k2, n2, b12, ldb, b11, ldb, y, n2);                          // T1 = B12 - B11
+    strassen(m2, n2, k2, x, k2, y, n2, c22, ldc, rest, crossover, parallel);   // P5 = S1 * T1
+    subtractBlocks(m2, k2, x, k2, a11, lda, x, k2);                             // S2 = S1 - A11
+    subtractBlocks(k2, n2, b22, ldb, y, n2, y, n2);                             // T2 = B22 - T1
+    strassen(m2, n2, k2, x, k2, y, n2, c12, ldc, rest, crossover, parallel);   // P6 = S2 * T2
+    subtractBlocks(m2, k2, a12, lda, x, k2, x, k2);                             // S4 = A12 - S2
+    strassen(m2, n2, k2, x, k2, b22, ldb, c11, ldc, rest, crossover, parallel); // P3 = S4 * B22
+    strassen(m2, n2, k2, a11, lda, b11, ldb, x, n2, rest, crossover, parallel); // P1 = A11 * B11
+    addBlocks(m2, n2, x, n2, c12, ldc, c12, ldc);                               // U2 = P1 + P6
+    addBlocks(m2, n2, c12, ldc, c21, ldc, c21, ldc);                            // U3 = U2 + P7
+    addBlocks(m2, n2, c12, ldc, c22, ldc, c12, ldc);                            // U4 = U2 + P5
+    addBlocks(m2, n2, c21, ldc, c22, ldc, c22, ldc);                            // U7 = U3 + P5 = C22
+    addBlocks(m2, n2, c12, ldc, c11, ldc, c12, ldc);                            // U5 = U4 + P3 = C12
+    subtractBlocks(k2, n2, y, n2, b21, ldb, y, n2);                             // T4 = T2 - B21
+    strassen(m2, n2, k2, a22, lda, y, n2, c11, ldc, rest, crossover, parallel); // P4 = A22 * T4
+    subtractBlocks(m2, n2, c21, ldc, c11, ldc, c21, ldc);                       // U6 = U3 - P4 = C21
+    strassen(m2, n2, k2, a12, lda, b21, ldb, c11, ldc, rest, crossover, parallel); // P2 = A12 * B21
+    addBlocks(m2, n2, x, n2, c11, ldc, c11, ldc);                               // U1 = P1 + P2 = C11
+
+    // Нечетные размеры: вклад последнего столбца A, последний столбец
+    // и последняя строка C считаются обычным ядром
+    if (k > 2 * k2) {
+        Gemm::multiply(2 * m2, 2 * n2, 1, a + (k - 1), lda, b + (k - 1) * ldb, ldb, c, ldc, true, parallel);
+    }
+    if (n > 2 * n2) {
+        Gemm::multiply(m, 1, k, a, lda, b + (n - 1), ldb, c + (n - 1), ldc, false, parallel);
+    }
+    if (m > 2 * m2) {
+        Gemm::multiply(1, 2 * n2, k, a + (m - 1) * lda, lda, b, ldb, c + (m - 1) * ldc, ldc, false, parallel);
+    }
+}
+
+} // namespace
+
+void Gemm::multiply(size_t m, size_t n, size_t k,
+                    const double* a, size_t lda,
+                    const double* b, size_t ldb,
+                    double* c, size_t ldc,
+                    bool accumulate, bool parallel) {
+    if (m == 0 || n == 0) return;
+    if (!accumulate) {
+        for (size_t i = 0; i < m; ++i) std::memset(c + i * ldc, 0, n * sizeof(double));
+    }
+    if (k == 0) return;
+
+    auto process = [&](size_t, size_t begin, size_t end) {
+        multiplyRows(begin, end, n, k, a, lda, b, ldb, c, ldc);
+    };
+    if (parallel && m > GEMM_MC && m * n * k >= GEMM_PARALLEL_WORK) {
+        Parallel::forEachBlock(m, GEMM_MC, process);
+    } else {
+        process(0, 0, m);
+    }
+}
+
+size_t Gemm::strassenWorkspaceSize(size_t m, size_t n, size_t k, size_t crossover) {
+    if (crossover == 0) crossover = 1;
+    size_t size = 0;
+    while (!strassenLeaf(m, n, k, crossover)) {
+        m /= 2;
+        n /= 2;
+        k /= 2;
+        size += m * std::max(k, n) + k * n;
+    }
+    return size;
+}
+
+void Gemm::multiplyStrassen(size_t m, size_t n, size_t k,
+                            const double* a, size_t lda,
+                            const double* b, size_t ldb,
+                            double* c, size_t ldc,
+                            double* workspace, size_t crossover, bool parallel) {
+    if (crossover == 0) crossover = 1;
+    strassen(m, n, k, a, lda, b, ldb, c, ldc, workspace, crossover, parallel);
+}
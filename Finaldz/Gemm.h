@@ -0,0 +1,102 @@
+/**
+ * @file Gemm.h
+ * @brief Блочное умножение плотных матриц
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef GEMM_H
+#define GEMM_H
+
+#include <cstddef>
+
+/**
+ * @class Gemm
+ * @brief Ядро умножения матриц C = A * B (или C += A * B)
+ *
+ * Матрицы задаются указателем на первый элемент и шагом строки (ld),
+ * поэтому ядро одинаково работает с целыми матрицами и с их блоками.
+ * Умножение разбито на панели по K и N, помещающиеся в кэш; внутри
+ * панели четыре строки A обновляются за один проход по строке B,
+ * а внутренний цикл по столбцам векторизуется компилятором.
+ * Полосы строк обрабатываются параллельно через Parallel::forEachBlock.
+ *
+ * Ядро используется Matrix::operator* и внешней памятью TiledMatrix.
+ *
+ * Для очень больших матриц есть быстрое умножение Штрассена - Винограда
+ * (multiplyStrassen): 7 умножений половинных блоков вместо 8 на каждом
+ * уровне рекурсии, O(n^2.81) операций. Рекурсия останавливается, когда
+ * хотя бы один размер не больше порога перехода, и дальше блоки умножает
+ * обычное ядро. Нечетные размеры обрабатываются отсечением последней
+ * строки или столбца с досчетом через обычное ядро.
+ *
+ * Точность: поэлементной оценки |C - C'| <= k * u * |A| * |B|, как
+ * у обычного умножения, нет - выполняется только оценка по норме,
+ * и погрешность растет примерно в 2-4 раза с каждым уровнем рекурсии.
+ * Для случайных матриц n = 2048 с порогом 256 (3 уровня) относительная
+ * погрешность по норме Фробениуса около 1e-14; малые элементы C,
+ * получаемые вычитанием больших промежуточных сумм, могут иметь
+ * заметно большую относительную погрешность.
+ */
+class Gemm {
+public:
+    static const size_t STRASSEN_CROSSOVER = 256;  ///< Порог перехода на обычное ядро по умолчанию
+
+    /**
+     * @brief Вычислить C = A * B или C += A * B
+     * @param m Строк в A и C
+     * @param n Столбцов в B и C
+     * @param k Столбцов в A и строк в B
+     * @param a Матрица A (m x k)
+     * @param lda Шаг строки A (не меньше k)
+     * @param b Матрица B (k x n)
+     * @param ldb Шаг строки B (не меньше n)
+     * @param c Матрица C (m x n), не пересекается с A и B
+     * @param ldc Шаг строки C (не меньше n)
+     * @param accumulate Прибавить произведение к C вместо записи
+     * @param parallel Разрешить несколько потоков
+     */
+    static void multiply(size_t m, size_t n, size_t k,
+                         const double* a, size_t lda,
+                         const double* b, size_t ldb,
+                         double* c, size_t ldc,
+                         bool accumulate = false, bool parallel = true);
+
+    /**
+     * @brief Размер рабочей памяти для multiplyStrassen
+     * @param m Строк в A и C
+     * @param n Столбцов в B и C
+     * @param k Столбцов в A и строк в B
+     * @param crossover Порог перехода на обычное ядро
+     * @return Число элементов double (около 2/3 * n^2 для квадратных матриц)
+     */
+    static size_t strassenWorkspaceSize(size_t m, size_t n, size_t k, size_t crossover = STRASSEN_CROSSOVER);
+
+    /**
+     * @brief Вычислить C = A * B методом Штрассена - Винограда
+     * @param m Строк в A и C
+     * @param n Столбцов в B и C
+     * @param k Столбцов в A и строк в B
+     * @param a Матрица A (m x k)
+     * @param lda Шаг строки A (не меньше k)
+     * @param b Матрица B (k x n)
+     * @param ldb Шаг строки B (не меньше n)
+     * @param c Матрица C (m x n), не пересекается с A и B
+     * @param ldc Шаг строки C (не меньше n)
+     * @param workspace Рабочая память из strassenWorkspaceSize(m, n, k, crossover) элементов
+     * @param crossover Блоки, у которых хотя бы один размер не больше порога,
+     *        умножаются обычным ядром
+     * @param parallel Разрешить несколько потоков в обычном ядре
+     *
+     * Промежуточные суммы и произведения хранятся в квадрантах C и
+     * в рабочей памяти, других выделений памяти нет.
+     */
+    static void multiplyStrassen(size_t m, size_t n, size_t k,
+                                 const double* a, size_t lda,
+                                 const double* b, size_t ldb,
+                                 double* c, size_t ldc,
+                                 double* workspace, size_t crossover = STRASSEN_CROSSOVER,
+                                 bool parallel = true);
+};
+
+#endif // GEMM_H
@@ -0,0 +1,159 @@
+/**
+ * @file LUDecomposition.cpp
+ * @brief Реализация LU-разложения
+ */
+
+#include "LUDecomposition.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+// Конструкторы
+LUDecomposition::LUDecomposition() : size_(0), sign_(1), singular_(false) {}
+
+LUDecomposition::LUDecomposition(const Matrix& matrix) : size_(matrix.getRows()), sign_(1), singular_(false) {
+    if (!matrix.isSquare()) {
+        throw std::invalid_argument("LU-разложение существует только для квадратных матриц");
+    }
+    const size_t n = size_;
+    lu_.resize(n * n);
+    pivots_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<double>& row = matrix[i];
+        for (size_t j = 0; j < n; ++j) lu_[i * n + j] = row[j];
+        pivots_[i] = i;
+    }
+
+    // Исключение Гаусса по строкам: внутренний цикл идет по непрерывной строке
+    for (size_t k = 0; k < n; ++k) {
+        size_t pivot = k;
+        double best = std::abs(lu_[k * n + k]);
+        for (size_t i = k + 1; i < n; ++i) {
+            const double value = std::abs(lu_[i * n + k]);
+            if (value > best) {
+                best = value;
+                pivot = i;
+            }
+        }
+        if (pivot != k) {
+            for (size_t j = 0; j < n; ++j) std::swap(lu_[k * n + j], lu_[pivot * n + j]);
+            std::swap(pivots_[k], pivots_[pivot]);
+            sign_ = -sign_;
+        }
+        if (best == 0.0) {
+            singular_ = true;
+            continue;
+        }
+
+        const double* rowK = &lu_[k * n];
+        const double inv = 1.0 / rowK[k];
+        for (size_t i = k + 1; i < n; ++i) {
+            double* rowI = &lu_[i * n];
+            const double factor = rowI[k] * inv;
+            rowI[k] = factor;
+            for (size_t j = k + 1; j < n; ++j) rowI[j] -= factor * rowK[j];
+        }
+    }
+}
+
+// Методы доступа
+Matrix LUDecomposition::getLower() const {
+    Matrix result(size_, size_);
+    for (size_t i = 0; i < size_; ++i) {
+        for (size_t j = 0; j < i; ++j) result.set(i, j, lu_[i * size_ + j]);
+        result.set(i, i, 1.0);
+    }
+    return result;
+}
+
+Matrix LUDecomposition::getUpper() const {
+    Matrix result(size_, size_);
+    for (size_t i = 0; i < size_; ++i) {
+        for (size_t j = i; j < size_; ++j) result.set(i, j, lu_[i * size_ + j]);
+    }
+    return result;
+}
+
+size_t LUDecomposition::memoryUsage() const {
+    return sizeof(*this) + lu_.size() * sizeof(double) + pivots_.size() * sizeof(size_t);
+}
+
+// Операции
+double LUDecomposition::determinant() const {
+    if (singular_) return 0.0;
+    double det = static_cast<double>(sign_);
+    for (size_t i = 0; i < size_; ++i) det *= lu_[i * size_ + i];
+    return det;
+}
+
+std::vector<double> LUDecomposition::solve(const std::vector<double>& b) const {
+    if (b.size() != size_) {
+        throw std::invalid_argument("Длина правой части не совпадает с порядком матрицы");
+    }
+    if (singular_) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    const size_t n = size_;
+    std::vector<double> x(n);
+    // L * y = P * b
+    for (size_t i = 0; i < n; ++i) {
+        double sum = b[pivots_[i]];
+        const double* row = &lu_[i * n];
+        for (size_t j = 0; j < i; ++j) sum -= row[j] * x[j];
+        x[i] = sum;
+    }
+    // U * x = y
+    for (size_t i = n; i-- > 0;) {
+        double sum = x[i];
+        const double* row = &lu_[i * n];
+        for (size_t j = i + 1; j < n; ++j) sum -= row[j] * x[j];
+        x[i] = sum / row[i];
+    }
+    return x;
+}
+
+Matrix LUDecomposition::solve(const Matrix& b) const {
+    if (b.getRows() != size_) {
+        throw std::invalid_argument("Число строк правой части не совпадает с порядком матрицы");
+    }
+    if (singular_) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    const size_t n = size_;
+    const size_t m = b.getCols();
+    // Подстановки выполняются сразу для всех столбцов: строки X обновляются целиком
+    std::vector<double> x(n * m);
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<double>& src = b[pivots_[i]];
+        double* xi = &x[i * m];
+        for (size_t c = 0; c < m; ++c) xi[c] = src[c];
+        const double* row = &lu_[i * n];
+        for (size_t j = 0; j < i; ++j) {
+            const double factor = row[j];
+            const double* xj = &x[j * m];
+            for (size_t c = 0; c < m; ++c) xi[c] -= factor * xj[c];
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        double* xi = &x[i * m];
+        const double* row = &lu_[i * n];
+        for (size_t j = i + 1; j < n; ++j) {
+            const double factor = row[j];
+            const double* xj = &x[j * m];
+            for (size_t c = 0; c < m; ++c) xi[c] -= factor * xj[c];
+        }
+        const double inv = 1.0 / row[i];
+        for (size_t c = 0; c < m; ++c) xi[c] *= inv;
+    }
+
+    Matrix result(n, m);
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<double>& dst = result[i];
+        for (size_t c = 0; c < m; ++c) dst[c] = x[i * m + c];
+    }
+    return result;
+}
+
+Matrix LUDecomposition::inverse() const {
+    return solve(Matrix::identity(size_));
+}
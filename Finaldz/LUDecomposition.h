@@ -0,0 +1,98 @@
+/**
+ * @file LUDecomposition.h
+ * @brief LU-разложение квадратной матрицы с выбором ведущего элемента
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef LUDECOMPOSITION_H
+#define LUDECOMPOSITION_H
+
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * @class LUDecomposition
+ * @brief Разложение P * A = L * U с частичным выбором ведущего элемента
+ *
+ * L (единичная нижнетреугольная) и U хранятся вместе в одном непрерывном
+ * массиве по строкам. После разложения за O(n^2) вычисляются решения
+ * систем и за O(n^3) - обратная матрица; определитель берется из
+ * диагонали U без дополнительных вычислений.
+ */
+class LUDecomposition {
+private:
+    size_t size_;                 ///< Порядок матрицы
+    std::vector<double> lu_;      ///< L ниже диагонали, U на диагонали и выше
+    std::vector<size_t> pivots_;  ///< Строка исходной матрицы для каждой строки LU
+    int sign_;                    ///< Четность перестановки: +1 или -1
+    bool singular_;               ///< Встретился нулевой ведущий элемент
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает разложение пустой матрицы
+     */
+    LUDecomposition();
+
+    /**
+     * @brief Разложить матрицу
+     * @param matrix Квадратная матрица
+     * @throw std::invalid_argument если матрица не квадратная
+     */
+    explicit LUDecomposition(const Matrix& matrix);
+
+    // Методы доступа
+    size_t size() const { return size_; }
+    bool isSingular() const { return singular_; }
+    const std::vector<size_t>& getPivots() const { return pivots_; }
+
+    /**
+     * @brief Единичная нижнетреугольная матрица L
+     */
+    Matrix getLower() const;
+
+    /**
+     * @brief Верхнетреугольная матрица U
+     */
+    Matrix getUpper() const;
+
+    /**
+     * @brief Объем занимаемой памяти в байтах
+     */
+    size_t memoryUsage() const;
+
+    // Операции
+    /**
+     * @brief Определитель исходной матрицы
+     * @return Произведение диагонали U с учетом знака перестановки
+     */
+    double determinant() const;
+
+    /**
+     * @brief Решить систему A * x = b
+     * @param b Правая часть
+     * @return Решение x
+     * @throw std::invalid_argument если длина b не совпадает с порядком
+     *        или матрица вырожденная
+     */
+    std::vector<double> solve(const std::vector<double>& b) const;
+
+    /**
+     * @brief Решить систему A * X = B для нескольких правых частей
+     * @param b Матрица правых частей (по столбцам)
+     * @return Решение X
+     * @throw std::invalid_argument если число строк B не совпадает с порядком
+     *        или матрица вырожденная
+     */
+    Matrix solve(const Matrix& b) const;
+
+    /**
+     * @brief Обратная матрица
+     * @return A^-1
+     * @throw std::invalid_argument если матрица вырожденная
+     */
+    Matrix inverse() const;
+};
+
+#endif // LUDECOMPOSITION_H
@@ -20,6 +20,33 @@
  * - @ref Vector3D "Vector3D" - класс для работы с трехмерными векторами  
  * - @ref Matrix "Matrix" - класс для работы с матрицами
  * - @ref Fraction "Fraction" - класс для работы с обыкновенными дробями
+ * - @ref BoundingBox "BoundingBox" - ограничивающий параллелепипед
+ * - @ref BVH "BVH" - иерархия ограничивающих объемов для пространственных запросов
+ * - @ref SpatialHashGrid "SpatialHashGrid" - хеш-сетка для поиска пар близких частиц
+ * - @ref SpatialOrder "SpatialOrder" - упорядочивание точек вдоль кривых Мортона и Гильберта
+ * - @ref PointReduction "PointReduction" - редукции над массивами точек: сумма, границы, ковариация, главные оси
+ * - @ref AffineTransform "AffineTransform" - аффинные преобразования точек, направлений и нормалей
+ * - @ref FFT "FFT" - быстрое преобразование Фурье
+ * - @ref ComplexArray "ComplexArray" - массив комплексных чисел с раздельным хранением
+ * - @ref Convolution "Convolution" - свертка и корреляция
+ * - @ref Polynomial "Polynomial" - многочлены и поиск корней
+ * - @ref FractalRenderer "FractalRenderer" - построение фракталов
+ * - @ref ComplexInterop "ComplexInterop" - совместимость с std::complex
+ * - @ref FractionReduction "FractionReduction" - точное суммирование дробей
+ * - @ref TextIO "TextIO" - быстрый текстовый ввод-вывод
+ * - @ref MatrixFile "MatrixFile" - двоичный формат матриц и отображение в память
+ * - @ref Gemm "Gemm" - блочное умножение матриц
+ * - @ref TiledMatrix "TiledMatrix" - матрицы во внешней памяти
+ * - @ref LUDecomposition "LUDecomposition" - LU-разложение
+ * - @ref MatrixCache "MatrixCache" - кэш определителей и обратных матриц
+ * - @ref UpdatableInverse "UpdatableInverse" - обновление обратной матрицы и определителя малого ранга
+ * - @ref SmallMatrix "SmallMatrix" - определитель и обратная матрица 3x3 и 4x4
+ * - @ref MatrixBatch "MatrixBatch" - пакеты малых матриц: произведения, обращение, определители, решение систем
+ * - @ref MatrixChain "MatrixChain" - оптимальный порядок умножения цепочки матриц
+ * - @ref QuantizedMatrix "QuantizedMatrix" - квантованные матрицы int8/int16 и целочисленное умножение
+ * - @ref SymmetricMatrix "SymmetricMatrix" - упакованная симметричная матрица и SYRK
+ * - @ref TriangularMatrix "TriangularMatrix" - упакованная треугольная матрица и подстановка
+ * - @ref BandMatrix "BandMatrix" - ленточная матрица и ее LU-разложение
  * 
  * @section usage_sec Пример использования
  * 
@@ -70,6 +97,33 @@
 #include "Vector3D.h"
 #include "Matrix.h"
 #include "Fraction.h"
+#include "BoundingBox.h"
+#include "BVH.h"
+#include "SpatialHashGrid.h"
+#include "SpatialOrder.h"
+#include "PointReduction.h"
+#include "AffineTransform.h"
+#include "FFT.h"
+#include "ComplexArray.h"
+#include "Convolution.h"
+#include "Polynomial.h"
+#include "Fractal.h"
+#include "ComplexInterop.h"
+#include "FractionReduction.h"
+#include "TextIO.h"
+#include "MatrixFile.h"
+#include "Gemm.h"
+#include "TiledMatrix.h"
+#include "LUDecomposition.h"
+#include "MatrixCache.h"
+#include "UpdatableInverse.h"
+#include "SmallMatrix.h"
+#include "MatrixBatch.h"
+#include "MatrixChain.h"
+#include "QuantizedMatrix.h"
+#include "SymmetricMatrix.h"
+#include "TriangularMatrix.h"
+#include "BandMatrix.h"
 
 /**
  * @namespace MathLib
@@ -4,8 +4,100 @@
  */
 
 #include "Matrix.h"
+#include "Gemm.h"
+#include "LUDecomposition.h"
+#include "MatrixCache.h"
+#include "SmallMatrix.h"
+#include <atomic>
+#include <cstring>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+
+const size_t Matrix::DEFAULT_STRASSEN_THRESHOLD;
+
+namespace {
+
+std::atomic<size_t> strassenThreshold(Matrix::DEFAULT_STRASSEN_THRESHOLD);
+
+const size_t SMALL_PRODUCT_WORK = 16 * 16 * 16;  ///< До этого объема умножение без блочного ядра
+
+const uint64_t HASH_SEED = 0x27D4EB2F165667C5ULL;
+const uint64_t HASH_PRIME1 = 0x9E3779B185EBCA87ULL;
+const uint64_t HASH_PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+
+inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+/**
+ * @brief Раунд перемешивания в духе xxHash64
+ */
+inline uint64_t hashRound(uint64_t acc, uint64_t value) {
+    acc += value * HASH_PRIME2;
+    return rotateLeft(acc, 31) * HASH_PRIME1;
+}
+
+inline uint64_t hashFinish(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME1;
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * @brief Хэш строки: четыре независимые цепочки для параллелизма на уровне команд
+ */
+uint64_t hashRow(const std::vector<double>& row) {
+    uint64_t lanes[4] = { HASH_SEED, HASH_SEED + HASH_PRIME1, HASH_SEED - HASH_PRIME2, HASH_SEED ^ HASH_PRIME1 };
+    const size_t n = row.size();
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        for (size_t k = 0; k < 4; ++k) {
+            uint64_t bits;
+            std::memcpy(&bits, &row[j + k], sizeof(bits));
+            lanes[k] = hashRound(lanes[k], bits);
+        }
+    }
+    for (; j < n; ++j) {
+        uint64_t bits;
+        std::memcpy(&bits, &row[j], sizeof(bits));
+        lanes[0] = hashRound(lanes[0], bits);
+    }
+    return rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+}
+
+/**
+ * @brief Скопировать матрицу 3x3 или 4x4 в массив по строкам
+ */
+inline void loadSmall(const std::vector<std::vector<double>>& data, double* out) {
+    const size_t n = data.size();
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) out[i * n + j] = data[i][j];
+    }
+}
+
+/**
+ * @brief Можно ли делить на определитель 3x3/4x4
+ *
+ * Порог по абсолютной величине не годится: у масштаба 0.003 * I(4)
+ * определитель около 8e-11, а матрица хорошо обусловлена. Отвергаются
+ * только нулевой и неконечный определитель и такой, обратная величина
+ * которого переполняется.
+ */
+inline bool invertibleDeterminant(double det) {
+    return det != 0.0 && std::isfinite(det) && std::isfinite(1.0 / det);
+}
+
+inline void storeSmall(const double* values, std::vector<std::vector<double>>& data) {
+    const size_t n = data.size();
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) data[i][j] = values[i * n + j];
+    }
+}
+
+} // namespace
 
 // Конструкторы и деструктор
 Matrix::Matrix() : rows_(0), cols_(0) {}
@@ -126,23 +218,66 @@ Matrix Matrix::operator-(const Matrix& other) const {
 }
 
 Matrix Matrix::operator*(const Matrix& other) const {
+    return multiply(other, MULTIPLY_AUTO);
+}
+
+Matrix Matrix::multiply(const Matrix& other, MultiplyMethod method) const {
     if (cols_ != other.rows_) {
         throw std::invalid_argument("Несовместимые размеры для умножения матриц");
     }
     
     Matrix result(rows_, other.cols_);
-    for (size_t i = 0; i < rows_; ++i) {
-        for (size_t j = 0; j < other.cols_; ++j) {
-            double sum = 0.0;
-            for (size_t k = 0; k < cols_; ++k) {
-                sum += data_[i][k] * other.data_[k][j];
+    if (rows_ * other.cols_ * cols_ <= SMALL_PRODUCT_WORK) {
+        // Малые матрицы (3x3, 4x4) дешевле умножить на месте, без копирования
+        for (size_t i = 0; i < rows_; ++i) {
+            for (size_t j = 0; j < other.cols_; ++j) {
+                double sum = 0.0;
+                for (size_t k = 0; k < cols_; ++k) {
+                    sum += data_[i][k] * other.data_[k][j];
+                }
+                result.data_[i][j] = sum;
             }
-            result.data_[i][j] = sum;
         }
+        return result;
+    }
+
+    // Строки хранятся раздельно, поэтому операнды копируются в непрерывные
+    // буферы для блочного ядра; копирование O(n^2) против умножения O(n^3)
+    std::vector<double> a(rows_ * cols_);
+    std::vector<double> b(other.rows_ * other.cols_);
+    std::vector<double> c(rows_ * other.cols_);
+    for (size_t i = 0; i < rows_; ++i) {
+        std::copy(data_[i].begin(), data_[i].end(), a.begin() + i * cols_);
+    }
+    for (size_t i = 0; i < other.rows_; ++i) {
+        std::copy(other.data_[i].begin(), other.data_[i].end(), b.begin() + i * other.cols_);
+    }
+    if (method == MULTIPLY_AUTO) {
+        const size_t threshold = strassenThreshold.load(std::memory_order_relaxed);
+        const bool large = rows_ >= threshold && other.cols_ >= threshold && cols_ >= threshold;
+        method = large ? MULTIPLY_STRASSEN : MULTIPLY_BLOCKED;
+    }
+    if (method == MULTIPLY_STRASSEN) {
+        std::vector<double> workspace(Gemm::strassenWorkspaceSize(rows_, other.cols_, cols_));
+        Gemm::multiplyStrassen(rows_, other.cols_, cols_, &a[0], cols_, &b[0], other.cols_, &c[0], other.cols_,
+                               workspace.empty() ? nullptr : &workspace[0]);
+    } else {
+        Gemm::multiply(rows_, other.cols_, cols_, &a[0], cols_, &b[0], other.cols_, &c[0], other.cols_);
+    }
+    for (size_t i = 0; i < rows_; ++i) {
+        std::copy(c.begin() + i * other.cols_, c.begin() + (i + 1) * other.cols_, result.data_[i].begin());
     }
     return result;
 }
 
+void Matrix::setStrassenThreshold(size_t size) {
+    strassenThreshold.store(size, std::memory_order_relaxed);
+}
+
+size_t Matrix::getStrassenThreshold() {
+    return strassenThreshold.load(std::memory_order_relaxed);
+}
+
 Matrix Matrix::operator*(double scalar) const {
     Matrix result(rows_, cols_);
     for (size_t i = 0; i < rows_; ++i) {
@@ -225,26 +360,24 @@ double Matrix::determinant() const {
     if (rows_ == 2) {
         return data_[0][0] * data_[1][1] - data_[0][1] * data_[1][0];
     }
+
+    // Матрицы преобразований - по развернутым формулам
+    if (rows_ == 3 || rows_ == 4) {
+        double values[16];
+        loadSmall(data_, values);
+        return rows_ == 3 ? SmallMatrix::determinant3(values) : SmallMatrix::determinant4(values);
+    }
     
-    // Для матриц большего размера используем разложение по первой строке
+    // Для матриц большего размера - через LU-разложение
     double det = 0.0;
-    for (size_t j = 0; j < cols_; ++j) {
-        // Создаем минор
-        Matrix minor(rows_ - 1, cols_ - 1);
-        for (size_t i = 1; i < rows_; ++i) {
-            size_t minor_j = 0;
-            for (size_t k = 0; k < cols_; ++k) {
-                if (k != j) {
-                    minor.data_[i - 1][minor_j] = data_[i][k];
-                    minor_j++;
-                }
-            }
-        }
-        
-        double sign = (j % 2 == 0) ? 1.0 : -1.0;
-        det += sign * data_[0][j] * minor.determinant();
+    const bool cached = MatrixCache::applies(*this);
+    if (cached && MatrixCache::findDeterminant(*this, det)) {
+        return det;
+    }
+    det = lu().determinant();
+    if (cached) {
+        MatrixCache::storeDeterminant(*this, det);
     }
-    
     return det;
 }
 
@@ -252,14 +385,26 @@ Matrix Matrix::inverse() const {
     if (!isSquare()) {
         throw std::invalid_argument("Обратная матрица существует только для квадратных матриц");
     }
-    
-    double det = determinant();
-    if (std::abs(det) < 1e-10) {
-        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+
+    if (rows_ == 3 || rows_ == 4) {
+        double values[16];
+        double inverted[16];
+        loadSmall(data_, values);
+        const double smallDet = rows_ == 3 ? SmallMatrix::inverse3(values, inverted)
+                                           : SmallMatrix::inverse4(values, inverted);
+        if (!invertibleDeterminant(smallDet)) {
+            throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+        }
+        Matrix result(rows_, cols_);
+        storeSmall(inverted, result.data_);
+        return result;
     }
     
-    // Для простоты реализуем только для матриц 2x2
     if (rows_ == 2) {
+        const double det = determinant();
+        if (!invertibleDeterminant(det)) {
+            throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+        }
         Matrix result(2, 2);
         result.data_[0][0] = data_[1][1] / det;
         result.data_[0][1] = -data_[0][1] / det;
@@ -267,8 +412,73 @@ Matrix Matrix::inverse() const {
         result.data_[1][1] = data_[0][0] / det;
         return result;
     }
-    
-    throw std::invalid_argument("Обращение матриц размера больше 2x2 не реализовано");
+
+    const bool cached = MatrixCache::applies(*this);
+    Matrix result;
+    if (cached && MatrixCache::findInverse(*this, result)) {
+        return result;
+    }
+    // Одно разложение; вырожденность - по нулевому ведущему элементу, а не по
+    // абсолютной величине определителя, который для n x n масштабируется как s^n
+    const LUDecomposition decomposition = lu();
+    if (decomposition.isSingular()) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    result = decomposition.inverse();
+    if (cached) {
+        MatrixCache::storeInverse(*this, result);
+    }
+    return result;
+}
+
+Matrix Matrix::affineInverse() const {
+    if (!isSquare() || (rows_ != 3 && rows_ != 4)) {
+        throw std::invalid_argument("Аффинное обращение определено для матриц 3x3 и 4x4");
+    }
+    for (size_t j = 0; j + 1 < cols_; ++j) {
+        if (data_[rows_ - 1][j] != 0.0) {
+            throw std::invalid_argument("Матрица не является аффинным преобразованием");
+        }
+    }
+    if (data_[rows_ - 1][cols_ - 1] != 1.0) {
+        throw std::invalid_argument("Матрица не является аффинным преобразованием");
+    }
+
+    double values[16];
+    double inverted[16];
+    loadSmall(data_, values);
+    const double det = rows_ == 3 ? SmallMatrix::affineInverse3(values, inverted)
+                                  : SmallMatrix::affineInverse4(values, inverted);
+    if (!invertibleDeterminant(det)) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    Matrix result(rows_, cols_);
+    storeSmall(inverted, result.data_);
+    return result;
+}
+
+LUDecomposition Matrix::lu() const {
+    if (!isSquare()) {
+        throw std::invalid_argument("LU-разложение существует только для квадратных матриц");
+    }
+    const bool cached = MatrixCache::applies(*this);
+    LUDecomposition result;
+    if (cached && MatrixCache::findLU(*this, result)) {
+        return result;
+    }
+    result = LUDecomposition(*this);
+    if (cached) {
+        MatrixCache::storeLU(*this, result);
+    }
+    return result;
+}
+
+uint64_t Matrix::contentHash() const {
+    uint64_t hash = hashRound(hashRound(HASH_SEED, rows_), cols_);
+    for (size_t i = 0; i < rows_; ++i) {
+        hash = hashRound(hash, hashRow(data_[i]));
+    }
+    return hashFinish(hash);
 }
 
 Matrix Matrix::power(int power) const {
@@ -11,6 +11,9 @@
 #include <iostream>
 #include <vector>
 #include <stdexcept>
+#include <cstdint>
+
+class LUDecomposition;
 
 /**
  * @class Matrix
@@ -26,6 +29,17 @@ private:
     size_t cols_;    ///< Количество столбцов
 
 public:
+    /**
+     * @brief Алгоритм умножения матриц
+     */
+    enum MultiplyMethod {
+        MULTIPLY_AUTO,       ///< Штрассен - Виноград от порога getStrassenThreshold(), иначе блочное ядро
+        MULTIPLY_BLOCKED,    ///< Блочное ядро Gemm, O(n^3)
+        MULTIPLY_STRASSEN    ///< Штрассен - Виноград с переходом на блочное ядро (см. Gemm)
+    };
+
+    static const size_t DEFAULT_STRASSEN_THRESHOLD = 2048;  ///< Порог MULTIPLY_AUTO по умолчанию
+
     /**
      * @brief Конструктор по умолчанию
      * Создает пустую матрицу 0x0
@@ -152,6 +166,26 @@ public:
      */
     Matrix operator*(const Matrix& other) const;
 
+    /**
+     * @brief Умножение матриц выбранным алгоритмом
+     * @param other Множитель
+     * @param method Алгоритм; operator* использует MULTIPLY_AUTO
+     * @return Результат умножения
+     * @throw std::invalid_argument если размеры несовместимы для умножения
+     *
+     * Метод Штрассена - Винограда быстрее для больших матриц, но дает
+     * только нормовую оценку погрешности (см. Gemm::multiplyStrassen).
+     */
+    Matrix multiply(const Matrix& other, MultiplyMethod method) const;
+
+    /**
+     * @brief Установить порог MULTIPLY_AUTO
+     * @param size Метод Штрассена - Винограда выбирается, когда все размеры
+     *        произведения не меньше size (SIZE_MAX - никогда)
+     */
+    static void setStrassenThreshold(size_t size);
+    static size_t getStrassenThreshold();
+
     /**
      * @brief Оператор умножения на скаляр
      * @param scalar Скаляр
@@ -232,6 +266,32 @@ public:
      */
     Matrix inverse() const;
 
+    /**
+     * @brief Обратное аффинное преобразование
+     * @return Обратная матрица, вычисленная через обращение линейной части
+     * @throw std::invalid_argument если матрица не 3x3/4x4, последняя строка
+     *        не равна (0, ..., 0, 1) или линейная часть вырожденная
+     */
+    Matrix affineInverse() const;
+
+    /**
+     * @brief LU-разложение с частичным выбором ведущего элемента
+     * @return Разложение (при включенном MatrixCache берется из кэша)
+     * @throw std::invalid_argument если матрица не квадратная
+     */
+    LUDecomposition lu() const;
+
+    /**
+     * @brief Хэш содержимого и размеров матрицы
+     * @return 64-битный хэш
+     *
+     * Вычисляется заново при каждом вызове: строку, полученную через
+     * неконстантный operator[], можно изменить в любой момент, поэтому
+     * запомненный хэш мог бы устареть. Проход O(n^2) мал по сравнению
+     * с O(n^3) операций, которые экономит MatrixCache.
+     */
+    uint64_t contentHash() const;
+
     /**
      * @brief Возвести матрицу в степень
      * @param power Показатель степени
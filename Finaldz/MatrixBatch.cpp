@@ -0,0 +1,430 @@
+/**
+ * @file MatrixBatch.cpp
+ * @brief Реализация пакета малых квадратных матриц
+ */
+
+#include "MatrixBatch.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const double SINGULAR_EPSILON = 1e-10;  ///< Порог из Matrix::inverse
+const size_t CHUNK = 128;               ///< Матриц в части, обрабатываемой через буфер
+const size_t PARALLEL_BLOCK = 4096;     ///< Матриц в блоке одного потока
+
+/**
+ * @brief Обойти пакет частями по CHUNK матриц в нескольких потоках
+ * @param count Число матриц
+ * @param perMatrix Чисел буфера на одну матрицу части
+ * @param fixed Чисел буфера сверх этого (рабочая память одной матрицы)
+ * @param func Функция вида func(begin, end, scratch); рабочая память
+ *        начинается с scratch + perMatrix * CHUNK
+ *
+ * Результат части сначала пишется в буфер и копируется на место после
+ * чтения всех операндов части, поэтому результат может совпадать с
+ * операндом, а внутренние циклы не зависят от пересечения указателей.
+ */
+template <typename Func>
+void forEachChunk(size_t count, size_t perMatrix, size_t fixed, Func func) {
+    Parallel::forEachBlock(count, PARALLEL_BLOCK, [&](size_t, size_t begin, size_t end) {
+        std::vector<double> scratch(perMatrix * CHUNK + fixed);
+        for (size_t first = begin; first < end; first += CHUNK) {
+            func(first, std::min(first + CHUNK, end), scratch.data());
+        }
+    });
+}
+
+// Развернутые формулы для порядков 1-4 (матрица по строкам)
+template <size_t N> double determinantOf(const double* m);
+template <size_t N> double adjugateOf(const double* m, double* adj);
+
+template <> inline double determinantOf<1>(const double* m) {
+    return m[0];
+}
+
+template <> inline double determinantOf<2>(const double* m) {
+    return m[0] * m[3] - m[1] * m[2];
+}
+
+template <> inline double determinantOf<3>(const double* m) {
+    return m[0] * (m[4] * m[8] - m[5] * m[7])
+         + m[1] * (m[5] * m[6] - m[3] * m[8])
+         + m[2] * (m[3] * m[7] - m[4] * m[6]);
+}
+
+template <> inline double determinantOf<4>(const double* m) {
+    const double s0 = m[0] * m[5] - m[4] * m[1];
+    const double s1 = m[0] * m[6] - m[4] * m[2];
+    const double s2 = m[0] * m[7] - m[4] * m[3];
+    const double s3 = m[1] * m[6] - m[5] * m[2];
+    const double s4 = m[1] * m[7] - m[5] * m[3];
+    const double s5 = m[2] * m[7] - m[6] * m[3];
+    const double c5 = m[10] * m[15] - m[14] * m[11];
+    const double c4 = m[9] * m[15] - m[13] * m[11];
+    const double c3 = m[9] * m[14] - m[13] * m[10];
+    const double c2 = m[8] * m[15] - m[12] * m[11];
+    const double c1 = m[8] * m[14] - m[12] * m[10];
+    const double c0 = m[8] * m[13] - m[12] * m[9];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+template <> inline double adjugateOf<1>(const double* m, double* adj) {
+    adj[0] = 1.0;
+    return m[0];
+}
+
+template <> inline double adjugateOf<2>(const double* m, double* adj) {
+    adj[0] = m[3];
+    adj[1] = -m[1];
+    adj[2] = -m[2];
+    adj[3] = m[0];
+    return m[0] * m[3] - m[1] * m[2];
+}
+
+template <> inline double adjugateOf<3>(const double* m, double* adj) {
+    adj[0] = m[4] * m[8] - m[5] * m[7];
+    adj[1] = m[2] * m[7] - m[1] * m[8];
+    adj[2] = m[1] * m[5] - m[2] * m[4];
+    adj[3] = m[5] * m[6] - m[3] * m[8];
+    adj[4] = m[0] * m[8] - m[2] * m[6];
+    adj[5] = m[2] * m[3] - m[0] * m[5];
+    adj[6] = m[3] * m[7] - m[4] * m[6];
+    adj[7] = m[1] * m[6] - m[0] * m[7];
+    adj[8] = m[0] * m[4] - m[1] * m[3];
+    return m[0] * adj[0] + m[1] * adj[3] + m[2] * adj[6];
+}
+
+template <> inline double adjugateOf<4>(const double* m, double* adj) {
+    const double s0 = m[0] * m[5] - m[4] * m[1];
+    const double s1 = m[0] * m[6] - m[4] * m[2];
+    const double s2 = m[0] * m[7] - m[4] * m[3];
+    const double s3 = m[1] * m[6] - m[5] * m[2];
+    const double s4 = m[1] * m[7] - m[5] * m[3];
+    const double s5 = m[2] * m[7] - m[6] * m[3];
+    const double c5 = m[10] * m[15] - m[14] * m[11];
+    const double c4 = m[9] * m[15] - m[13] * m[11];
+    const double c3 = m[9] * m[14] - m[13] * m[10];
+    const double c2 = m[8] * m[15] - m[12] * m[11];
+    const double c1 = m[8] * m[14] - m[12] * m[10];
+    const double c0 = m[8] * m[13] - m[12] * m[9];
+
+    adj[0] = m[5] * c5 - m[6] * c4 + m[7] * c3;
+    adj[1] = -m[1] * c5 + m[2] * c4 - m[3] * c3;
+    adj[2] = m[13] * s5 - m[14] * s4 + m[15] * s3;
+    adj[3] = -m[9] * s5 + m[10] * s4 - m[11] * s3;
+    adj[4] = -m[4] * c5 + m[6] * c2 - m[7] * c1;
+    adj[5] = m[0] * c5 - m[2] * c2 + m[3] * c1;
+    adj[6] = -m[12] * s5 + m[14] * s2 - m[15] * s1;
+    adj[7] = m[8] * s5 - m[10] * s2 + m[11] * s1;
+    adj[8] = m[4] * c4 - m[5] * c2 + m[7] * c0;
+    adj[9] = -m[0] * c4 + m[1] * c2 - m[3] * c0;
+    adj[10] = m[12] * s4 - m[13] * s2 + m[15] * s0;
+    adj[11] = -m[8] * s4 + m[9] * s2 - m[11] * s0;
+    adj[12] = -m[4] * c3 + m[5] * c1 - m[6] * c0;
+    adj[13] = m[0] * c3 - m[1] * c1 + m[2] * c0;
+    adj[14] = -m[12] * s3 + m[13] * s1 - m[14] * s0;
+    adj[15] = m[8] * s3 - m[9] * s1 + m[10] * s0;
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+/**
+ * @brief Определители матриц [begin, end) порядка N
+ */
+template <size_t N>
+void determinantChunk(const double* a, size_t stride, size_t begin, size_t end, double* result) {
+    for (size_t e = begin; e < end; ++e) {
+        double m[N * N];
+        for (size_t k = 0; k < N * N; ++k) m[k] = a[k * stride + e];
+        result[e] = determinantOf<N>(m);
+    }
+}
+
+/**
+ * @brief Обратные матрицы [begin, end) порядка N в буфер (шаг end - begin)
+ * @return 1 если среди матриц есть вырожденные
+ *
+ * Вместо ветвления по вырожденности - выбор множителя: цикл остается
+ * без переходов, а вырожденные матрицы получают NaN.
+ */
+template <size_t N>
+int inverseChunk(const double* a, size_t stride, size_t begin, size_t end, double* out) {
+    const size_t len = end - begin;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    int singular = 0;
+    for (size_t e = begin; e < end; ++e) {
+        double m[N * N];
+        double adj[N * N];
+        for (size_t k = 0; k < N * N; ++k) m[k] = a[k * stride + e];
+        const double det = adjugateOf<N>(m, adj);
+        const bool bad = std::abs(det) < SINGULAR_EPSILON;
+        const double scale = bad ? nan : 1.0 / (bad ? 1.0 : det);
+        for (size_t k = 0; k < N * N; ++k) out[k * len + (e - begin)] = adj[k] * scale;
+        singular |= static_cast<int>(bad);
+    }
+    return singular;
+}
+
+/**
+ * @brief Исключение Гаусса с выбором ведущего элемента для одной матрицы
+ * @param n Порядок
+ * @param m Матрица по строкам (разрушается)
+ * @param rhs Правые части n x cols по строкам, заменяются решениями
+ * @param cols Число правых частей (0 - только определитель)
+ * @return Определитель; при нулевом ведущем элементе 0, rhs не решены
+ */
+double eliminate(size_t n, double* m, double* rhs, size_t cols) {
+    double det = 1.0;
+    for (size_t k = 0; k < n; ++k) {
+        size_t pivot = k;
+        for (size_t i = k + 1; i < n; ++i) {
+            if (std::abs(m[i * n + k]) > std::abs(m[pivot * n + k])) pivot = i;
+        }
+        if (m[pivot * n + k] == 0.0) return 0.0;
+        if (pivot != k) {
+            std::swap_ranges(m + k * n, m + (k + 1) * n, m + pivot * n);
+            std::swap_ranges(rhs + k * cols, rhs + (k + 1) * cols, rhs + pivot * cols);
+            det = -det;
+        }
+        const double diagonal = m[k * n + k];
+        det *= diagonal;
+        for (size_t i = k + 1; i < n; ++i) {
+            const double factor = m[i * n + k] / diagonal;
+            for (size_t j = k + 1; j < n; ++j) m[i * n + j] -= factor * m[k * n + j];
+            for (size_t c = 0; c < cols; ++c) rhs[i * cols + c] -= factor * rhs[k * cols + c];
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        for (size_t c = 0; c < cols; ++c) {
+            double sum = rhs[i * cols + c];
+            for (size_t j = i + 1; j < n; ++j) sum -= m[i * n + j] * rhs[j * cols + c];
+            rhs[i * cols + c] = sum / m[i * n + i];
+        }
+    }
+    return det;
+}
+
+} // namespace
+
+// Конструкторы
+MatrixBatch::MatrixBatch() : order_(0), count_(0) {}
+
+MatrixBatch::MatrixBatch(size_t order, size_t count)
+    : order_(order), count_(count), data_(order * order * count, 0.0) {}
+
+// Методы доступа
+void MatrixBatch::resize(size_t order, size_t count) {
+    order_ = order;
+    count_ = count;
+    data_.assign(order * order * count, 0.0);
+}
+
+double MatrixBatch::get(size_t index, size_t row, size_t col) const {
+    if (index >= count_ || row >= order_ || col >= order_) {
+        throw std::out_of_range("Индекс вне границ пакета");
+    }
+    return data_[(row * order_ + col) * count_ + index];
+}
+
+void MatrixBatch::set(size_t index, size_t row, size_t col, double value) {
+    if (index >= count_ || row >= order_ || col >= order_) {
+        throw std::out_of_range("Индекс вне границ пакета");
+    }
+    data_[(row * order_ + col) * count_ + index] = value;
+}
+
+Matrix MatrixBatch::getMatrix(size_t index) const {
+    if (index >= count_) {
+        throw std::out_of_range("Номер матрицы вне границ пакета");
+    }
+    Matrix result(order_, order_);
+    for (size_t i = 0; i < order_; ++i) {
+        std::vector<double>& row = result[i];
+        for (size_t j = 0; j < order_; ++j) row[j] = data_[(i * order_ + j) * count_ + index];
+    }
+    return result;
+}
+
+void MatrixBatch::setMatrix(size_t index, const Matrix& matrix) {
+    if (index >= count_) {
+        throw std::out_of_range("Номер матрицы вне границ пакета");
+    }
+    if (matrix.getRows() != order_ || matrix.getCols() != order_) {
+        throw std::invalid_argument("Размер матрицы не совпадает с порядком пакета");
+    }
+    for (size_t i = 0; i < order_; ++i) {
+        const std::vector<double>& row = matrix[i];
+        for (size_t j = 0; j < order_; ++j) data_[(i * order_ + j) * count_ + index] = row[j];
+    }
+}
+
+double* MatrixBatch::data(size_t row, size_t col) {
+    return count_ == 0 ? nullptr : &data_[(row * order_ + col) * count_];
+}
+
+const double* MatrixBatch::data(size_t row, size_t col) const {
+    return count_ == 0 ? nullptr : &data_[(row * order_ + col) * count_];
+}
+
+// Пакетные операции
+unsigned MatrixBatch::multiply(const MatrixBatch& other, MatrixBatch& result) const {
+    if (order_ != other.order_ || count_ != other.count_) {
+        return SIZE_MISMATCH;
+    }
+    if (result.order_ != order_ || result.count_ != count_) {
+        result.resize(order_, count_);
+    }
+    const size_t n = order_;
+    const size_t count = count_;
+    const double* a = data_.data();
+    const double* b = other.data_.data();
+    double* c = result.data_.data();
+
+    forEachChunk(count, n * n, 0, [&](size_t begin, size_t end, double* scratch) {
+        const size_t len = end - begin;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                double* out = scratch + (i * n + j) * len;
+                std::fill(out, out + len, 0.0);
+                for (size_t k = 0; k < n; ++k) {
+                    const double* x = a + (i * n + k) * count + begin;
+                    const double* y = b + (k * n + j) * count + begin;
+                    for (size_t w = 0; w < len; ++w) out[w] += x[w] * y[w];
+                }
+            }
+        }
+        for (size_t k = 0; k < n * n; ++k) {
+            std::copy(scratch + k * len, scratch + (k + 1) * len, c + k * count + begin);
+        }
+    });
+    return OK;
+}
+
+unsigned MatrixBatch::determinant(std::vector<double>& result) const {
+    const size_t n = order_;
+    const size_t count = count_;
+    result.resize(count);
+    const double* a = data_.data();
+    double* det = result.data();
+
+    forEachChunk(count, 0, n > 4 ? n * n : 0, [&](size_t begin, size_t end, double* scratch) {
+        switch (n) {
+        case 0: std::fill(det + begin, det + end, 1.0); break;
+        case 1: determinantChunk<1>(a, count, begin, end, det); break;
+        case 2: determinantChunk<2>(a, count, begin, end, det); break;
+        case 3: determinantChunk<3>(a, count, begin, end, det); break;
+        case 4: determinantChunk<4>(a, count, begin, end, det); break;
+        default:
+            for (size_t e = begin; e < end; ++e) {
+                for (size_t k = 0; k < n * n; ++k) scratch[k] = a[k * count + e];
+                det[e] = eliminate(n, scratch, nullptr, 0);
+            }
+        }
+    });
+    return OK;
+}
+
+unsigned MatrixBatch::inverse(MatrixBatch& result) const {
+    if (result.order_ != order_ || result.count_ != count_) {
+        result.resize(order_, count_);
+    }
+    const size_t n = order_;
+    const size_t count = count_;
+    const double* a = data_.data();
+    double* c = result.data_.data();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::atomic<int> singular(0);
+
+    // Для больших порядков рабочая память - копия матрицы и единичная матрица
+    forEachChunk(count, n * n, n > 4 ? 2 * n * n : 0, [&](size_t begin, size_t end, double* scratch) {
+        const size_t len = end - begin;
+        int bad = 0;
+        switch (n) {
+        case 0: break;
+        case 1: bad = inverseChunk<1>(a, count, begin, end, scratch); break;
+        case 2: bad = inverseChunk<2>(a, count, begin, end, scratch); break;
+        case 3: bad = inverseChunk<3>(a, count, begin, end, scratch); break;
+        case 4: bad = inverseChunk<4>(a, count, begin, end, scratch); break;
+        default: {
+            double* m = scratch + n * n * CHUNK;
+            double* inv = m + n * n;
+            for (size_t e = begin; e < end; ++e) {
+                for (size_t k = 0; k < n * n; ++k) {
+                    m[k] = a[k * count + e];
+                    inv[k] = k % (n + 1) == 0 ? 1.0 : 0.0;
+                }
+                const bool singularEntry = std::abs(eliminate(n, m, inv, n)) < SINGULAR_EPSILON;
+                for (size_t k = 0; k < n * n; ++k) scratch[k * len + (e - begin)] = singularEntry ? nan : inv[k];
+                bad |= static_cast<int>(singularEntry);
+            }
+        }
+        }
+        for (size_t k = 0; k < n * n; ++k) {
+            std::copy(scratch + k * len, scratch + (k + 1) * len, c + k * count + begin);
+        }
+        if (bad) singular = 1;
+    });
+    return singular ? SINGULAR : OK;
+}
+
+unsigned MatrixBatch::solve(const std::vector<double>& b, std::vector<double>& x) const {
+    const size_t n = order_;
+    const size_t count = count_;
+    if (b.size() != n * count) {
+        return SIZE_MISMATCH;
+    }
+    if (&x != &b) {
+        x.resize(n * count);
+    }
+    const double* a = data_.data();
+    const double* rhs = b.data();
+    double* out = x.data();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::atomic<int> singular(0);
+
+    // Буфер: обратные матрицы (n <= 4) и решения; для больших порядков
+    // рабочая память - копия матрицы и правой части
+    forEachChunk(count, n * n + n, n > 4 ? n * n + n : 0, [&](size_t begin, size_t end, double* scratch) {
+        const size_t len = end - begin;
+        double* solution = scratch + n * n * len;
+        int bad = 0;
+        if (n <= 4) {
+            switch (n) {
+            case 0: break;
+            case 1: bad = inverseChunk<1>(a, count, begin, end, scratch); break;
+            case 2: bad = inverseChunk<2>(a, count, begin, end, scratch); break;
+            case 3: bad = inverseChunk<3>(a, count, begin, end, scratch); break;
+            case 4: bad = inverseChunk<4>(a, count, begin, end, scratch); break;
+            }
+            // x = A^-1 * b по всем матрицам части
+            for (size_t i = 0; i < n; ++i) {
+                double* xi = solution + i * len;
+                std::fill(xi, xi + len, 0.0);
+                for (size_t j = 0; j < n; ++j) {
+                    const double* inv = scratch + (i * n + j) * len;
+                    const double* bj = rhs + j * count + begin;
+                    for (size_t w = 0; w < len; ++w) xi[w] += inv[w] * bj[w];
+                }
+            }
+        } else {
+            double* m = scratch + (n * n + n) * CHUNK;
+            double* column = m + n * n;
+            for (size_t e = begin; e < end; ++e) {
+                for (size_t k = 0; k < n * n; ++k) m[k] = a[k * count + e];
+                for (size_t i = 0; i < n; ++i) column[i] = rhs[i * count + e];
+                const bool singularEntry = std::abs(eliminate(n, m, column, 1)) < SINGULAR_EPSILON;
+                for (size_t i = 0; i < n; ++i) solution[i * len + (e - begin)] = singularEntry ? nan : column[i];
+                bad |= static_cast<int>(singularEntry);
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(solution + i * len, solution + (i + 1) * len, out + i * count + begin);
+        }
+        if (bad) singular = 1;
+    });
+    return singular ? SINGULAR : OK;
+}
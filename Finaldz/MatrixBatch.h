@@ -0,0 +1,141 @@
+/**
+ * @file MatrixBatch.h
+ * @brief Пакет малых квадратных матриц с чередующимся хранением
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef MATRIXBATCH_H
+#define MATRIXBATCH_H
+
+#include <vector>
+#include <cstddef>
+#include "Matrix.h"
+
+/**
+ * @class MatrixBatch
+ * @brief Пакет из count квадратных матриц порядка order в раскладке SoA
+ *
+ * Элемент (i, j) всех матриц пакета хранится в одном непрерывном
+ * массиве длины count: элемент (i, j) матрицы e лежит по индексу
+ * (i * order + j) * count + e. Поэтому операции над пакетом - это циклы
+ * по номеру матрицы с одинаковой последовательностью действий для всех
+ * матриц, которые компилятор векторизует, а не вызовы Matrix на каждую
+ * пару с выделением памяти и проверкой границ на каждом элементе.
+ *
+ * Для порядков 1-4 определитель, обратная матрица и решение систем
+ * вычисляются по развернутым формулам без ветвлений; для больших
+ * порядков - исключением Гаусса с выбором ведущего элемента отдельно
+ * для каждой матрицы. Пакет обрабатывается частями в нескольких
+ * потоках через Parallel::forEachBlock.
+ *
+ * Как и у ComplexArray, пакетные операции не бросают исключений на данных
+ * и возвращают флаги ошибок (см. ErrorFlags), объединяемые побитовым ИЛИ.
+ */
+class MatrixBatch {
+public:
+    /**
+     * @brief Флаги ошибок пакетных операций
+     */
+    enum ErrorFlags {
+        OK = 0,                ///< Ошибок нет
+        SIZE_MISMATCH = 1,     ///< Порядки или длины операндов различаются, результат не вычислен
+        SINGULAR = 2           ///< Есть вырожденные матрицы, их результаты равны NaN
+    };
+
+private:
+    size_t order_;              ///< Порядок матриц
+    size_t count_;              ///< Число матриц в пакете
+    std::vector<double> data_;  ///< order * order массивов по count чисел
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустой пакет
+     */
+    MatrixBatch();
+
+    /**
+     * @brief Создать пакет нулевых матриц
+     * @param order Порядок матриц
+     * @param count Число матриц
+     */
+    MatrixBatch(size_t order, size_t count);
+
+    // Методы доступа
+    size_t order() const { return order_; }
+    size_t count() const { return count_; }
+
+    /**
+     * @brief Изменить порядок и число матриц (все элементы обнуляются)
+     */
+    void resize(size_t order, size_t count);
+
+    /**
+     * @brief Получить элемент (row, col) матрицы index
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t index, size_t row, size_t col) const;
+
+    /**
+     * @brief Установить элемент (row, col) матрицы index
+     * @throw std::out_of_range если индексы вне границ
+     */
+    void set(size_t index, size_t row, size_t col, double value);
+
+    /**
+     * @brief Получить матрицу пакета
+     * @throw std::out_of_range если номер вне границ
+     */
+    Matrix getMatrix(size_t index) const;
+
+    /**
+     * @brief Записать матрицу в пакет
+     * @throw std::out_of_range если номер вне границ
+     * @throw std::invalid_argument если размер матрицы не order x order
+     */
+    void setMatrix(size_t index, const Matrix& matrix);
+
+    /**
+     * @brief Массив элементов (row, col) всех матриц пакета
+     * @return Указатель на count() чисел (нулевой для пустого пакета)
+     */
+    double* data(size_t row, size_t col);
+    const double* data(size_t row, size_t col) const;
+
+    // Пакетные операции
+    /**
+     * @brief Попарные произведения: result[e] = this[e] * other[e]
+     * @param other Второй операнд
+     * @param result Результат (размер устанавливается, может совпадать с операндами)
+     * @return Флаги ошибок
+     */
+    unsigned multiply(const MatrixBatch& other, MatrixBatch& result) const;
+
+    /**
+     * @brief Определители всех матриц
+     * @param result Результат длины count() (размер устанавливается)
+     * @return Флаги ошибок
+     */
+    unsigned determinant(std::vector<double>& result) const;
+
+    /**
+     * @brief Обратные матрицы
+     * @param result Результат (размер устанавливается, может совпадать с this)
+     * @return Флаги ошибок; вырожденные матрицы дают SINGULAR и NaN
+     *
+     * Порог вырожденности тот же, что у Matrix::inverse.
+     */
+    unsigned inverse(MatrixBatch& result) const;
+
+    /**
+     * @brief Решить системы this[e] * x[e] = b[e]
+     * @param b Правые части: order() массивов по count() чисел,
+     *        компонента i системы e лежит по индексу i * count + e
+     * @param x Решения в той же раскладке (размер устанавливается, может совпадать с b)
+     * @return Флаги ошибок; вырожденные матрицы дают SINGULAR и NaN
+     */
+    unsigned solve(const std::vector<double>& b, std::vector<double>& x) const;
+};
+
+#endif // MATRIXBATCH_H
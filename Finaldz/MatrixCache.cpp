@@ -0,0 +1,336 @@
+/**
+ * @file MatrixCache.cpp
+ * @brief Реализация кэша определителей, обратных матриц и разложений
+ */
+
+#include "MatrixCache.h"
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+const size_t MatrixCache::MIN_SIZE;
+const size_t MatrixCache::DEFAULT_CAPACITY;
+
+namespace {
+
+/**
+ * @brief Ключ записи: хэш содержимого и размеры
+ */
+struct Key {
+    uint64_t hash;
+    size_t rows;
+    size_t cols;
+
+    bool operator==(const Key& other) const {
+        return hash == other.hash && rows == other.rows && cols == other.cols;
+    }
+};
+
+struct KeyHasher {
+    size_t operator()(const Key& key) const {
+        return static_cast<size_t>(key.hash ^ (key.rows * 0x9E3779B97F4A7C15ULL) ^ key.cols);
+    }
+};
+
+/**
+ * @brief Запись кэша со всеми результатами, уже вычисленными для матрицы
+ */
+struct Entry {
+    Key key;
+    std::shared_ptr<const Matrix> source;  ///< Копия матрицы для проверки при попадании
+    bool hasDeterminant;
+    double determinant;
+    std::shared_ptr<const Matrix> inverse;
+    std::shared_ptr<const LUDecomposition> lu;
+    size_t bytes;
+};
+
+size_t matrixBytes(const Matrix& matrix) {
+    return sizeof(Matrix) + matrix.getRows() * (sizeof(std::vector<double>) + matrix.getCols() * sizeof(double));
+}
+
+/**
+ * @brief Побитовое совпадение содержимого
+ *
+ * Совпадение ключей еще не означает совпадения матриц: 64-битный хэш
+ * может совпасть и у разных. Сравнение по битам, а не через ==, отличает
+ * 0.0 от -0.0 и считает одинаковыми NaN с равными битами, как и хэш.
+ */
+bool sameContent(const Matrix& a, const Matrix& b) {
+    if (a.getRows() != b.getRows() || a.getCols() != b.getCols()) return false;
+    const size_t bytes = a.getCols() * sizeof(double);
+    for (size_t i = 0; i < a.getRows(); ++i) {
+        if (std::memcmp(a[i].data(), b[i].data(), bytes) != 0) return false;
+    }
+    return true;
+}
+
+size_t entryBytes(const Entry& entry) {
+    size_t bytes = sizeof(Entry) + 2 * sizeof(void*);  // узлы списка и таблицы
+    bytes += matrixBytes(*entry.source);
+    if (entry.inverse) bytes += matrixBytes(*entry.inverse);
+    if (entry.lu) bytes += entry.lu->memoryUsage();
+    return bytes;
+}
+
+/**
+ * @brief Состояние кэша: список от недавно использованных к давно
+ *        использованным и индекс по ключу
+ */
+struct CacheState {
+    std::mutex mutex;
+    std::atomic<bool> enabled;
+    size_t capacity;
+    size_t usage;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHasher> index;
+
+    CacheState()
+        : enabled(false), capacity(MatrixCache::DEFAULT_CAPACITY), usage(0),
+          hits(0), misses(0), evictions(0) {}
+
+    void clear() {
+        entries.clear();
+        index.clear();
+        usage = 0;
+    }
+
+    /**
+     * @brief Найти запись для матрицы и сделать ее самой недавней
+     * @return nullptr, если записи нет или ключ совпал у другой матрицы
+     */
+    Entry* find(const Key& key, const Matrix& matrix) {
+        auto it = index.find(key);
+        if (it == index.end() || !sameContent(*it->second->source, matrix)) return nullptr;
+        entries.splice(entries.begin(), entries, it->second);
+        return &entries.front();
+    }
+
+    /**
+     * @brief Найти или создать запись и сделать ее самой недавней
+     * @param source Копия матрицы; запись другой матрицы с тем же ключом заменяется
+     */
+    Entry& touch(const Key& key, const std::shared_ptr<const Matrix>& source) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            if (sameContent(*it->second->source, *source)) {
+                entries.splice(entries.begin(), entries, it->second);
+                return entries.front();
+            }
+            remove(it->second);
+        }
+        Entry entry;
+        entry.key = key;
+        entry.source = source;
+        entry.hasDeterminant = false;
+        entry.determinant = 0.0;
+        entry.bytes = entryBytes(entry);
+        entries.push_front(entry);
+        index[key] = entries.begin();
+        usage += entry.bytes;
+        return entries.front();
+    }
+
+    void remove(std::list<Entry>::iterator it) {
+        usage -= it->bytes;
+        index.erase(it->key);
+        entries.erase(it);
+    }
+
+    /**
+     * @brief Пересчитать объем записи и вытеснить давние записи сверх лимита
+     */
+    void update(Entry& entry) {
+        usage -= entry.bytes;
+        entry.bytes = entryBytes(entry);
+        usage += entry.bytes;
+        while (usage > capacity && !entries.empty()) {
+            remove(std::prev(entries.end()));
+            ++evictions;
+        }
+    }
+};
+
+CacheState& state() {
+    static CacheState instance;
+    return instance;
+}
+
+Key makeKey(const Matrix& matrix) {
+    Key key = { matrix.contentHash(), matrix.getRows(), matrix.getCols() };
+    return key;
+}
+
+} // namespace
+
+// Управление
+void MatrixCache::setEnabled(bool enabled) {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.enabled = enabled;
+    if (!enabled) s.clear();
+}
+
+bool MatrixCache::isEnabled() {
+    return state().enabled;
+}
+
+void MatrixCache::setCapacity(size_t bytes) {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.capacity = bytes;
+    while (s.usage > s.capacity && !s.entries.empty()) {
+        s.remove(std::prev(s.entries.end()));
+        ++s.evictions;
+    }
+}
+
+size_t MatrixCache::getCapacity() {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.capacity;
+}
+
+void MatrixCache::clear() {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.clear();
+}
+
+// Статистика
+uint64_t MatrixCache::hits() {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.hits;
+}
+
+uint64_t MatrixCache::misses() {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.misses;
+}
+
+uint64_t MatrixCache::evictions() {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.evictions;
+}
+
+size_t MatrixCache::entryCount() {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.entries.size();
+}
+
+size_t MatrixCache::memoryUsage() {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.usage;
+}
+
+void MatrixCache::resetCounters() {
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.hits = s.misses = s.evictions = 0;
+}
+
+bool MatrixCache::applies(const Matrix& matrix) {
+    return state().enabled && matrix.getRows() >= MIN_SIZE && matrix.getCols() >= MIN_SIZE;
+}
+
+// Поиск и сохранение
+bool MatrixCache::findDeterminant(const Matrix& matrix, double& value) {
+    const Key key = makeKey(matrix);
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    Entry* entry = s.find(key, matrix);
+    if (entry && entry->hasDeterminant) {
+        value = entry->determinant;
+        ++s.hits;
+        return true;
+    }
+    ++s.misses;
+    return false;
+}
+
+bool MatrixCache::findInverse(const Matrix& matrix, Matrix& value) {
+    const Key key = makeKey(matrix);
+    std::shared_ptr<const Matrix> found;
+    {
+        CacheState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        Entry* entry = s.find(key, matrix);
+        if (entry && entry->inverse) {
+            found = entry->inverse;
+            ++s.hits;
+        } else {
+            ++s.misses;
+        }
+    }
+    // Копирование - вне блокировки
+    if (!found) return false;
+    value = *found;
+    return true;
+}
+
+bool MatrixCache::findLU(const Matrix& matrix, LUDecomposition& value) {
+    const Key key = makeKey(matrix);
+    std::shared_ptr<const LUDecomposition> found;
+    {
+        CacheState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        Entry* entry = s.find(key, matrix);
+        if (entry && entry->lu) {
+            found = entry->lu;
+            ++s.hits;
+        } else {
+            ++s.misses;
+        }
+    }
+    if (!found) return false;
+    value = *found;
+    return true;
+}
+
+void MatrixCache::storeDeterminant(const Matrix& matrix, double value) {
+    const Key key = makeKey(matrix);
+    const std::shared_ptr<const Matrix> source(new Matrix(matrix));
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.enabled) return;
+    Entry& entry = s.touch(key, source);
+    entry.hasDeterminant = true;
+    entry.determinant = value;
+    s.update(entry);
+}
+
+void MatrixCache::storeInverse(const Matrix& matrix, const Matrix& value) {
+    const Key key = makeKey(matrix);
+    const std::shared_ptr<const Matrix> source(new Matrix(matrix));
+    std::shared_ptr<const Matrix> copy(new Matrix(value));
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.enabled) return;
+    Entry& entry = s.touch(key, source);
+    entry.inverse = copy;
+    s.update(entry);
+}
+
+void MatrixCache::storeLU(const Matrix& matrix, const LUDecomposition& value) {
+    const Key key = makeKey(matrix);
+    const std::shared_ptr<const Matrix> source(new Matrix(matrix));
+    std::shared_ptr<const LUDecomposition> copy(new LUDecomposition(value));
+    CacheState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.enabled) return;
+    Entry& entry = s.touch(key, source);
+    entry.lu = copy;
+    s.update(entry);
+}
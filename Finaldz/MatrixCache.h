@@ -0,0 +1,106 @@
+/**
+ * @file MatrixCache.h
+ * @brief Кэш определителей, обратных матриц и разложений
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef MATRIXCACHE_H
+#define MATRIXCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Matrix.h"
+#include "LUDecomposition.h"
+
+/**
+ * @class MatrixCache
+ * @brief Ограниченный по объему LRU-кэш результатов, вычисленных по матрице
+ *
+ * Кэш по умолчанию выключен и включается setEnabled(true). Ключ записи -
+ * размеры матрицы и 64-битный хэш ее содержимого (Matrix::contentHash),
+ * поэтому разные объекты с одинаковыми элементами разделяют одну запись.
+ * Хэш считается при каждом обращении, так что после любого изменения
+ * матрицы (в том числе через сохраненную ссылку на строку из operator[])
+ * запрос идет уже по новому ключу. Старая запись вытесняется по мере
+ * заполнения.
+ *
+ * Запись хранит копию исходной матрицы, и при совпадении ключа содержимое
+ * сравнивается с ней побитово: коллизия хэша дает промах, а не результат
+ * для другой матрицы. Копия учитывается в объеме записи.
+ *
+ * Запись хранит все уже вычисленные результаты для матрицы:
+ * определитель, обратную матрицу и LU-разложение. Matrix::determinant(),
+ * inverse() и lu() обращаются к кэшу сами; матрицы меньше MIN_SIZE x MIN_SIZE
+ * не кэшируются - прямое вычисление для них дешевле хэширования.
+ *
+ * Все методы потокобезопасны.
+ */
+class MatrixCache {
+public:
+    static const size_t MIN_SIZE = 5;                              ///< Наименьший кэшируемый порядок
+    static const size_t DEFAULT_CAPACITY = 64u * 1024u * 1024u;    ///< Объем по умолчанию, байт
+
+    // Управление
+    /**
+     * @brief Включить или выключить кэш
+     * @param enabled true - кэшировать результаты
+     *
+     * Выключение очищает кэш; счетчики сохраняются.
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * @brief Установить наибольший объем кэша
+     * @param bytes Объем в байтах; лишние записи вытесняются сразу
+     */
+    static void setCapacity(size_t bytes);
+    static size_t getCapacity();
+
+    /**
+     * @brief Удалить все записи
+     */
+    static void clear();
+
+    // Статистика
+    static uint64_t hits();           ///< Запросов, найденных в кэше
+    static uint64_t misses();         ///< Запросов, не найденных в кэше
+    static uint64_t evictions();      ///< Записей, вытесненных из-за объема
+    static size_t entryCount();       ///< Записей в кэше
+    static size_t memoryUsage();      ///< Занятый объем, байт
+
+    /**
+     * @brief Обнулить счетчики попаданий, промахов и вытеснений
+     */
+    static void resetCounters();
+
+    // Поиск и сохранение (используются Matrix)
+    /**
+     * @brief Найти определитель матрицы
+     * @param matrix Матрица
+     * @param value Найденное значение
+     * @return true при попадании
+     */
+    static bool findDeterminant(const Matrix& matrix, double& value);
+    static bool findInverse(const Matrix& matrix, Matrix& value);
+    static bool findLU(const Matrix& matrix, LUDecomposition& value);
+
+    /**
+     * @brief Сохранить определитель матрицы
+     * @param matrix Матрица
+     * @param value Значение
+     */
+    static void storeDeterminant(const Matrix& matrix, double value);
+    static void storeInverse(const Matrix& matrix, const Matrix& value);
+    static void storeLU(const Matrix& matrix, const LUDecomposition& value);
+
+    /**
+     * @brief Подлежит ли матрица кэшированию
+     * @param matrix Матрица
+     * @return true если кэш включен и матрица не меньше MIN_SIZE x MIN_SIZE
+     */
+    static bool applies(const Matrix& matrix);
+};
+
+#endif // MATRIXCACHE_H
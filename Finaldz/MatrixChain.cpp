@@ -0,0 +1,138 @@
+/**
+ * @file MatrixChain.cpp
+ * @brief Реализация умножения цепочки матриц
+ */
+
+#include "MatrixChain.h"
+#include "Parallel.h"
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const uint64_t CHAIN_PARALLEL_WORK = 2ull * 64 * 64 * 64;  ///< Меньшие поддеревья считаются в одном потоке
+
+uint64_t productFlops(size_t m, size_t k, size_t n) {
+    return 2ull * m * k * n;
+}
+
+/**
+ * @brief Данные для рекурсивного вычисления по плану
+ */
+struct ChainContext {
+    const std::vector<std::reference_wrapper<const Matrix>>& factors;
+    const MatrixChain::Plan& plan;
+    const std::vector<uint64_t>& cost;
+
+    size_t split(size_t i, size_t j) const { return plan.split[i * plan.size() + j]; }
+    uint64_t costOf(size_t i, size_t j) const { return cost[i * plan.size() + j]; }
+};
+
+/**
+ * @brief Произведение Ai * ... * Aj (i < j)
+ *
+ * Одиночные множители используются по ссылке, без копирования.
+ */
+Matrix evaluate(const ChainContext& context, size_t i, size_t j) {
+    const size_t k = context.split(i, j);
+    const bool leftLeaf = i == k;
+    const bool rightLeaf = k + 1 == j;
+    Matrix left;
+    Matrix right;
+    const bool parallel = !leftLeaf && !rightLeaf &&
+                          context.costOf(i, k) >= CHAIN_PARALLEL_WORK &&
+                          context.costOf(k + 1, j) >= CHAIN_PARALLEL_WORK;
+    Parallel::invoke([&]() { if (!leftLeaf) left = evaluate(context, i, k); },
+                     [&]() { if (!rightLeaf) right = evaluate(context, k + 1, j); },
+                     parallel);
+    const Matrix& a = leftLeaf ? context.factors[i].get() : left;
+    const Matrix& b = rightLeaf ? context.factors[j].get() : right;
+    return a * b;
+}
+
+void appendOrder(const MatrixChain::Plan& plan, size_t i, size_t j, std::string& out) {
+    if (i == j) {
+        out += "A" + std::to_string(i);
+        return;
+    }
+    const size_t k = plan.split[i * plan.size() + j];
+    out += '(';
+    appendOrder(plan, i, k, out);
+    out += " * ";
+    appendOrder(plan, k + 1, j, out);
+    out += ')';
+}
+
+/**
+ * @brief Динамическое программирование по длине подцепочки
+ * @param plan План с заполненными dims; заполняются split и flops
+ * @param cost Стоимость каждой подцепочки (n * n)
+ */
+void solveChain(MatrixChain::Plan& plan, std::vector<uint64_t>& cost) {
+    const size_t n = plan.size();
+    const std::vector<size_t>& d = plan.dims;
+    cost.assign(n * n, 0);
+    plan.split.assign(n * n, 0);
+    for (size_t length = 2; length <= n; ++length) {
+        for (size_t i = 0; i + length <= n; ++i) {
+            const size_t j = i + length - 1;
+            uint64_t best = std::numeric_limits<uint64_t>::max();
+            size_t bestSplit = i;
+            for (size_t k = i; k < j; ++k) {
+                const uint64_t value = cost[i * n + k] + cost[(k + 1) * n + j] + productFlops(d[i], d[k + 1], d[j + 1]);
+                if (value < best) {
+                    best = value;
+                    bestSplit = k;
+                }
+            }
+            cost[i * n + j] = best;
+            plan.split[i * n + j] = bestSplit;
+        }
+    }
+    plan.flops = cost[n - 1];
+
+    plan.leftToRightFlops = 0;
+    for (size_t k = 1; k < n; ++k) {
+        plan.leftToRightFlops += productFlops(d[0], d[k], d[k + 1]);
+    }
+}
+
+} // namespace
+
+std::string MatrixChain::Plan::toString() const {
+    std::string result;
+    if (size() > 0) appendOrder(*this, 0, size() - 1, result);
+    return result;
+}
+
+MatrixChain::Plan MatrixChain::plan(const std::vector<size_t>& dims) {
+    if (dims.size() < 2) {
+        throw std::invalid_argument("Для цепочки матриц нужно не меньше двух размеров");
+    }
+    Plan result;
+    result.dims = dims;
+    std::vector<uint64_t> cost;
+    solveChain(result, cost);
+    return result;
+}
+
+Matrix MatrixChain::multiplyChain(const std::vector<std::reference_wrapper<const Matrix>>& factors, Plan* plan) {
+    if (factors.empty()) {
+        throw std::invalid_argument("Цепочка матриц пуста");
+    }
+    Plan chain;
+    chain.dims.push_back(factors[0].get().getRows());
+    for (size_t i = 0; i < factors.size(); ++i) {
+        if (factors[i].get().getRows() != chain.dims.back()) {
+            throw std::invalid_argument("Несовместимые размеры для умножения матриц");
+        }
+        chain.dims.push_back(factors[i].get().getCols());
+    }
+    std::vector<uint64_t> cost;
+    solveChain(chain, cost);
+    if (plan) *plan = chain;
+
+    if (factors.size() == 1) return factors[0].get();
+    const ChainContext context = { factors, chain, cost };
+    return evaluate(context, 0, factors.size() - 1);
+}
@@ -0,0 +1,80 @@
+/**
+ * @file MatrixChain.h
+ * @brief Оптимальный порядок умножения цепочки матриц
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef MATRIXCHAIN_H
+#define MATRIXCHAIN_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * @class MatrixChain
+ * @brief Произведение A0 * A1 * ... * An-1 с наилучшей расстановкой скобок
+ *
+ * operator* вычисляет A * B * C * D слева направо, и при сильно
+ * различающихся размерах это может стоить на порядки больше операций,
+ * чем необходимо: (10x1000 * 1000x10) * 10x1000 требует 4 * 10^5
+ * операций, а 10x1000 * (1000x10 * 10x1000) - 4 * 10^7.
+ *
+ * Порядок выбирается динамическим программированием за O(n^3) по одним
+ * размерам матриц. Независимые подпроизведения дерева (левое и правое
+ * поддерево одного узла) вычисляются параллельно через Parallel::invoke.
+ *
+ * Стоимость считается как 2 * m * k * n операций с плавающей точкой
+ * (умножение и сложение) на произведение m x k и k x n.
+ */
+class MatrixChain {
+public:
+    /**
+     * @brief План вычисления цепочки
+     */
+    struct Plan {
+        std::vector<size_t> dims;    ///< Матрица i имеет размер dims[i] x dims[i + 1]
+        std::vector<size_t> split;   ///< split[i * n + j]: (Ai..Ak)(Ak+1..Aj) для k = split
+        uint64_t flops;              ///< Операций в выбранном порядке
+        uint64_t leftToRightFlops;   ///< Операций при вычислении слева направо
+
+        /**
+         * @brief Число матриц в цепочке
+         */
+        size_t size() const { return dims.empty() ? 0 : dims.size() - 1; }
+
+        /**
+         * @brief Сэкономлено операций относительно порядка слева направо
+         */
+        uint64_t savedFlops() const { return leftToRightFlops - flops; }
+
+        /**
+         * @brief Расстановка скобок, например "((A0 * A1) * A2)"
+         */
+        std::string toString() const;
+    };
+
+    /**
+     * @brief Построить план по размерам
+     * @param dims Размеры: n + 1 чисел для n матриц
+     * @return План с оптимальной расстановкой скобок
+     * @throw std::invalid_argument если задано меньше двух чисел
+     */
+    static Plan plan(const std::vector<size_t>& dims);
+
+    /**
+     * @brief Перемножить цепочку матриц в оптимальном порядке
+     * @param factors Множители, например multiplyChain({a, b, c}); не копируются
+     * @param plan Если не нулевой, сюда записывается использованный план
+     * @return Произведение
+     * @throw std::invalid_argument если цепочка пуста или размеры соседних
+     *        множителей несовместимы
+     */
+    static Matrix multiplyChain(const std::vector<std::reference_wrapper<const Matrix>>& factors,
+                                Plan* plan = nullptr);
+};
+
+#endif // MATRIXCHAIN_H
@@ -0,0 +1,316 @@
+/**
+ * @file MatrixFile.cpp
+ * @brief Реализация двоичного формата матриц и отображения файлов в память
+ */
+
+#include "MatrixFile.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const uint32_t MatrixFile::VERSION;
+const size_t MatrixFile::ALIGNMENT;
+
+namespace {
+
+const char MAGIC[8] = { 'F', 'D', 'Z', 'M', 'A', 'T', 'R', 'X' };
+const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+const uint32_t BYTE_ORDER_SWAPPED = 0x04030201u;
+const uint32_t DTYPE_FLOAT64 = 1;
+
+/**
+ * @brief Заголовок файла, 64 байта
+ */
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t dtype;
+    uint32_t headerSize;
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t payloadOffset;
+    uint64_t checksum;
+    uint64_t reserved;
+};
+
+static_assert(sizeof(Header) == MatrixFile::ALIGNMENT, "Заголовок должен занимать 64 байта");
+
+uint32_t swap32(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0x0000FF00u) | ((v << 8) & 0x00FF0000u) | (v << 24);
+}
+
+uint64_t swap64(uint64_t v) {
+    return (static_cast<uint64_t>(swap32(static_cast<uint32_t>(v))) << 32) | swap32(static_cast<uint32_t>(v >> 32));
+}
+
+/**
+ * @brief Накопитель суммы Флетчера по 64-битным словам (по модулю 2^64)
+ */
+struct Fletcher {
+    uint64_t a;
+    uint64_t b;
+
+    Fletcher() : a(0), b(0) {}
+
+    void update(const double* data, size_t count) {
+        uint64_t sa = a;
+        uint64_t sb = b;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            sa += word;
+            sb += sa;
+        }
+        a = sa;
+        b = sb;
+    }
+
+    uint64_t value() const {
+        return a ^ (b * 0x9E3779B97F4A7C15ULL);
+    }
+};
+
+/**
+ * @brief Проверить заголовок и привести его поля к порядку байтов системы
+ * @param header Заголовок
+ * @param fileSize Размер файла в байтах
+ * @param path Путь для сообщений об ошибках
+ * @return true если файл записан с другим порядком байтов
+ */
+bool validateHeader(Header& header, uint64_t fileSize, const std::string& path) {
+    if (fileSize < sizeof(Header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Файл не содержит матрицу в двоичном формате: " + path);
+    }
+    bool swapped = false;
+    if (header.byteOrder == BYTE_ORDER_SWAPPED) {
+        swapped = true;
+        header.version = swap32(header.version);
+        header.dtype = swap32(header.dtype);
+        header.headerSize = swap32(header.headerSize);
+        header.rows = swap64(header.rows);
+        header.cols = swap64(header.cols);
+        header.payloadOffset = swap64(header.payloadOffset);
+        header.checksum = swap64(header.checksum);
+    } else if (header.byteOrder != BYTE_ORDER_MARK) {
+        throw std::runtime_error("Неизвестный порядок байтов в файле матрицы: " + path);
+    }
+    if (header.version == 0 || header.version > MatrixFile::VERSION) {
+        throw std::runtime_error("Неподдерживаемая версия формата матрицы: " + path);
+    }
+    if (header.dtype != DTYPE_FLOAT64) {
+        throw std::runtime_error("Неподдерживаемый тип элементов матрицы: " + path);
+    }
+
+    // Размеры проверяются до умножения, чтобы поврежденный заголовок не вызвал переполнения
+    const uint64_t maxElements = (fileSize - sizeof(Header)) / sizeof(double);
+    if (header.headerSize < sizeof(Header) || header.payloadOffset < header.headerSize ||
+        header.payloadOffset % MatrixFile::ALIGNMENT != 0 || header.payloadOffset > fileSize ||
+        (header.cols != 0 && header.rows > maxElements / header.cols) ||
+        header.payloadOffset + header.rows * header.cols * sizeof(double) > fileSize) {
+        throw std::runtime_error("Размер файла не соответствует заголовку матрицы: " + path);
+    }
+    if (header.rows * header.cols > static_cast<uint64_t>(static_cast<size_t>(-1)) / sizeof(double)) {
+        throw std::runtime_error("Матрица слишком велика для адресного пространства: " + path);
+    }
+    return swapped;
+}
+
+/**
+ * @brief Отобразить файл целиком только для чтения
+ * @param path Путь к файлу
+ * @param size Размер файла (выход)
+ * @return Владелец отображения, освобождающий его при удалении
+ */
+std::shared_ptr<const void> mapFile(const std::string& path, uint64_t& size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Не удалось открыть файл: " + path);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error("Не удалось определить размер файла: " + path);
+    }
+    size = static_cast<uint64_t>(fileSize.QuadPart);
+    if (size == 0) {
+        CloseHandle(file);
+        throw std::runtime_error("Файл не содержит матрицу в двоичном формате: " + path);
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        throw std::runtime_error("Не удалось отобразить файл в память: " + path);
+    }
+    void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);  // отображение остается действительным до UnmapViewOfFile
+    if (address == nullptr) {
+        throw std::runtime_error("Не удалось отобразить файл в память: " + path);
+    }
+    return std::shared_ptr<const void>(address, [](const void* p) {
+        UnmapViewOfFile(p);
+    });
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Не удалось открыть файл: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Не удалось определить размер файла: " + path);
+    }
+    size = static_cast<uint64_t>(info.st_size);
+    if (size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Файл не содержит матрицу в двоичном формате: " + path);
+    }
+    const size_t length = static_cast<size_t>(size);
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // отображение остается действительным до munmap
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Не удалось отобразить файл в память: " + path);
+    }
+    return std::shared_ptr<const void>(address, [length](const void* p) {
+        ::munmap(const_cast<void*>(p), length);
+    });
+#endif
+}
+
+} // namespace
+
+// MatrixView
+MatrixView::MatrixView() : data_(nullptr), rows_(0), cols_(0), checksum_(0) {}
+
+double MatrixView::get(size_t row, size_t col) const {
+    if (row >= rows_ || col >= cols_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    return data_[row * cols_ + col];
+}
+
+Matrix MatrixView::toMatrix() const {
+    Matrix result(rows_, cols_);
+    for (size_t i = 0; i < rows_ && cols_ > 0; ++i) {
+        std::memcpy(&result[i][0], data_ + i * cols_, cols_ * sizeof(double));
+    }
+    return result;
+}
+
+bool MatrixView::verifyChecksum() const {
+    return MatrixFile::checksum(data_, rows_ * cols_) == checksum_;
+}
+
+// MatrixFile
+uint64_t MatrixFile::checksum(const double* data, size_t count) {
+    Fletcher sum;
+    sum.update(data, count);
+    return sum.value();
+}
+
+void MatrixFile::save(const std::string& path, const Matrix& matrix) {
+    const size_t rows = matrix.getRows();
+    const size_t cols = matrix.getCols();
+
+    Fletcher sum;
+    for (size_t i = 0; i < rows && cols > 0; ++i) {
+        sum.update(&matrix[i][0], cols);
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.dtype = DTYPE_FLOAT64;
+    header.headerSize = sizeof(Header);
+    header.rows = rows;
+    header.cols = cols;
+    header.payloadOffset = ALIGNMENT;
+    header.checksum = sum.value();
+
+    std::ofstream file(path.c_str(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (size_t i = 0; i < rows && cols > 0 && file; ++i) {
+        file.write(reinterpret_cast<const char*>(&matrix[i][0]), static_cast<std::streamsize>(cols * sizeof(double)));
+    }
+    if (!file || !file.flush()) {
+        throw std::runtime_error("Не удалось записать файл: " + path);
+    }
+}
+
+Matrix MatrixFile::load(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть файл: " + path);
+    }
+    file.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    const bool swapped = validateHeader(header, file ? fileSize : 0, path);
+
+    const size_t rows = static_cast<size_t>(header.rows);
+    const size_t cols = static_cast<size_t>(header.cols);
+    Matrix result(rows, cols);
+    file.seekg(static_cast<std::streamoff>(header.payloadOffset), std::ios::beg);
+    Fletcher sum;
+    std::vector<uint64_t> words(swapped ? cols : 0);
+    for (size_t i = 0; i < rows && cols > 0; ++i) {
+        double* row = &result[i][0];
+        if (!file.read(reinterpret_cast<char*>(row), static_cast<std::streamsize>(cols * sizeof(double)))) {
+            throw std::runtime_error("Ошибка чтения файла: " + path);
+        }
+        if (swapped) {
+            std::memcpy(&words[0], row, cols * sizeof(double));
+            for (size_t j = 0; j < cols; ++j) words[j] = swap64(words[j]);
+            std::memcpy(row, &words[0], cols * sizeof(double));
+        }
+        sum.update(row, cols);
+    }
+    if (sum.value() != header.checksum) {
+        throw std::runtime_error("Контрольная сумма матрицы не совпадает: " + path);
+    }
+    return result;
+}
+
+MatrixView MatrixFile::map(const std::string& path, bool verify) {
+    uint64_t fileSize = 0;
+    std::shared_ptr<const void> storage = mapFile(path, fileSize);
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(&header, storage.get(), fileSize < sizeof(header) ? static_cast<size_t>(fileSize) : sizeof(header));
+    if (validateHeader(header, fileSize, path)) {
+        throw std::runtime_error("Файл матрицы записан с другим порядком байтов, используйте MatrixFile::load: " + path);
+    }
+
+    MatrixView view;
+    view.storage_ = storage;
+    view.data_ = reinterpret_cast<const double*>(static_cast<const char*>(storage.get()) + header.payloadOffset);
+    view.rows_ = static_cast<size_t>(header.rows);
+    view.cols_ = static_cast<size_t>(header.cols);
+    view.checksum_ = header.checksum;
+    if (verify && !view.verifyChecksum()) {
+        throw std::runtime_error("Контрольная сумма матрицы не совпадает: " + path);
+    }
+    return view;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file MatrixFile.h
+ * @brief Двоичный формат хранения матриц и отображение файлов в память
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef MATRIXFILE_H
+#define MATRIXFILE_H
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include "Matrix.h"
+
+/**
+ * @class MatrixView
+ * @brief Матрица только для чтения поверх отображенного в память файла
+ *
+ * Элементы не копируются: данные читаются прямо из отображения, и
+ * страницы файла подгружаются системой при первом обращении. Копии
+ * представления разделяют одно отображение, которое освобождается
+ * вместе с последней копией.
+ */
+class MatrixView {
+private:
+    std::shared_ptr<const void> storage_;  ///< Владелец отображения
+    const double* data_;                   ///< Элементы по строкам
+    size_t rows_;                          ///< Количество строк
+    size_t cols_;                          ///< Количество столбцов
+    uint64_t checksum_;                    ///< Контрольная сумма из заголовка
+
+    friend class MatrixFile;
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустое представление 0x0
+     */
+    MatrixView();
+
+    // Методы доступа
+    size_t getRows() const { return rows_; }
+    size_t getCols() const { return cols_; }
+
+    /**
+     * @brief Непрерывный массив элементов по строкам
+     * @return Указатель, выровненный на MatrixFile::ALIGNMENT байт
+     */
+    const double* data() const { return data_; }
+
+    /**
+     * @brief Получить элемент
+     * @param row Номер строки
+     * @param col Номер столбца
+     * @return Значение элемента
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t row, size_t col) const;
+
+    /**
+     * @brief Строка без проверки границ
+     * @param row Номер строки
+     * @return Указатель на первый элемент строки
+     */
+    const double* operator[](size_t row) const { return data_ + row * cols_; }
+
+    // Операции
+    /**
+     * @brief Скопировать в обычную матрицу
+     * @return Матрица с теми же элементами
+     */
+    Matrix toMatrix() const;
+
+    /**
+     * @brief Проверить контрольную сумму (читает все страницы файла)
+     * @return true если данные не повреждены
+     */
+    bool verifyChecksum() const;
+};
+
+/**
+ * @class MatrixFile
+ * @brief Сохранение и загрузка матриц в версионированном двоичном формате
+ *
+ * Файл начинается с заголовка из 64 байт:
+ * | Смещение | Поле                                        |
+ * |----------|---------------------------------------------|
+ * | 0        | сигнатура "FDZMATRX"                        |
+ * | 8        | версия формата (uint32)                     |
+ * | 12       | метка порядка байтов 0x01020304 (uint32)    |
+ * | 16       | тип элементов, 1 - double (uint32)          |
+ * | 20       | размер заголовка (uint32)                   |
+ * | 24, 32   | число строк и столбцов (uint64)             |
+ * | 40       | смещение данных (uint64)                    |
+ * | 48       | контрольная сумма данных (uint64)           |
+ * | 56       | зарезервировано                             |
+ *
+ * Затем с выровненного на 64 байта смещения идут элементы по строкам.
+ * Все поля записываются в порядке байтов системы; метка позволяет
+ * загрузить файл, записанный на системе с другим порядком.
+ * Контрольная сумма - сумма Флетчера по 64-битным словам данных.
+ */
+class MatrixFile {
+public:
+    static const uint32_t VERSION = 1;    ///< Текущая версия формата
+    static const size_t ALIGNMENT = 64;   ///< Выравнивание начала данных
+
+    /**
+     * @brief Сохранить матрицу
+     * @param path Путь к файлу
+     * @param matrix Матрица
+     * @throw std::runtime_error если файл не удается записать
+     */
+    static void save(const std::string& path, const Matrix& matrix);
+
+    /**
+     * @brief Загрузить матрицу в память с проверкой контрольной суммы
+     * @param path Путь к файлу
+     * @return Матрица
+     * @throw std::runtime_error если файл не открывается, поврежден
+     *        или имеет неподдерживаемую версию
+     */
+    static Matrix load(const std::string& path);
+
+    /**
+     * @brief Отобразить файл в память без копирования
+     * @param path Путь к файлу
+     * @param verify Проверить контрольную сумму (требует чтения всего файла)
+     * @return Представление только для чтения
+     * @throw std::runtime_error если файл не открывается, поврежден,
+     *        записан с другим порядком байтов или не отображается
+     */
+    static MatrixView map(const std::string& path, bool verify = false);
+
+    /**
+     * @brief Контрольная сумма массива элементов
+     * @param data Элементы
+     * @param count Количество элементов
+     * @return Сумма Флетчера по 64-битным словам
+     */
+    static uint64_t checksum(const double* data, size_t count);
+};
+
+#endif // MATRIXFILE_H
@@ -0,0 +1,168 @@
+/**
+ * @file Parallel.cpp
+ * @brief Реализация вспомогательных функций для параллельного выполнения
+ */
+
+#include "Parallel.h"
+#include <condition_variable>
+#include <mutex>
+
+namespace {
+    std::atomic<unsigned> g_threadCount(0);  ///< 0 - по числу ядер
+
+    /**
+     * @brief Группа задач одного вызова runTasks
+     *
+     * Лежит в стеке вызывающего потока и входит в список пула, пока
+     * в ней есть невыданные задачи.
+     */
+    struct Region {
+        Parallel::TaskFunction task;  ///< Функция задачи
+        void* context;                ///< Аргумент функции
+        size_t tasks;                 ///< Количество задач
+        size_t next;                  ///< Следующая невыданная задача
+        size_t running;               ///< Задач, выполняемых потоками пула
+        Region* link;                 ///< Следующая группа в списке пула
+    };
+
+    /**
+     * @class WorkerPool
+     * @brief Постоянные рабочие потоки, выполняющие задачи из групп
+     *
+     * Вызывающий поток сам выполняет задачи своей группы, которые не
+     * успели взять потоки пула, и ждет только уже начатые. Поэтому
+     * вложенные вызовы не блокируются навсегда и не создают потоков
+     * сверх getThreadCount() - 1.
+     */
+    class WorkerPool {
+    private:
+        std::mutex mutex_;                  ///< Защищает все поля ниже и группы в списке
+        std::condition_variable wake_;      ///< Появилась группа с задачами или остановка
+        std::condition_variable done_;      ///< Поток пула закончил задачу
+        std::vector<std::thread> workers_;  ///< Рабочие потоки
+        Region* regions_;                   ///< Группы с невыданными задачами
+        bool stop_;                         ///< Пул завершается
+
+        Region* findWork() const {
+            for (Region* region = regions_; region; region = region->link) {
+                if (region->next < region->tasks) return region;
+            }
+            return 0;
+        }
+
+        void unlink(Region* region) {
+            for (Region** slot = &regions_; *slot; slot = &(*slot)->link) {
+                if (*slot == region) {
+                    *slot = region->link;
+                    return;
+                }
+            }
+        }
+
+        void loop() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                Region* region = 0;
+                wake_.wait(lock, [&]() { return stop_ || (region = findWork()) != 0; });
+                if (stop_) return;
+                const size_t id = region->next++;
+                if (region->next == region->tasks) unlink(region);
+                ++region->running;
+                lock.unlock();
+                region->task(region->context, id);
+                lock.lock();
+                if (--region->running == 0) done_.notify_all();
+            }
+        }
+
+        /**
+         * @brief Довести число потоков до count
+         *
+         * Если поток создать не удалось, пул остается меньшего размера:
+         * уже созданные потоки принадлежат пулу и будут присоединены
+         * в деструкторе, поэтому std::terminate не вызывается.
+         */
+        void grow(size_t count) {
+            while (workers_.size() < count) {
+                try {
+                    workers_.emplace_back(&WorkerPool::loop, this);
+                } catch (...) {
+                    return;
+                }
+            }
+        }
+
+    public:
+        WorkerPool() : regions_(0), stop_(false) {}
+
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            for (auto& worker : workers_) {
+                worker.join();
+            }
+        }
+
+        void run(size_t tasks, Parallel::TaskFunction task, void* context) {
+            Region region = { task, context, tasks, 1, 0, 0 };
+            bool posted = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                grow(Parallel::getThreadCount() - 1);
+                if (!workers_.empty()) {
+                    region.link = regions_;
+                    regions_ = &region;
+                    posted = true;
+                }
+            }
+            if (posted) {
+                wake_.notify_all();
+            }
+
+            task(context, 0);
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (region.next < region.tasks) {
+                const size_t id = region.next++;
+                lock.unlock();
+                task(context, id);
+                lock.lock();
+            }
+            unlink(&region);
+            done_.wait(lock, [&]() { return region.running == 0; });
+        }
+    };
+
+    WorkerPool& pool() {
+        static WorkerPool instance;
+        return instance;
+    }
+}
+
+namespace Parallel {
+
+unsigned getThreadCount() {
+    unsigned count = g_threadCount.load();
+    if (count == 0) {
+        count = std::thread::hardware_concurrency();
+    }
+    return count == 0 ? 1 : count;
+}
+
+void setThreadCount(unsigned count) {
+    g_threadCount = count;
+}
+
+void runTasks(size_t tasks, TaskFunction task, void* context) {
+    if (tasks == 0) return;
+    if (tasks == 1 || getThreadCount() <= 1) {
+        for (size_t id = 0; id < tasks; ++id) task(context, id);
+        return;
+    }
+    pool().run(tasks, task, context);
+}
+
+} // namespace Parallel
@@ -0,0 +1,165 @@
+/**
+ * @file Parallel.h
+ * @brief Вспомогательные функции для параллельного выполнения
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <exception>
+
+/**
+ * @namespace Parallel
+ * @brief Простейший параллельный исполнитель на постоянном пуле потоков
+ *
+ * Работа делится на блоки фиксированного размера, которые не зависят
+ * от количества потоков. Благодаря этому редукции, собирающие результаты
+ * блоков по порядку, дают одинаковый результат при любом числе потоков.
+ *
+ * Рабочие потоки создаются один раз при первом параллельном вызове и
+ * ждут задач, поэтому вызов в каждом кадре не создает потоков и не
+ * выделяет память. Вложенные вызовы (forEachBlock внутри invoke и т. п.)
+ * не добавляют потоков: их задачи берут только свободные потоки пула,
+ * а остальное выполняет сам вызывающий поток.
+ */
+namespace Parallel {
+
+    /**
+     * @brief Получить количество рабочих потоков
+     * @return Количество потоков (не меньше 1)
+     */
+    unsigned getThreadCount();
+
+    /**
+     * @brief Установить количество рабочих потоков
+     * @param count Количество потоков (0 - по числу ядер процессора)
+     */
+    void setThreadCount(unsigned count);
+
+    /**
+     * @brief Количество блоков для разбиения диапазона
+     * @param count Размер диапазона
+     * @param blockSize Размер блока
+     * @return Количество блоков
+     */
+    inline size_t blockCount(size_t count, size_t blockSize) {
+        if (blockSize == 0) blockSize = 1;
+        return (count + blockSize - 1) / blockSize;
+    }
+
+    /**
+     * @brief Функция задачи: task(context, id)
+     */
+    typedef void (*TaskFunction)(void* context, size_t id);
+
+    /**
+     * @brief Выполнить task(context, id) для всех id из [0, tasks)
+     * @param tasks Количество задач
+     * @param task Функция задачи; не должна бросать исключений
+     * @param context Аргумент функции
+     *
+     * Задачу 0 выполняет вызывающий поток, остальные - свободные потоки
+     * пула или, если их нет, тоже вызывающий поток. Возврат - после
+     * завершения всех задач. Если потоки пула создать не удалось, все
+     * задачи выполняются в вызывающем потоке.
+     */
+    void runTasks(size_t tasks, TaskFunction task, void* context);
+
+    /**
+     * @brief Вызов функционального объекта через TaskFunction
+     */
+    template <typename Task>
+    void callTask(void* context, size_t id) {
+        (*static_cast<Task*>(context))(id);
+    }
+
+    /**
+     * @brief Обработать диапазон [0, count) блоками фиксированного размера
+     * @param count Размер диапазона
+     * @param blockSize Размер блока
+     * @param func Функция вида func(blockIndex, begin, end)
+     *
+     * Блоки раздаются потокам по одному через атомарный счетчик.
+     * Первое исключение из блоков пробрасывается вызывающему после
+     * завершения всех потоков; оставшиеся блоки при этом пропускаются.
+     */
+    template <typename Func>
+    void forEachBlock(size_t count, size_t blockSize, Func func) {
+        if (blockSize == 0) blockSize = 1;
+        const size_t blocks = blockCount(count, blockSize);
+        if (blocks == 0) return;
+
+        size_t threads = getThreadCount();
+        if (threads > blocks) threads = blocks;
+
+        if (threads <= 1) {
+            for (size_t b = 0; b < blocks; ++b) {
+                size_t begin = b * blockSize;
+                size_t end = begin + blockSize < count ? begin + blockSize : count;
+                func(b, begin, end);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr error;
+        auto worker = [&](size_t) {
+            try {
+                for (size_t b = next++; b < blocks; b = next++) {
+                    size_t begin = b * blockSize;
+                    size_t end = begin + blockSize < count ? begin + blockSize : count;
+                    func(b, begin, end);
+                }
+            } catch (...) {
+                if (!failed.exchange(true)) error = std::current_exception();
+                next = blocks;
+            }
+        };
+        runTasks(threads, &callTask<decltype(worker)>, &worker);
+        if (error) std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief Выполнить две независимые задачи, по возможности параллельно
+     * @param first Первая задача
+     * @param second Вторая задача
+     * @param parallel Разрешить выполнение второй задачи другим потоком
+     *
+     * Если бросили обе задачи, пробрасывается исключение первой.
+     */
+    template <typename First, typename Second>
+    void invoke(First first, Second second, bool parallel = true) {
+        if (!parallel || getThreadCount() <= 1) {
+            first();
+            second();
+            return;
+        }
+
+        std::exception_ptr errors[2];
+        auto task = [&](size_t id) {
+            try {
+                if (id == 0) {
+                    first();
+                } else {
+                    second();
+                }
+            } catch (...) {
+                errors[id] = std::current_exception();
+            }
+        };
+        runTasks(2, &callTask<decltype(task)>, &task);
+        for (const auto& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+
+} // namespace Parallel
+
+#endif // PARALLEL_H
@@ -0,0 +1,307 @@
+/**
+ * @file PointReduction.cpp
+ * @brief Реализация параллельных редукций над массивами точек
+ */
+
+#include "PointReduction.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+const size_t REDUCE_BLOCK = 4096;  ///< Точек в одном блоке редукции
+
+/**
+ * @brief Обработать блоки последовательно или параллельно
+ *
+ * Разбиение на блоки в обоих случаях одинаково, поэтому одинаков и результат.
+ */
+template <typename Func>
+void runBlocks(size_t count, bool parallel, Func func) {
+    if (parallel) {
+        Parallel::forEachBlock(count, REDUCE_BLOCK, func);
+        return;
+    }
+    for (size_t b = 0, begin = 0; begin < count; ++b, begin += REDUCE_BLOCK) {
+        func(b, begin, std::min(begin + REDUCE_BLOCK, count));
+    }
+}
+
+/**
+ * @brief Объединить частичные результаты попарным деревом
+ */
+template <typename T, typename Combine>
+T treeCombine(std::vector<T>& parts, Combine combine) {
+    for (size_t step = 1; step < parts.size(); step *= 2) {
+        for (size_t i = 0; i + step < parts.size(); i += 2 * step) {
+            parts[i] = combine(parts[i], parts[i + step]);
+        }
+    }
+    return parts[0];
+}
+
+/**
+ * @brief Сумма с компенсацией (Ноймайер)
+ */
+struct CompensatedSum {
+    double sum[3];
+    double error[3];
+
+    CompensatedSum() {
+        for (int a = 0; a < 3; ++a) {
+            sum[a] = 0.0;
+            error[a] = 0.0;
+        }
+    }
+
+    void add(int axis, double value) {
+        double t = sum[axis] + value;
+        if (std::abs(sum[axis]) >= std::abs(value)) {
+            error[axis] += (sum[axis] - t) + value;
+        } else {
+            error[axis] += (value - t) + sum[axis];
+        }
+        sum[axis] = t;
+    }
+
+    double total(int axis) const {
+        return sum[axis] + error[axis];
+    }
+};
+
+CompensatedSum blockSum(const std::vector<Vector3D>& points, size_t begin, size_t end) {
+    CompensatedSum result;
+    for (size_t i = begin; i < end; ++i) {
+        result.add(0, points[i].getX());
+        result.add(1, points[i].getY());
+        result.add(2, points[i].getZ());
+    }
+    return result;
+}
+
+CompensatedSum combineSums(const CompensatedSum& a, const CompensatedSum& b) {
+    CompensatedSum result = a;
+    for (int axis = 0; axis < 3; ++axis) {
+        result.add(axis, b.sum[axis]);
+        result.error[axis] += b.error[axis];
+    }
+    return result;
+}
+
+/**
+ * @brief Частичный момент: количество, среднее и сумма произведений отклонений
+ */
+struct Moments {
+    double count;
+    double mean[3];
+    double comoment[6];  ///< xx, xy, xz, yy, yz, zz
+};
+
+Moments blockMoments(const std::vector<Vector3D>& points, size_t begin, size_t end) {
+    // Двухпроходный алгоритм внутри блока: блок уже в кэше
+    Moments m;
+    m.count = static_cast<double>(end - begin);
+    double sx = 0.0, sy = 0.0, sz = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        sx += points[i].getX();
+        sy += points[i].getY();
+        sz += points[i].getZ();
+    }
+    m.mean[0] = sx / m.count;
+    m.mean[1] = sy / m.count;
+    m.mean[2] = sz / m.count;
+
+    double cxx = 0.0, cxy = 0.0, cxz = 0.0, cyy = 0.0, cyz = 0.0, czz = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        double dx = points[i].getX() - m.mean[0];
+        double dy = points[i].getY() - m.mean[1];
+        double dz = points[i].getZ() - m.mean[2];
+        cxx += dx * dx;
+        cxy += dx * dy;
+        cxz += dx * dz;
+        cyy += dy * dy;
+        cyz += dy * dz;
+        czz += dz * dz;
+    }
+    m.comoment[0] = cxx;
+    m.comoment[1] = cxy;
+    m.comoment[2] = cxz;
+    m.comoment[3] = cyy;
+    m.comoment[4] = cyz;
+    m.comoment[5] = czz;
+    return m;
+}
+
+Moments combineMoments(const Moments& a, const Moments& b) {
+    Moments result;
+    result.count = a.count + b.count;
+    const double weight = a.count * b.count / result.count;
+    double delta[3];
+    for (int k = 0; k < 3; ++k) {
+        delta[k] = b.mean[k] - a.mean[k];
+        result.mean[k] = a.mean[k] + delta[k] * (b.count / result.count);
+    }
+    const int row[6] = { 0, 0, 0, 1, 1, 2 };
+    const int col[6] = { 0, 1, 2, 1, 2, 2 };
+    for (int k = 0; k < 6; ++k) {
+        result.comoment[k] = a.comoment[k] + b.comoment[k] + delta[row[k]] * delta[col[k]] * weight;
+    }
+    return result;
+}
+
+Moments computeMoments(const std::vector<Vector3D>& points, bool parallel) {
+    std::vector<Moments> parts(Parallel::blockCount(points.size(), REDUCE_BLOCK));
+    runBlocks(points.size(), parallel, [&](size_t block, size_t begin, size_t end) {
+        parts[block] = blockMoments(points, begin, end);
+    });
+    return treeCombine(parts, combineMoments);
+}
+
+} // namespace
+
+Vector3D PointReduction::sum(const std::vector<Vector3D>& points, bool parallel) {
+    if (points.empty()) {
+        return Vector3D();
+    }
+    std::vector<CompensatedSum> parts(Parallel::blockCount(points.size(), REDUCE_BLOCK));
+    runBlocks(points.size(), parallel, [&](size_t block, size_t begin, size_t end) {
+        parts[block] = blockSum(points, begin, end);
+    });
+    CompensatedSum total = treeCombine(parts, combineSums);
+    return Vector3D(total.total(0), total.total(1), total.total(2));
+}
+
+Vector3D PointReduction::centroid(const std::vector<Vector3D>& points, bool parallel) {
+    if (points.empty()) {
+        throw std::invalid_argument("Нельзя вычислить центр масс пустого набора");
+    }
+    return sum(points, parallel) * (1.0 / static_cast<double>(points.size()));
+}
+
+BoundingBox PointReduction::bounds(const std::vector<Vector3D>& points, bool parallel) {
+    if (points.empty()) {
+        return BoundingBox();
+    }
+    std::vector<BoundingBox> parts(Parallel::blockCount(points.size(), REDUCE_BLOCK));
+    runBlocks(points.size(), parallel, [&](size_t block, size_t begin, size_t end) {
+        BoundingBox box;
+        for (size_t i = begin; i < end; ++i) {
+            box.expand(points[i].getX(), points[i].getY(), points[i].getZ());
+        }
+        parts[block] = box;
+    });
+    return treeCombine(parts, [](BoundingBox a, const BoundingBox& b) {
+        a.expand(b);
+        return a;
+    });
+}
+
+Matrix PointReduction::covariance(const std::vector<Vector3D>& points, bool sample, bool parallel) {
+    if (points.empty() || (sample && points.size() < 2)) {
+        throw std::invalid_argument("Недостаточно точек для вычисления ковариации");
+    }
+
+    Moments m = computeMoments(points, parallel);
+    const double divisor = sample ? m.count - 1.0 : m.count;
+    const int index[3][3] = { { 0, 1, 2 }, { 1, 3, 4 }, { 2, 4, 5 } };
+
+    Matrix result(3, 3);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            result.set(i, j, m.comoment[index[i][j]] / divisor);
+        }
+    }
+    return result;
+}
+
+PrincipalAxes PointReduction::principalAxes(const std::vector<Vector3D>& points, bool parallel) {
+    if (points.empty()) {
+        throw std::invalid_argument("Нельзя вычислить главные оси пустого набора");
+    }
+
+    Moments m = computeMoments(points, parallel);
+    const int index[3][3] = { { 0, 1, 2 }, { 1, 3, 4 }, { 2, 4, 5 } };
+    Matrix cov(3, 3);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            cov.set(i, j, m.comoment[index[i][j]] / m.count);
+        }
+    }
+
+    PrincipalAxes result;
+    result.centroid = Vector3D(m.mean[0], m.mean[1], m.mean[2]);
+    symmetricEigen3(cov, result.variances, result.axes);
+    return result;
+}
+
+void PointReduction::symmetricEigen3(const Matrix& matrix, double eigenvalues[3],
+                                     Vector3D eigenvectors[3]) {
+    if (matrix.getRows() != 3 || matrix.getCols() != 3) {
+        throw std::invalid_argument("Ожидается матрица 3x3");
+    }
+    if (!matrix.isSymmetric(1e-9)) {
+        throw std::invalid_argument("Матрица должна быть симметричной");
+    }
+
+    double a[3][3];
+    double v[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    double scale = 0.0;
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            a[i][j] = matrix.get(i, j);
+            scale += a[i][j] * a[i][j];
+        }
+    }
+
+    // Циклический метод Якоби: обнуляем внедиагональные элементы вращениями
+    const int pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+    for (int sweep = 0; sweep < 50; ++sweep) {
+        double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        if (off <= 1e-30 * scale || off == 0.0) break;
+
+        for (int r = 0; r < 3; ++r) {
+            const int p = pairs[r][0];
+            const int q = pairs[r][1];
+            if (a[p][q] == 0.0) continue;
+
+            double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+            double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+            double c = 1.0 / std::sqrt(t * t + 1.0);
+            double s = t * c;
+
+            for (int k = 0; k < 3; ++k) {
+                double akp = a[k][p];
+                double akq = a[k][q];
+                a[k][p] = c * akp - s * akq;
+                a[k][q] = s * akp + c * akq;
+            }
+            for (int k = 0; k < 3; ++k) {
+                double apk = a[p][k];
+                double aqk = a[q][k];
+                a[p][k] = c * apk - s * aqk;
+                a[q][k] = s * apk + c * aqk;
+            }
+            for (int k = 0; k < 3; ++k) {
+                double vkp = v[k][p];
+                double vkq = v[k][q];
+                v[k][p] = c * vkp - s * vkq;
+                v[k][q] = s * vkp + c * vkq;
+            }
+        }
+    }
+
+    int order[3] = { 0, 1, 2 };
+    std::sort(order, order + 3, [&](int x, int y) { return a[x][x] > a[y][y]; });
+
+    for (int i = 0; i < 3; ++i) {
+        const int col = order[i];
+        eigenvalues[i] = a[col][col];
+        double x = v[0][col], y = v[1][col], z = v[2][col];
+        double largest = std::abs(x) >= std::abs(y) && std::abs(x) >= std::abs(z) ? x
+                       : (std::abs(y) >= std::abs(z) ? y : z);
+        double sign = largest < 0.0 ? -1.0 : 1.0;
+        eigenvectors[i] = Vector3D(sign * x, sign * y, sign * z);
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file PointReduction.h
+ * @brief Параллельные редукции над массивами трехмерных точек
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef POINTREDUCTION_H
+#define POINTREDUCTION_H
+
+#include <vector>
+#include "Vector3D.h"
+#include "Matrix.h"
+#include "BoundingBox.h"
+
+/**
+ * @struct PrincipalAxes
+ * @brief Главные оси облака точек
+ */
+struct PrincipalAxes {
+    Vector3D centroid;     ///< Центр масс
+    Vector3D axes[3];      ///< Единичные оси в порядке убывания дисперсии
+    double variances[3];   ///< Дисперсии вдоль осей (собственные значения)
+};
+
+/**
+ * @class PointReduction
+ * @brief Сумма, центр масс, границы и ковариация массивов Vector3D
+ *
+ * Массив делится на блоки фиксированного размера, не зависящего от числа
+ * потоков. Частичные результаты блоков объединяются попарным деревом
+ * в фиксированном порядке, поэтому результат бит-в-бит одинаков при любом
+ * количестве потоков. Суммы внутри блоков считаются с компенсацией
+ * (алгоритм Ноймайера). Для ковариации каждый блок проходится дважды:
+ * сначала среднее блока, затем центрированные вторые моменты; моменты
+ * блоков объединяются попарной формулой Чана.
+ */
+class PointReduction {
+public:
+    /**
+     * @brief Сумма векторов с компенсацией ошибки округления
+     * @param points Массив векторов
+     * @param parallel Использовать несколько потоков
+     * @return Сумма
+     */
+    static Vector3D sum(const std::vector<Vector3D>& points, bool parallel = true);
+
+    /**
+     * @brief Центр масс
+     * @param points Массив точек
+     * @param parallel Использовать несколько потоков
+     * @return Среднее арифметическое точек
+     * @throw std::invalid_argument если массив пуст
+     */
+    static Vector3D centroid(const std::vector<Vector3D>& points, bool parallel = true);
+
+    /**
+     * @brief Ограничивающий параллелепипед
+     * @param points Массив точек
+     * @param parallel Использовать несколько потоков
+     * @return Параллелепипед (пустой для пустого массива)
+     */
+    static BoundingBox bounds(const std::vector<Vector3D>& points, bool parallel = true);
+
+    /**
+     * @brief Ковариационная матрица 3x3
+     * @param points Массив точек
+     * @param sample true - выборочная (деление на n - 1), false - на n
+     * @param parallel Использовать несколько потоков
+     * @return Симметричная матрица 3x3
+     * @throw std::invalid_argument если точек недостаточно
+     */
+    static Matrix covariance(const std::vector<Vector3D>& points, bool sample = false,
+                             bool parallel = true);
+
+    /**
+     * @brief Главные оси облака точек
+     * @param points Массив точек
+     * @param parallel Использовать несколько потоков
+     * @return Центр масс, оси и дисперсии
+     * @throw std::invalid_argument если массив пуст
+     */
+    static PrincipalAxes principalAxes(const std::vector<Vector3D>& points, bool parallel = true);
+
+    /**
+     * @brief Собственные значения и векторы симметричной матрицы 3x3
+     * @param matrix Симметричная матрица 3x3
+     * @param eigenvalues Собственные значения в порядке убывания
+     * @param eigenvectors Соответствующие единичные собственные векторы
+     * @throw std::invalid_argument если матрица не 3x3 или не симметрична
+     *
+     * Используется циклический метод Якоби. Знак каждого вектора выбирается
+     * так, чтобы его наибольшая по модулю компонента была положительной.
+     */
+    static void symmetricEigen3(const Matrix& matrix, double eigenvalues[3],
+                                Vector3D eigenvectors[3]);
+};
+
+#endif // POINTREDUCTION_H
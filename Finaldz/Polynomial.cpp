@@ -0,0 +1,260 @@
+/**
+ * @file Polynomial.cpp
+ * @brief Быстрые операции над многочленами с коэффициентами double и Complex
+ */
+
+#include "Polynomial.h"
+#include "Convolution.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const size_t EVALUATE_LANES = 8;   ///< Точек, обрабатываемых одновременно
+const size_t ROOT_BLOCK = 64;      ///< Корней в одной параллельной задаче
+const double PI = 3.14159265358979323846;
+
+/**
+ * @brief Частное a / b по Смиту
+ * @return false если b равно нулю
+ *
+ * Квадрат модуля делителя не вычисляется, поэтому частное верно и для
+ * очень больших и очень малых по модулю операндов (|b|^2 переполнился
+ * бы уже при |b| > 1e154 и обнулился бы при |b| < 1e-162).
+ */
+bool divideComplex(double ar, double ai, double br, double bi, double& qr, double& qi) {
+    if (br == 0.0 && bi == 0.0) return false;
+    if (std::abs(br) >= std::abs(bi)) {
+        const double r = bi / br;
+        const double d = br + bi * r;
+        qr = (ar + ai * r) / d;
+        qi = (ai - ar * r) / d;
+    } else {
+        const double r = br / bi;
+        const double d = br * r + bi;
+        qr = (ar * r + ai) / d;
+        qi = (ai * r - ar) / d;
+    }
+    return true;
+}
+
+/**
+ * @brief Отношение p(z) / p'(z) для приведенного многочлена
+ *
+ * При |z| > 1 используется перевернутый многочлен q(y) = y^n p(1/y),
+ * y = 1/z, чтобы избежать переполнения: p / p' = z q / (n q - y q').
+ * Обратная величина и частное вычисляются по Смиту, без |z|^2.
+ */
+void newtonRatio(const double* cr, const double* ci, size_t n, double zr, double zi,
+                 double& wr, double& wi, bool& zeroDerivative) {
+    double pr, pi, dr = 0.0, di = 0.0;
+    const bool reversed = std::abs(zr) > 1.0 || std::abs(zi) > 1.0 || zr * zr + zi * zi > 1.0;
+    double xr = zr, xi = zi;
+    if (reversed) {
+        divideComplex(1.0, 0.0, zr, zi, xr, xi);
+    }
+
+    // Горнер для значения и производной одновременно
+    if (reversed) {
+        pr = cr[0];
+        pi = ci[0];
+        for (size_t k = 1; k <= n; ++k) {
+            const double tr = dr * xr - di * xi + pr;
+            di = dr * xi + di * xr + pi;
+            dr = tr;
+            const double vr = pr * xr - pi * xi + cr[k];
+            pi = pr * xi + pi * xr + ci[k];
+            pr = vr;
+        }
+    } else {
+        pr = cr[n];
+        pi = ci[n];
+        for (size_t k = n; k-- > 0;) {
+            const double tr = dr * xr - di * xi + pr;
+            di = dr * xi + di * xr + pi;
+            dr = tr;
+            const double vr = pr * xr - pi * xi + cr[k];
+            pi = pr * xi + pi * xr + ci[k];
+            pr = vr;
+        }
+    }
+
+    double numR = pr, numI = pi, denR = dr, denI = di;
+    if (reversed) {
+        // Числитель z * q, знаменатель n * q - y * q'
+        numR = zr * pr - zi * pi;
+        numI = zr * pi + zi * pr;
+        denR = static_cast<double>(n) * pr - (xr * dr - xi * di);
+        denI = static_cast<double>(n) * pi - (xr * di + xi * dr);
+    }
+
+    zeroDerivative = !divideComplex(numR, numI, denR, denI, wr, wi);
+    if (zeroDerivative) {
+        wr = numR;
+        wi = numI;
+    }
+}
+
+} // namespace
+
+std::vector<double> polynomialMultiply(const std::vector<double>& a, const std::vector<double>& b) {
+    return Convolution::convolve(a, b);
+}
+
+std::vector<Complex> polynomialMultiply(const std::vector<Complex>& a, const std::vector<Complex>& b) {
+    return Convolution::convolve(a, b);
+}
+
+void polynomialEvaluate(const std::vector<Complex>& coefficients, const Complex* points, Complex* result,
+                        size_t count) {
+    const size_t n = coefficients.size();
+    std::vector<double> cr(n), ci(n);
+    for (size_t k = 0; k < n; ++k) {
+        cr[k] = coefficients[k].getReal();
+        ci[k] = coefficients[k].getImag();
+    }
+
+    // Несколько независимых схем Горнера во внутреннем цикле: цепочки
+    // зависимостей перекрываются, и цикл по точкам векторизуется
+    for (size_t begin = 0; begin < count; begin += EVALUATE_LANES) {
+        const size_t lanes = std::min(EVALUATE_LANES, count - begin);
+        double xr[EVALUATE_LANES], xi[EVALUATE_LANES], vr[EVALUATE_LANES], vi[EVALUATE_LANES];
+        for (size_t l = 0; l < EVALUATE_LANES; ++l) {
+            const bool active = l < lanes;
+            xr[l] = active ? points[begin + l].getReal() : 0.0;
+            xi[l] = active ? points[begin + l].getImag() : 0.0;
+            vr[l] = cr[n - 1];
+            vi[l] = ci[n - 1];
+        }
+        for (size_t k = n - 1; k-- > 0;) {
+            const double ar = cr[k], ai = ci[k];
+            for (size_t l = 0; l < EVALUATE_LANES; ++l) {
+                const double tr = vr[l] * xr[l] - vi[l] * xi[l] + ar;
+                vi[l] = vr[l] * xi[l] + vi[l] * xr[l] + ai;
+                vr[l] = tr;
+            }
+        }
+        for (size_t l = 0; l < lanes; ++l) {
+            result[begin + l] = Complex(vr[l], vi[l]);
+        }
+    }
+}
+
+std::vector<Complex> polynomialRoots(const std::vector<Complex>& coefficients, const RootFinderOptions& options) {
+    std::vector<Complex> roots;
+    size_t low = 0;
+    size_t high = coefficients.size();
+    while (high > 0 && coefficients[high - 1].getReal() == 0.0 && coefficients[high - 1].getImag() == 0.0) {
+        --high;
+    }
+    if (high == 0) {
+        throw std::invalid_argument("Нулевой многочлен имеет бесконечно много корней");
+    }
+    // Точные нулевые корни отделяются сразу: итерации сходятся к кратным корням медленно
+    while (low < high && coefficients[low].getReal() == 0.0 && coefficients[low].getImag() == 0.0) {
+        roots.push_back(Complex(0.0, 0.0));
+        ++low;
+    }
+    const size_t n = high - low - 1;
+    if (n == 0) {
+        return roots;
+    }
+
+    // Приведенный многочлен. Complex::operator/ отвергает делители с
+    // |lead|^2 < 1e-10, поэтому деление выполняется здесь; старший
+    // коэффициент после отбрасывания нулей точно не равен нулю
+    std::vector<double> cr(n + 1), ci(n + 1);
+    const Complex lead = coefficients[high - 1];
+    for (size_t k = 0; k < n; ++k) {
+        const Complex c = coefficients[low + k];
+        divideComplex(c.getReal(), c.getImag(), lead.getReal(), lead.getImag(), cr[k], ci[k]);
+    }
+    cr[n] = 1.0;
+    ci[n] = 0.0;
+
+    // Начальные приближения на окружности среднего геометрического модуля корней
+    const double radius = std::pow(std::hypot(cr[0], ci[0]), 1.0 / static_cast<double>(n));
+    std::vector<double> zr(n), zi(n), nextR(n), nextI(n);
+    std::vector<char> converged(n, 0);
+    for (size_t k = 0; k < n; ++k) {
+        const double angle = 2.0 * PI * static_cast<double>(k) / static_cast<double>(n) + 0.4;
+        zr[k] = radius * std::cos(angle);
+        zi[k] = radius * std::sin(angle);
+    }
+
+    // Итерации Аберта в форме Якоби: новые приближения вычисляются только
+    // по старым, поэтому корни обновляются независимо и параллельно
+    auto update = [&](size_t, size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            nextR[k] = zr[k];
+            nextI[k] = zi[k];
+            if (converged[k]) continue;
+
+            double wr, wi;
+            bool zeroDerivative;
+            newtonRatio(&cr[0], &ci[0], n, zr[k], zi[k], wr, wi, zeroDerivative);
+            double deltaR = wr, deltaI = wi;
+            if (zeroDerivative) {
+                // Критическая точка: небольшой сдвиг выводит из нее
+                const double shift = 1e-3 * (1.0 + std::hypot(zr[k], zi[k]));
+                deltaR = -shift;
+                deltaI = shift;
+            } else {
+                double sr = 0.0, si = 0.0;
+                for (size_t j = 0; j < n; ++j) {
+                    if (j == k) continue;
+                    const double dr = zr[k] - zr[j], di = zi[k] - zi[j];
+                    if (dr == 0.0 && di == 0.0) continue;
+                    const double norm = dr * dr + di * di;
+                    if (norm >= std::numeric_limits<double>::min() && norm <= std::numeric_limits<double>::max()) {
+                        sr += dr / norm;
+                        si -= di / norm;
+                    } else {
+                        // |d|^2 переполнился или обнулился: 1 / d по Смиту
+                        double rr, ri;
+                        divideComplex(1.0, 0.0, dr, di, rr, ri);
+                        sr += rr;
+                        si += ri;
+                    }
+                }
+                // delta = w / (1 - w * s)
+                const double qr = 1.0 - (wr * sr - wi * si);
+                const double qi = -(wr * si + wi * sr);
+                double qDeltaR, qDeltaI;
+                if (divideComplex(wr, wi, qr, qi, qDeltaR, qDeltaI)) {
+                    deltaR = qDeltaR;
+                    deltaI = qDeltaI;
+                }
+            }
+            nextR[k] = zr[k] - deltaR;
+            nextI[k] = zi[k] - deltaI;
+            const double size = std::hypot(nextR[k], nextI[k]);
+            const double step = std::hypot(deltaR, deltaI);
+            if (!zeroDerivative && step <= options.tolerance * (size + options.tolerance)) {
+                converged[k] = 1;
+            }
+        }
+    };
+
+    const bool parallel = options.parallel && n >= options.parallelThreshold;
+    for (size_t iteration = 0; iteration < options.maxIterations; ++iteration) {
+        if (parallel) {
+            Parallel::forEachBlock(n, ROOT_BLOCK, update);
+        } else {
+            update(0, 0, n);
+        }
+        zr.swap(nextR);
+        zi.swap(nextI);
+        if (std::find(converged.begin(), converged.end(), 0) == converged.end()) break;
+    }
+
+    for (size_t k = 0; k < n; ++k) {
+        roots.push_back(Complex(zr[k], zi[k]));
+    }
+    return roots;
+}
+
+std::vector<Complex> polynomialRoots(const std::vector<double>& coefficients, const RootFinderOptions& options) {
+    std::vector<Complex> complexCoefficients(coefficients.begin(), coefficients.end());
+    return polynomialRoots(complexCoefficients, options);
+}
@@ -0,0 +1,358 @@
+/**
+ * @file Polynomial.h
+ * @brief Шаблон многочлена с быстрым умножением и поиском корней
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef POLYNOMIAL_H
+#define POLYNOMIAL_H
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include "Complex.h"
+#include "Parallel.h"
+
+/**
+ * @brief Параметры поиска корней
+ */
+struct RootFinderOptions {
+    size_t maxIterations;       ///< Максимальное число итераций Аберта
+    double tolerance;           ///< Относительная точность поправки корня
+    bool parallel;              ///< Разрешить многопоточность
+    size_t parallelThreshold;   ///< Минимальная степень для распараллеливания по корням
+
+    RootFinderOptions()
+        : maxIterations(500), tolerance(1e-14), parallel(true), parallelThreshold(512) {}
+};
+
+// Операции над коэффициентами (по возрастанию степеней). Перегрузки для
+// double и Complex используют быстрые алгоритмы, шаблоны - общий запасной путь.
+
+/**
+ * @brief Точная проверка коэффициента на ноль
+ *
+ * Complex::operator== сравнивает с допуском 1e-10, и малый, но ненулевой
+ * старший коэффициент отбрасывался бы, меняя степень многочлена. Поэтому
+ * для Complex сравниваются части с точным нулем, как в polynomialRoots.
+ */
+template <typename T>
+bool isZeroCoefficient(const T& value) {
+    return value == T();
+}
+inline bool isZeroCoefficient(const Complex& value) {
+    return value.getReal() == 0.0 && value.getImag() == 0.0;
+}
+
+/**
+ * @brief Произведение многочленов
+ */
+template <typename T>
+std::vector<T> polynomialMultiply(const std::vector<T>& a, const std::vector<T>& b) {
+    std::vector<T> result(a.size() + b.size() - 1, T());
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < b.size(); ++j) {
+            result[i + j] += a[i] * b[j];
+        }
+    }
+    return result;
+}
+std::vector<double> polynomialMultiply(const std::vector<double>& a, const std::vector<double>& b);
+std::vector<Complex> polynomialMultiply(const std::vector<Complex>& a, const std::vector<Complex>& b);
+
+/**
+ * @brief Значения многочлена в массиве точек
+ */
+template <typename T>
+void polynomialEvaluate(const std::vector<T>& coefficients, const T* points, T* result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        T value = coefficients.back();
+        for (size_t k = coefficients.size() - 1; k-- > 0;) {
+            value = value * points[i] + coefficients[k];
+        }
+        result[i] = value;
+    }
+}
+void polynomialEvaluate(const std::vector<Complex>& coefficients, const Complex* points, Complex* result,
+                        size_t count);
+
+/**
+ * @brief Корни многочлена с комплексными коэффициентами
+ */
+std::vector<Complex> polynomialRoots(const std::vector<Complex>& coefficients, const RootFinderOptions& options);
+std::vector<Complex> polynomialRoots(const std::vector<double>& coefficients, const RootFinderOptions& options);
+
+/**
+ * @class Polynomial
+ * @brief Многочлен с коэффициентами типа T
+ * @tparam T Тип коэффициентов (double, Complex, Fraction)
+ *
+ * Коэффициенты хранятся по возрастанию степеней; старшие нулевые
+ * коэффициенты отбрасываются, поэтому степень всегда точна. Значение
+ * вычисляется схемой Горнера без возведения в степень. Для double и Complex
+ * умножение выполняется сверткой (через БПФ для больших степеней), пакетное
+ * вычисление обрабатывает несколько точек одновременно в раздельных
+ * массивах частей, а корни находятся одновременными итерациями Аберта.
+ */
+template <typename T>
+class Polynomial {
+private:
+    std::vector<T> coefficients_;  ///< Коэффициенты a0, a1, ..., an
+
+    void trim() {
+        while (coefficients_.size() > 1 && isZeroCoefficient(coefficients_.back())) {
+            coefficients_.pop_back();
+        }
+        if (coefficients_.empty()) {
+            coefficients_.push_back(T());
+        }
+    }
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает нулевой многочлен
+     */
+    Polynomial() : coefficients_(1, T()) {}
+
+    /**
+     * @brief Конструктор константы
+     * @param constant Свободный член
+     */
+    Polynomial(const T& constant) : coefficients_(1, constant) {}
+
+    /**
+     * @brief Конструктор из коэффициентов
+     * @param coefficients Коэффициенты по возрастанию степеней
+     */
+    explicit Polynomial(const std::vector<T>& coefficients) : coefficients_(coefficients) {
+        trim();
+    }
+
+    // Методы доступа
+    /**
+     * @brief Получить степень многочлена
+     * @return Степень (0 для констант, в том числе для нуля)
+     */
+    size_t degree() const {
+        return coefficients_.size() - 1;
+    }
+
+    /**
+     * @brief Получить коэффициент при x^power
+     * @param power Степень
+     * @return Коэффициент (ноль для степеней выше degree())
+     */
+    T coefficient(size_t power) const {
+        return power < coefficients_.size() ? coefficients_[power] : T();
+    }
+
+    /**
+     * @brief Получить все коэффициенты
+     * @return Коэффициенты по возрастанию степеней
+     */
+    const std::vector<T>& getCoefficients() const {
+        return coefficients_;
+    }
+
+    /**
+     * @brief Проверить, является ли многочлен нулевым
+     * @return true для нулевого многочлена
+     */
+    bool isZero() const {
+        return coefficients_.size() == 1 && isZeroCoefficient(coefficients_[0]);
+    }
+
+    // Вычисление
+    /**
+     * @brief Значение многочлена схемой Горнера
+     * @param x Точка
+     * @return p(x)
+     */
+    T evaluate(const T& x) const {
+        T value = coefficients_.back();
+        for (size_t k = coefficients_.size() - 1; k-- > 0;) {
+            value = value * x + coefficients_[k];
+        }
+        return value;
+    }
+
+    /**
+     * @brief Значение многочлена
+     * @param x Точка
+     * @return p(x)
+     */
+    T operator()(const T& x) const {
+        return evaluate(x);
+    }
+
+    /**
+     * @brief Значения многочлена в массиве точек
+     * @param points Точки
+     * @return Значения в том же порядке
+     */
+    std::vector<T> evaluate(const std::vector<T>& points) const {
+        std::vector<T> result(points.size());
+        if (!points.empty()) {
+            polynomialEvaluate(coefficients_, &points[0], &result[0], points.size());
+        }
+        return result;
+    }
+
+    /**
+     * @brief Производная
+     * @return p'(x)
+     */
+    Polynomial derivative() const {
+        if (coefficients_.size() == 1) {
+            return Polynomial();
+        }
+        std::vector<T> result(coefficients_.size() - 1);
+        for (size_t k = 1; k < coefficients_.size(); ++k) {
+            result[k - 1] = coefficients_[k] * T(static_cast<double>(k));
+        }
+        return Polynomial(result);
+    }
+
+    /**
+     * @brief Корни многочлена (только для double и Complex)
+     * @param options Параметры итераций
+     * @return degree() корней с учетом кратности
+     * @throw std::invalid_argument если многочлен нулевой
+     */
+    std::vector<Complex> roots(const RootFinderOptions& options = RootFinderOptions()) const {
+        if (isZero()) {
+            throw std::invalid_argument("Нулевой многочлен имеет бесконечно много корней");
+        }
+        return polynomialRoots(coefficients_, options);
+    }
+
+    // Операции
+    /**
+     * @brief Сумма многочленов
+     * @param other Второе слагаемое
+     * @return Сумма
+     */
+    Polynomial operator+(const Polynomial& other) const {
+        std::vector<T> result(std::max(coefficients_.size(), other.coefficients_.size()), T());
+        for (size_t k = 0; k < result.size(); ++k) {
+            result[k] = coefficient(k) + other.coefficient(k);
+        }
+        return Polynomial(result);
+    }
+
+    /**
+     * @brief Разность многочленов
+     * @param other Вычитаемое
+     * @return Разность
+     */
+    Polynomial operator-(const Polynomial& other) const {
+        std::vector<T> result(std::max(coefficients_.size(), other.coefficients_.size()), T());
+        for (size_t k = 0; k < result.size(); ++k) {
+            result[k] = coefficient(k) - other.coefficient(k);
+        }
+        return Polynomial(result);
+    }
+
+    /**
+     * @brief Произведение многочленов
+     * @param other Второй множитель
+     * @return Произведение
+     */
+    Polynomial operator*(const Polynomial& other) const {
+        return Polynomial(polynomialMultiply(coefficients_, other.coefficients_));
+    }
+
+    /**
+     * @brief Оператор равенства (по оператору == коэффициентов)
+     * @param other Второй многочлен
+     * @return true если коэффициенты равны
+     */
+    bool operator==(const Polynomial& other) const {
+        return coefficients_ == other.coefficients_;
+    }
+
+    /**
+     * @brief Оператор неравенства
+     * @param other Второй многочлен
+     * @return true если многочлены различаются
+     */
+    bool operator!=(const Polynomial& other) const {
+        return !(*this == other);
+    }
+
+    // Статические методы
+    /**
+     * @brief Построить многочлен по корням: (x - r1)(x - r2)...
+     * @param roots Корни
+     * @return Приведенный многочлен
+     */
+    static Polynomial fromRoots(const std::vector<T>& roots) {
+        Polynomial result(T(1.0));
+        for (size_t i = 0; i < roots.size(); ++i) {
+            std::vector<T> factor(2);
+            factor[0] = T() - roots[i];
+            factor[1] = T(1.0);
+            result = result * Polynomial(factor);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Найти корни нескольких многочленов
+     * @param polynomials Многочлены
+     * @param options Параметры итераций
+     * @return Корни каждого многочлена
+     *
+     * Многочлены обрабатываются параллельно, если это разрешено options.
+     */
+    static std::vector<std::vector<Complex> > rootsBatch(const std::vector<Polynomial>& polynomials,
+                                                         const RootFinderOptions& options = RootFinderOptions());
+
+    // Дружественные функции
+    /**
+     * @brief Оператор вывода в поток
+     * @param os Выходной поток
+     * @param polynomial Многочлен
+     * @return Ссылка на поток
+     */
+    friend std::ostream& operator<<(std::ostream& os, const Polynomial& polynomial) {
+        bool first = true;
+        for (size_t k = polynomial.coefficients_.size(); k-- > 0;) {
+            if (!isZeroCoefficient(polynomial.coefficients_[k]) || (first && k == 0)) {
+                if (!first) os << " + ";
+                os << "(" << polynomial.coefficients_[k] << ")";
+                if (k > 0) os << "x";
+                if (k > 1) os << "^" << k;
+                first = false;
+            }
+        }
+        return os;
+    }
+};
+
+template <typename T>
+std::vector<std::vector<Complex> > Polynomial<T>::rootsBatch(const std::vector<Polynomial>& polynomials,
+                                                             const RootFinderOptions& options) {
+    std::vector<std::vector<Complex> > result(polynomials.size());
+    // Внутри одного многочлена работаем последовательно: потоки уже
+    // заняты независимыми многочленами
+    RootFinderOptions single = options;
+    single.parallel = false;
+    auto solve = [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = polynomials[i].roots(single);
+        }
+    };
+    if (options.parallel) {
+        Parallel::forEachBlock(polynomials.size(), 1, solve);
+    } else {
+        solve(0, 0, polynomials.size());
+    }
+    return result;
+}
+
+#endif // POLYNOMIAL_H
@@ -0,0 +1,383 @@
+/**
+ * @file QuantizedMatrix.cpp
+ * @brief Реализация квантованных матриц
+ */
+
+#include "QuantizedMatrix.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__AVXVNNI__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+const size_t QuantizedMatrix::MAX_INT8_DEPTH;
+
+namespace {
+
+const size_t QUANT_ROW_BLOCK = 16;      ///< Строк A в задаче одного потока
+const size_t INT8_DOT_BLOCK = 65536;    ///< Слагаемых int8, накапливаемых в int32
+const size_t DOT_LANES = 16;            ///< Независимых накопителей на столбец результата
+
+/**
+ * @brief Свойства целого типа хранения
+ *
+ * Acc - тип накопителя свертки, block() - сколько произведений можно
+ * сложить в Acc без переполнения.
+ */
+template <typename T> struct QuantTraits;
+
+template <> struct QuantTraits<int8_t> {
+    typedef int32_t Acc;
+    static const int32_t MIN = -128;
+    static const int32_t MAX = 127;
+    static size_t block() { return INT8_DOT_BLOCK; }
+};
+
+template <> struct QuantTraits<int16_t> {
+    typedef int64_t Acc;
+    static const int32_t MIN = -32768;
+    static const int32_t MAX = 32767;
+    static size_t block() { return static_cast<size_t>(-1); }
+};
+
+/**
+ * @brief Масштаб и нулевая точка для диапазона [low, high]
+ */
+template <typename T>
+void chooseParameters(double low, double high, double& scale, int32_t& zeroPoint) {
+    const int32_t qmin = QuantTraits<T>::MIN;
+    const int32_t qmax = QuantTraits<T>::MAX;
+    low = std::min(low, 0.0);
+    high = std::max(high, 0.0);
+    if (!(high > low)) {
+        scale = 1.0;
+        zeroPoint = 0;
+        return;
+    }
+    scale = (high - low) / static_cast<double>(qmax - qmin);
+    const double zero = qmin - low / scale;
+    zeroPoint = static_cast<int32_t>(std::max<double>(qmin, std::min<double>(qmax, std::floor(zero + 0.5))));
+}
+
+template <typename T>
+void quantizeRows(const Matrix& matrix, QuantizedMatrix::Granularity granularity, std::vector<T>& data,
+                  std::vector<double>& scales, std::vector<int32_t>& zeroPoints, std::vector<int64_t>& rowSums) {
+    const size_t rows = matrix.getRows();
+    const size_t cols = matrix.getCols();
+    const bool perRow = granularity == QuantizedMatrix::PER_ROW;
+    const size_t groups = perRow ? rows : 1;
+    scales.assign(groups, 1.0);
+    zeroPoints.assign(groups, 0);
+    rowSums.assign(rows, 0);
+    data.assign(rows * cols, 0);
+
+    std::vector<double> low(groups, 0.0);
+    std::vector<double> high(groups, 0.0);
+    for (size_t i = 0; i < rows; ++i) {
+        const std::vector<double>& row = matrix[i];
+        const size_t g = perRow ? i : 0;
+        for (size_t j = 0; j < cols; ++j) {
+            // std::min и std::max молча пропустили бы NaN в масштаб или в q = 127
+            if (!std::isfinite(row[j])) {
+                throw std::invalid_argument("Квантуемая матрица содержит NaN или бесконечность");
+            }
+            low[g] = std::min(low[g], row[j]);
+            high[g] = std::max(high[g], row[j]);
+        }
+    }
+    for (size_t g = 0; g < groups; ++g) {
+        chooseParameters<T>(low[g], high[g], scales[g], zeroPoints[g]);
+    }
+
+    const double qmin = QuantTraits<T>::MIN;
+    const double qmax = QuantTraits<T>::MAX;
+    for (size_t i = 0; i < rows; ++i) {
+        const std::vector<double>& row = matrix[i];
+        const size_t g = perRow ? i : 0;
+        const double inverse = 1.0 / scales[g];
+        const double zero = zeroPoints[g];
+        T* out = &data[i * cols];
+        int64_t sum = 0;
+        for (size_t j = 0; j < cols; ++j) {
+            const double q = std::max(qmin, std::min(qmax, std::floor(row[j] * inverse + 0.5) + zero));
+            out[j] = static_cast<T>(q);
+            sum += out[j];
+        }
+        rowSums[i] = sum;
+    }
+}
+
+/**
+ * @brief Векторная часть сверток на отрезке [p, end)
+ * @return Позиция, с которой продолжает скалярный цикл
+ *
+ * Для int16 векторного пути нет: пара произведений -32768 * -32768
+ * не помещается в int32 команды madd.
+ */
+template <typename T>
+size_t dot4Vector(const T*, const T*, const T*, const T*, const T*, size_t p, size_t, int64_t*) {
+    return p;
+}
+
+#if defined(__AVXVNNI__) || defined(__AVX2__)
+
+/**
+ * @brief Сумма восьми int32 регистра в int64
+ */
+inline int64_t horizontalSum(__m256i v) {
+    int32_t lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), v);
+    int64_t sum = 0;
+    for (size_t u = 0; u < 8; ++u) sum += lanes[u];
+    return sum;
+}
+
+/**
+ * @brief Векторные свертки int8
+ *
+ * AVX-VNNI (-mavxvnni): vpdpbusd умножает байты без знака на байты со
+ * знаком и складывает четверки в int32 без насыщения. Строка a сдвигается
+ * в беззнаковый диапазон (a + 128 = a xor 0x80), а лишнее 128 * sum(b)
+ * вычитается вторым накопителем.
+ *
+ * AVX2: байты расширяются до int16 и перемножаются vpmaddwd. Путь через
+ * vpmaddubsw не годится: для -128 * -128 сумма пары насыщается в int16.
+ *
+ * В обоих случаях одна ячейка int32 за блок из INT8_DOT_BLOCK слагаемых
+ * набирает не больше 65536 * 255 * 128 < 2^31.
+ */
+template <>
+size_t dot4Vector<int8_t>(const int8_t* a, const int8_t* b0, const int8_t* b1, const int8_t* b2,
+                          const int8_t* b3, size_t p, size_t end, int64_t* total) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = zero, acc1 = zero, acc2 = zero, acc3 = zero;
+#if defined(__AVXVNNI__)
+    const __m256i offset = _mm256_set1_epi8(static_cast<char>(0x80));
+    __m256i bias0 = zero, bias1 = zero, bias2 = zero, bias3 = zero;
+    for (; p + 32 <= end; p += 32) {
+        const __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + p)), offset);
+        const __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b0 + p));
+        const __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b1 + p));
+        const __m256i y2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b2 + p));
+        const __m256i y3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b3 + p));
+        acc0 = _mm256_dpbusd_avx_epi32(acc0, x, y0);
+        acc1 = _mm256_dpbusd_avx_epi32(acc1, x, y1);
+        acc2 = _mm256_dpbusd_avx_epi32(acc2, x, y2);
+        acc3 = _mm256_dpbusd_avx_epi32(acc3, x, y3);
+        bias0 = _mm256_dpbusd_avx_epi32(bias0, offset, y0);
+        bias1 = _mm256_dpbusd_avx_epi32(bias1, offset, y1);
+        bias2 = _mm256_dpbusd_avx_epi32(bias2, offset, y2);
+        bias3 = _mm256_dpbusd_avx_epi32(bias3, offset, y3);
+    }
+    total[0] -= horizontalSum(bias0);
+    total[1] -= horizontalSum(bias1);
+    total[2] -= horizontalSum(bias2);
+    total[3] -= horizontalSum(bias3);
+#else
+    for (; p + 16 <= end; p += 16) {
+        const __m256i x = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + p)));
+        const __m256i y0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b0 + p)));
+        const __m256i y1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b1 + p)));
+        const __m256i y2 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b2 + p)));
+        const __m256i y3 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b3 + p)));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(x, y0));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(x, y1));
+        acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(x, y2));
+        acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(x, y3));
+    }
+#endif
+    total[0] += horizontalSum(acc0);
+    total[1] += horizontalSum(acc1);
+    total[2] += horizontalSum(acc2);
+    total[3] += horizontalSum(acc3);
+    return p;
+}
+
+#endif
+
+/**
+ * @brief Свертки строки a с четырьмя строками B^T
+ *
+ * Строка a читается один раз на четыре столбца результата. Для int8 при
+ * -mavx2 или -mavxvnni основную часть блока считает dot4Vector; остаток
+ * (или весь блок без этих флагов) накапливается в DOT_LANES независимых
+ * накопителях на столбец. Накопители Acc складываются в int64 блоками,
+ * не допускающими переполнения.
+ */
+template <typename T>
+void dot4(const T* a, const T* b0, const T* b1, const T* b2, const T* b3, size_t k, int64_t* out) {
+    typedef typename QuantTraits<T>::Acc Acc;
+    int64_t total[4] = { 0, 0, 0, 0 };
+    const size_t block = QuantTraits<T>::block();
+    for (size_t p = 0; p < k; p += std::min(block, k - p)) {
+        const size_t end = p + std::min(block, k - p);
+        Acc acc[4][DOT_LANES] = {};
+        size_t q = dot4Vector(a, b0, b1, b2, b3, p, end, total);
+        for (; q + DOT_LANES <= end; q += DOT_LANES) {
+            for (size_t u = 0; u < DOT_LANES; ++u) {
+                const Acc x = a[q + u];
+                acc[0][u] += x * b0[q + u];
+                acc[1][u] += x * b1[q + u];
+                acc[2][u] += x * b2[q + u];
+                acc[3][u] += x * b3[q + u];
+            }
+        }
+        for (; q < end; ++q) {
+            const Acc x = a[q];
+            acc[0][0] += x * b0[q];
+            acc[1][0] += x * b1[q];
+            acc[2][0] += x * b2[q];
+            acc[3][0] += x * b3[q];
+        }
+        for (size_t r = 0; r < 4; ++r) {
+            Acc sum = 0;
+            for (size_t u = 0; u < DOT_LANES; ++u) sum += acc[r][u];
+            total[r] += sum;
+        }
+    }
+    std::copy(total, total + 4, out);
+}
+
+/**
+ * @brief Целые свертки строк [begin, end) A со всеми строками B^T
+ * @param emit Функция emit(i, j, dot)
+ */
+template <typename T, typename Emit>
+void multiplyRows(const T* a, const T* b, size_t n, size_t k, size_t begin, size_t end, Emit emit) {
+    int64_t dots[4];
+    for (size_t i = begin; i < end; ++i) {
+        const T* ai = a + i * k;
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            const T* bj = b + j * k;
+            dot4(ai, bj, bj + k, bj + 2 * k, bj + 3 * k, k, dots);
+            for (size_t r = 0; r < 4; ++r) emit(i, j + r, dots[r]);
+        }
+        for (; j < n; ++j) {
+            const T* bj = b + j * k;
+            dot4(ai, bj, bj, bj, bj, k, dots);
+            emit(i, j, dots[0]);
+        }
+    }
+}
+
+} // namespace
+
+// Конструкторы
+QuantizedMatrix::QuantizedMatrix() : rows_(0), cols_(0), precision_(INT8), granularity_(PER_TENSOR) {}
+
+QuantizedMatrix QuantizedMatrix::quantize(const Matrix& matrix, Precision precision, Granularity granularity) {
+    QuantizedMatrix result;
+    result.rows_ = matrix.getRows();
+    result.cols_ = matrix.getCols();
+    result.precision_ = precision;
+    result.granularity_ = granularity;
+    if (precision == INT8) {
+        quantizeRows(matrix, granularity, result.data8_, result.scales_, result.zeroPoints_, result.rowSums_);
+    } else {
+        quantizeRows(matrix, granularity, result.data16_, result.scales_, result.zeroPoints_, result.rowSums_);
+    }
+    return result;
+}
+
+Matrix QuantizedMatrix::dequantize() const {
+    Matrix result(rows_, cols_);
+    for (size_t i = 0; i < rows_; ++i) {
+        std::vector<double>& row = result[i];
+        const double scale = scales_[group(i)];
+        const int32_t zero = zeroPoints_[group(i)];
+        for (size_t j = 0; j < cols_; ++j) {
+            const int32_t q = precision_ == INT8 ? data8_[i * cols_ + j] : data16_[i * cols_ + j];
+            row[j] = scale * (q - zero);
+        }
+    }
+    return result;
+}
+
+// Методы доступа
+double QuantizedMatrix::getScale(size_t row) const {
+    if (row >= rows_) {
+        throw std::out_of_range("Индекс строки вне границ");
+    }
+    return scales_[group(row)];
+}
+
+int32_t QuantizedMatrix::getZeroPoint(size_t row) const {
+    if (row >= rows_) {
+        throw std::out_of_range("Индекс строки вне границ");
+    }
+    return zeroPoints_[group(row)];
+}
+
+int32_t QuantizedMatrix::getRaw(size_t row, size_t col) const {
+    if (row >= rows_ || col >= cols_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    return precision_ == INT8 ? data8_[row * cols_ + col] : data16_[row * cols_ + col];
+}
+
+double QuantizedMatrix::get(size_t row, size_t col) const {
+    return getScale(row) * (getRaw(row, col) - getZeroPoint(row));
+}
+
+size_t QuantizedMatrix::memoryUsage() const {
+    return sizeof(QuantizedMatrix) + data8_.size() * sizeof(int8_t) + data16_.size() * sizeof(int16_t) +
+           scales_.size() * sizeof(double) + zeroPoints_.size() * sizeof(int32_t) +
+           rowSums_.size() * sizeof(int64_t);
+}
+
+// Умножение
+Matrix QuantizedMatrix::multiply(const QuantizedMatrix& a, const QuantizedMatrix& bTransposed) {
+    const QuantizedMatrix& b = bTransposed;
+    if (a.cols_ != b.cols_) {
+        throw std::invalid_argument("Несовместимые размеры для умножения матриц");
+    }
+    if (a.precision_ != b.precision_) {
+        throw std::invalid_argument("Разрядности квантованных матриц различаются");
+    }
+    const size_t m = a.rows_;
+    const size_t n = b.rows_;
+    const size_t k = a.cols_;
+    Matrix result(m, n);
+    if (m == 0 || n == 0) return result;
+
+    // C[i][j] = sA * sB * (sum(qa * qb) - zB * sum(qa) - zA * sum(qb) + k * zA * zB)
+    auto emit = [&](size_t i, size_t j, int64_t dot) {
+        const int64_t za = a.zeroPoints_[a.group(i)];
+        const int64_t zb = b.zeroPoints_[b.group(j)];
+        const int64_t corrected = dot - zb * a.rowSums_[i] - za * b.rowSums_[j] + static_cast<int64_t>(k) * za * zb;
+        result[i][j] = a.scales_[a.group(i)] * b.scales_[b.group(j)] * static_cast<double>(corrected);
+    };
+    auto process = [&](size_t, size_t begin, size_t end) {
+        if (a.precision_ == INT8) {
+            multiplyRows(a.data8_.data(), b.data8_.data(), n, k, begin, end, emit);
+        } else {
+            multiplyRows(a.data16_.data(), b.data16_.data(), n, k, begin, end, emit);
+        }
+    };
+    Parallel::forEachBlock(m, QUANT_ROW_BLOCK, process);
+    return result;
+}
+
+void QuantizedMatrix::multiplyRaw(const QuantizedMatrix& a, const QuantizedMatrix& bTransposed, int32_t* result) {
+    const QuantizedMatrix& b = bTransposed;
+    if (a.precision_ != INT8 || b.precision_ != INT8) {
+        throw std::invalid_argument("Целочисленное умножение int32 определено для матриц INT8");
+    }
+    if (a.cols_ != b.cols_) {
+        throw std::invalid_argument("Несовместимые размеры для умножения матриц");
+    }
+    if (a.cols_ > MAX_INT8_DEPTH) {
+        throw std::invalid_argument("Длина строки превышает MAX_INT8_DEPTH, возможно переполнение int32");
+    }
+    const size_t n = b.rows_;
+    auto emit = [&](size_t i, size_t j, int64_t dot) {
+        result[i * n + j] = static_cast<int32_t>(dot);
+    };
+    Parallel::forEachBlock(a.rows_, QUANT_ROW_BLOCK, [&](size_t, size_t begin, size_t end) {
+        multiplyRows(a.data8_.data(), b.data8_.data(), n, a.cols_, begin, end, emit);
+    });
+}
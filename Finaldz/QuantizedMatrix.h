@@ -0,0 +1,149 @@
+/**
+ * @file QuantizedMatrix.h
+ * @brief Квантованные матрицы int8/int16 и их целочисленное умножение
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef QUANTIZEDMATRIX_H
+#define QUANTIZEDMATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * @class QuantizedMatrix
+ * @brief Матрица целых int8 или int16 с аффинным масштабом
+ *
+ * Элемент хранится как целое q, а значение восстанавливается как
+ * x = scale * (q - zeroPoint). Масштаб и нулевая точка общие для всей
+ * матрицы (PER_TENSOR) или свои для каждой строки (PER_ROW); диапазон
+ * каждой группы расширяется до нуля, чтобы ноль представлялся точно.
+ * Матрица int8 занимает в 8 раз меньше памяти, чем Matrix.
+ *
+ * Умножение выполняется над целыми: произведения int8 накапливаются
+ * в int32 (блоками, поэтому переполнения нет при любой длине строки),
+ * произведения int16 - в int64, после чего поправки на нулевые точки
+ * и масштабы применяются один раз к каждому элементу результата.
+ * Свертки int8 при сборке с -mavx2 или -mavxvnni выполняются
+ * командами vpmaddwd или vpdpbusd, в остальных случаях - скалярным циклом.
+ *
+ * Правый множитель передается транспонированным (quantize(B.transpose())):
+ * тогда строки обоих операндов идут вдоль общего измерения, а масштаб
+ * строки B^T - это масштаб столбца результата, и поправки разделяются.
+ */
+class QuantizedMatrix {
+public:
+    /**
+     * @brief Разрядность целых
+     */
+    enum Precision {
+        INT8,    ///< -128..127
+        INT16    ///< -32768..32767
+    };
+
+    /**
+     * @brief Область действия масштаба и нулевой точки
+     */
+    enum Granularity {
+        PER_TENSOR,  ///< Одни на всю матрицу
+        PER_ROW      ///< Свои для каждой строки
+    };
+
+private:
+    size_t rows_;                      ///< Количество строк
+    size_t cols_;                      ///< Количество столбцов
+    Precision precision_;              ///< Разрядность
+    Granularity granularity_;          ///< Область действия масштаба
+    std::vector<int8_t> data8_;        ///< Значения INT8 по строкам
+    std::vector<int16_t> data16_;      ///< Значения INT16 по строкам
+    std::vector<double> scales_;       ///< Масштаб (один или на строку)
+    std::vector<int32_t> zeroPoints_;  ///< Нулевая точка (одна или на строку)
+    std::vector<int64_t> rowSums_;     ///< Суммы целых по строкам (для поправок)
+
+    size_t group(size_t row) const { return granularity_ == PER_ROW ? row : 0; }
+
+public:
+    static const size_t MAX_INT8_DEPTH = 131071;  ///< Наибольшее k без переполнения int32 ((2^31 - 1) / 128^2)
+
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустую матрицу
+     */
+    QuantizedMatrix();
+
+    /**
+     * @brief Квантовать матрицу
+     * @param matrix Исходная матрица
+     * @param precision Разрядность
+     * @param granularity Область действия масштаба
+     * @return Квантованная матрица
+     * @throw std::invalid_argument если матрица содержит NaN или бесконечность
+     */
+    static QuantizedMatrix quantize(const Matrix& matrix, Precision precision = INT8,
+                                    Granularity granularity = PER_ROW);
+
+    /**
+     * @brief Восстановить матрицу double
+     */
+    Matrix dequantize() const;
+
+    // Методы доступа
+    size_t getRows() const { return rows_; }
+    size_t getCols() const { return cols_; }
+    Precision getPrecision() const { return precision_; }
+    Granularity getGranularity() const { return granularity_; }
+
+    /**
+     * @brief Масштаб строки
+     * @throw std::out_of_range если номер строки вне границ
+     */
+    double getScale(size_t row) const;
+
+    /**
+     * @brief Нулевая точка строки
+     * @throw std::out_of_range если номер строки вне границ
+     */
+    int32_t getZeroPoint(size_t row) const;
+
+    /**
+     * @brief Хранимое целое значение
+     * @throw std::out_of_range если индексы вне границ
+     */
+    int32_t getRaw(size_t row, size_t col) const;
+
+    /**
+     * @brief Восстановленное значение элемента
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t row, size_t col) const;
+
+    /**
+     * @brief Объем занимаемой памяти в байтах
+     */
+    size_t memoryUsage() const;
+
+    // Умножение
+    /**
+     * @brief Произведение A * B, где B передана транспонированной
+     * @param a Квантованная A (m x k)
+     * @param bTransposed Квантованная B^T (n x k)
+     * @return Восстановленное произведение (m x n)
+     * @throw std::invalid_argument если число столбцов или разрядности различаются
+     */
+    static Matrix multiply(const QuantizedMatrix& a, const QuantizedMatrix& bTransposed);
+
+    /**
+     * @brief Целочисленное произведение int8 x int8 -> int32 без поправок
+     * @param a Квантованная A (m x k), INT8
+     * @param bTransposed Квантованная B^T (n x k), INT8
+     * @param result Суммы q_a * q_b по строкам (m * n чисел)
+     * @throw std::invalid_argument если разрядность не INT8, число столбцов
+     *        различается или k > MAX_INT8_DEPTH (возможно переполнение int32)
+     */
+    static void multiplyRaw(const QuantizedMatrix& a, const QuantizedMatrix& bTransposed, int32_t* result);
+};
+
+#endif // QUANTIZEDMATRIX_H
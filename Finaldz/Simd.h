@@ -0,0 +1,130 @@
+/**
+ * @file Simd.h
+ * @brief Тонкая обертка над векторными регистрами для чисел double
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+
+#if defined(__AVX512F__) || defined(__AVX__) || defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define MATH_SIMD 1
+#else
+#define MATH_SIMD 0
+#endif
+
+/**
+ * @def MATH_RESTRICT
+ * @brief Указатель не пересекается с другими указателями функции
+ *
+ * Без этого обещания компилятор не векторизует цикл, пишущий через один
+ * указатель и читающий через другой, или добавляет проверку пересечения,
+ * которую не допускает модель стоимости -O2.
+ */
+#if defined(_MSC_VER)
+#define MATH_RESTRICT __restrict
+#else
+#define MATH_RESTRICT __restrict__
+#endif
+
+#if MATH_SIMD
+
+/**
+ * @namespace Simd
+ * @brief Операции над WIDTH числами double одной командой
+ *
+ * Ширина выбирается по флагам компилятора: AVX-512 (-mavx512f) - 8,
+ * AVX (-mavx, -mavx2, /arch:AVX2) - 4, иначе SSE2, обязательный для
+ * x86-64, - 2. На других платформах MATH_SIMD равен нулю, и вызывающий
+ * код использует только скалярные циклы, которые в любом случае
+ * обрабатывают хвост массива.
+ */
+namespace Simd {
+
+#if defined(__AVX512F__)
+
+    const size_t WIDTH = 8;
+    typedef __m512d Doubles;
+    typedef __mmask8 Mask;
+
+    inline Doubles load(const double* p) { return _mm512_loadu_pd(p); }
+    inline void store(double* p, Doubles a) { _mm512_storeu_pd(p, a); }
+    inline Doubles broadcast(double value) { return _mm512_set1_pd(value); }
+    inline Doubles add(Doubles a, Doubles b) { return _mm512_add_pd(a, b); }
+    inline Doubles sub(Doubles a, Doubles b) { return _mm512_sub_pd(a, b); }
+    inline Doubles mul(Doubles a, Doubles b) { return _mm512_mul_pd(a, b); }
+    inline Doubles div(Doubles a, Doubles b) { return _mm512_div_pd(a, b); }
+    // _mm512_sqrt_pd в GCC 12 вызывает ложное -Wmaybe-uninitialized
+    inline Doubles sqrt(Doubles a) { return _mm512_mask_sqrt_pd(a, 0xFF, a); }
+    inline Mask lessEqual(Doubles a, Doubles b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    inline Mask greater(Doubles a, Doubles b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    inline Mask both(Mask a, Mask b) { return static_cast<Mask>(a & b); }
+    inline Doubles select(Mask mask, Doubles a, Doubles b) { return _mm512_mask_blend_pd(mask, b, a); }
+    inline bool any(Mask mask) { return mask != 0; }
+    inline bool all(Mask mask) { return mask == 0xFF; }
+
+#elif defined(__AVX__)
+
+    const size_t WIDTH = 4;
+    typedef __m256d Doubles;
+    typedef __m256d Mask;
+
+    inline Doubles load(const double* p) { return _mm256_loadu_pd(p); }
+    inline void store(double* p, Doubles a) { _mm256_storeu_pd(p, a); }
+    inline Doubles broadcast(double value) { return _mm256_set1_pd(value); }
+    inline Doubles add(Doubles a, Doubles b) { return _mm256_add_pd(a, b); }
+    inline Doubles sub(Doubles a, Doubles b) { return _mm256_sub_pd(a, b); }
+    inline Doubles mul(Doubles a, Doubles b) { return _mm256_mul_pd(a, b); }
+    inline Doubles div(Doubles a, Doubles b) { return _mm256_div_pd(a, b); }
+    inline Doubles sqrt(Doubles a) { return _mm256_sqrt_pd(a); }
+    inline Mask lessEqual(Doubles a, Doubles b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    inline Mask greater(Doubles a, Doubles b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    inline Mask both(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+    inline Doubles select(Mask mask, Doubles a, Doubles b) { return _mm256_blendv_pd(b, a, mask); }
+    inline bool any(Mask mask) { return _mm256_movemask_pd(mask) != 0; }
+    inline bool all(Mask mask) { return _mm256_movemask_pd(mask) == 0xF; }
+
+#else
+
+    const size_t WIDTH = 2;
+    typedef __m128d Doubles;
+    typedef __m128d Mask;
+
+    inline Doubles load(const double* p) { return _mm_loadu_pd(p); }
+    inline void store(double* p, Doubles a) { _mm_storeu_pd(p, a); }
+    inline Doubles broadcast(double value) { return _mm_set1_pd(value); }
+    inline Doubles add(Doubles a, Doubles b) { return _mm_add_pd(a, b); }
+    inline Doubles sub(Doubles a, Doubles b) { return _mm_sub_pd(a, b); }
+    inline Doubles mul(Doubles a, Doubles b) { return _mm_mul_pd(a, b); }
+    inline Doubles div(Doubles a, Doubles b) { return _mm_div_pd(a, b); }
+    inline Doubles sqrt(Doubles a) { return _mm_sqrt_pd(a); }
+    inline Mask lessEqual(Doubles a, Doubles b) { return _mm_cmple_pd(a, b); }
+    inline Mask greater(Doubles a, Doubles b) { return _mm_cmpgt_pd(a, b); }
+    inline Mask both(Mask a, Mask b) { return _mm_and_pd(a, b); }
+    inline Doubles select(Mask mask, Doubles a, Doubles b) {
+        return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+    }
+    inline bool any(Mask mask) { return _mm_movemask_pd(mask) != 0; }
+    inline bool all(Mask mask) { return _mm_movemask_pd(mask) == 0x3; }
+
+#endif
+
+    /**
+     * @brief Число элементов, обрабатываемых векторными командами
+     * @param count Длина массива
+     * @return count, округленное вниз до кратного WIDTH
+     */
+    inline size_t vectorEnd(size_t count) {
+        return count - count % WIDTH;
+    }
+
+} // namespace Simd
+
+#endif // MATH_SIMD
+
+#endif // SIMD_H
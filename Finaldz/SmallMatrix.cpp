@@ -0,0 +1,161 @@
+/**
+ * @file SmallMatrix.cpp
+ * @brief Реализация формул для матриц 3x3 и 4x4
+ */
+
+#include "SmallMatrix.h"
+
+namespace {
+
+/**
+ * @brief Обратить блок 3x3 с шагом строки stride
+ * @return Определитель блока; result (шаг 3) заполняется при ненулевом определителе
+ */
+inline double invert3(const double* m, int stride, double* result) {
+    const double a00 = m[0], a01 = m[1], a02 = m[2];
+    const double a10 = m[stride], a11 = m[stride + 1], a12 = m[stride + 2];
+    const double a20 = m[2 * stride], a21 = m[2 * stride + 1], a22 = m[2 * stride + 2];
+
+    // Алгебраические дополнения первого столбца обратной матрицы
+    const double c00 = a11 * a22 - a12 * a21;
+    const double c10 = a12 * a20 - a10 * a22;
+    const double c20 = a10 * a21 - a11 * a20;
+    const double det = a00 * c00 + a01 * c10 + a02 * c20;
+    if (det == 0.0) return det;
+
+    const double s = 1.0 / det;
+    result[0] = c00 * s;
+    result[1] = (a02 * a21 - a01 * a22) * s;
+    result[2] = (a01 * a12 - a02 * a11) * s;
+    result[3] = c10 * s;
+    result[4] = (a00 * a22 - a02 * a20) * s;
+    result[5] = (a02 * a10 - a00 * a12) * s;
+    result[6] = c20 * s;
+    result[7] = (a01 * a20 - a00 * a21) * s;
+    result[8] = (a00 * a11 - a01 * a10) * s;
+    return det;
+}
+
+} // namespace
+
+// Определитель
+double SmallMatrix::determinant3(const double* m) {
+    return m[0] * (m[4] * m[8] - m[5] * m[7])
+         + m[1] * (m[5] * m[6] - m[3] * m[8])
+         + m[2] * (m[3] * m[7] - m[4] * m[6]);
+}
+
+double SmallMatrix::determinant4(const double* m) {
+    // Миноры 2x2 верхних (s) и нижних (c) двух строк
+    const double s0 = m[0] * m[5] - m[4] * m[1];
+    const double s1 = m[0] * m[6] - m[4] * m[2];
+    const double s2 = m[0] * m[7] - m[4] * m[3];
+    const double s3 = m[1] * m[6] - m[5] * m[2];
+    const double s4 = m[1] * m[7] - m[5] * m[3];
+    const double s5 = m[2] * m[7] - m[6] * m[3];
+
+    const double c5 = m[10] * m[15] - m[14] * m[11];
+    const double c4 = m[9] * m[15] - m[13] * m[11];
+    const double c3 = m[9] * m[14] - m[13] * m[10];
+    const double c2 = m[8] * m[15] - m[12] * m[11];
+    const double c1 = m[8] * m[14] - m[12] * m[10];
+    const double c0 = m[8] * m[13] - m[12] * m[9];
+
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+// Обратная матрица
+double SmallMatrix::inverse3(const double* m, double* result) {
+    return invert3(m, 3, result);
+}
+
+double SmallMatrix::inverse4(const double* m, double* result) {
+    const double a00 = m[0], a01 = m[1], a02 = m[2], a03 = m[3];
+    const double a10 = m[4], a11 = m[5], a12 = m[6], a13 = m[7];
+    const double a20 = m[8], a21 = m[9], a22 = m[10], a23 = m[11];
+    const double a30 = m[12], a31 = m[13], a32 = m[14], a33 = m[15];
+
+    const double s0 = a00 * a11 - a10 * a01;
+    const double s1 = a00 * a12 - a10 * a02;
+    const double s2 = a00 * a13 - a10 * a03;
+    const double s3 = a01 * a12 - a11 * a02;
+    const double s4 = a01 * a13 - a11 * a03;
+    const double s5 = a02 * a13 - a12 * a03;
+
+    const double c5 = a22 * a33 - a32 * a23;
+    const double c4 = a21 * a33 - a31 * a23;
+    const double c3 = a21 * a32 - a31 * a22;
+    const double c2 = a20 * a33 - a30 * a23;
+    const double c1 = a20 * a32 - a30 * a22;
+    const double c0 = a20 * a31 - a30 * a21;
+
+    const double det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (det == 0.0) return det;
+
+    const double s = 1.0 / det;
+    result[0] = (a11 * c5 - a12 * c4 + a13 * c3) * s;
+    result[1] = (-a01 * c5 + a02 * c4 - a03 * c3) * s;
+    result[2] = (a31 * s5 - a32 * s4 + a33 * s3) * s;
+    result[3] = (-a21 * s5 + a22 * s4 - a23 * s3) * s;
+
+    result[4] = (-a10 * c5 + a12 * c2 - a13 * c1) * s;
+    result[5] = (a00 * c5 - a02 * c2 + a03 * c1) * s;
+    result[6] = (-a30 * s5 + a32 * s2 - a33 * s1) * s;
+    result[7] = (a20 * s5 - a22 * s2 + a23 * s1) * s;
+
+    result[8] = (a10 * c4 - a11 * c2 + a13 * c0) * s;
+    result[9] = (-a00 * c4 + a01 * c2 - a03 * c0) * s;
+    result[10] = (a30 * s4 - a31 * s2 + a33 * s0) * s;
+    result[11] = (-a20 * s4 + a21 * s2 - a23 * s0) * s;
+
+    result[12] = (-a10 * c3 + a11 * c1 - a12 * c0) * s;
+    result[13] = (a00 * c3 - a01 * c1 + a02 * c0) * s;
+    result[14] = (-a30 * s3 + a31 * s1 - a32 * s0) * s;
+    result[15] = (a20 * s3 - a21 * s1 + a22 * s0) * s;
+    return det;
+}
+
+// Аффинные преобразования
+double SmallMatrix::affineInverse3(const double* m, double* result) {
+    const double det = m[0] * m[4] - m[1] * m[3];
+    if (det == 0.0) return det;
+
+    const double s = 1.0 / det;
+    const double r00 = m[4] * s, r01 = -m[1] * s;
+    const double r10 = -m[3] * s, r11 = m[0] * s;
+    result[0] = r00;
+    result[1] = r01;
+    result[2] = -(r00 * m[2] + r01 * m[5]);
+    result[3] = r10;
+    result[4] = r11;
+    result[5] = -(r10 * m[2] + r11 * m[5]);
+    result[6] = 0.0;
+    result[7] = 0.0;
+    result[8] = 1.0;
+    return det;
+}
+
+double SmallMatrix::affineInverse4(const double* m, double* result) {
+    double r[9];
+    const double det = invert3(m, 4, r);
+    if (det == 0.0) return det;
+
+    const double t0 = m[3], t1 = m[7], t2 = m[11];
+    result[0] = r[0];
+    result[1] = r[1];
+    result[2] = r[2];
+    result[3] = -(r[0] * t0 + r[1] * t1 + r[2] * t2);
+    result[4] = r[3];
+    result[5] = r[4];
+    result[6] = r[5];
+    result[7] = -(r[3] * t0 + r[4] * t1 + r[5] * t2);
+    result[8] = r[6];
+    result[9] = r[7];
+    result[10] = r[8];
+    result[11] = -(r[6] * t0 + r[7] * t1 + r[8] * t2);
+    result[12] = 0.0;
+    result[13] = 0.0;
+    result[14] = 0.0;
+    result[15] = 1.0;
+    return det;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file SmallMatrix.h
+ * @brief Определитель и обратная матрица 3x3 и 4x4 в замкнутой форме
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef SMALLMATRIX_H
+#define SMALLMATRIX_H
+
+/**
+ * @class SmallMatrix
+ * @brief Развернутые формулы для матриц преобразований 3x3 и 4x4
+ *
+ * Матрицы задаются 9 или 16 числами по строкам. Вычисления не выделяют
+ * память и не содержат ветвлений: 4x4 раскладывается по шести минорам
+ * 2x2 верхних и шести минорам 2x2 нижних строк, после чего все
+ * алгебраические дополнения - независимые выражения, которые компилятор
+ * выполняет параллельно и векторизует.
+ *
+ * Для аффинных преобразований (последняя строка 0 ... 0 1) обращается
+ * только линейная часть, а сдвиг пересчитывается как -R^-1 * t.
+ * Matrix::determinant(), inverse() и affineInverse() используют эти
+ * функции для порядков 3 и 4.
+ */
+class SmallMatrix {
+public:
+    // Определитель
+    static double determinant3(const double* m);
+    static double determinant4(const double* m);
+
+    // Обратная матрица
+    /**
+     * @brief Обратить матрицу 3x3
+     * @param m Исходная матрица (9 чисел по строкам)
+     * @param result Обратная матрица; не изменяется, если определитель равен нулю
+     * @return Определитель исходной матрицы
+     */
+    static double inverse3(const double* m, double* result);
+
+    /**
+     * @brief Обратить матрицу 4x4
+     * @param m Исходная матрица (16 чисел по строкам)
+     * @param result Обратная матрица; не изменяется, если определитель равен нулю
+     * @return Определитель исходной матрицы
+     */
+    static double inverse4(const double* m, double* result);
+
+    // Аффинные преобразования
+    /**
+     * @brief Обратить аффинное преобразование плоскости (3x3)
+     * @param m Матрица [R t; 0 0 1]; последняя строка не читается
+     * @param result Обратное преобразование; не изменяется при det(R) = 0
+     * @return Определитель линейной части R (равен определителю m)
+     */
+    static double affineInverse3(const double* m, double* result);
+
+    /**
+     * @brief Обратить аффинное преобразование пространства (4x4)
+     * @param m Матрица [R t; 0 0 0 1]; последняя строка не читается
+     * @param result Обратное преобразование; не изменяется при det(R) = 0
+     * @return Определитель линейной части R (равен определителю m)
+     */
+    static double affineInverse4(const double* m, double* result);
+};
+
+#endif // SMALLMATRIX_H
@@ -0,0 +1,377 @@
+/**
+ * @file SpatialHashGrid.cpp
+ * @brief Реализация пространственной хеш-сетки
+ */
+
+#include "SpatialHashGrid.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+const uint64_t EMPTY_KEY = ~0ULL;      ///< Ключ свободного слота
+const uint64_t COORD_MASK = 0x1FFFFF;  ///< 21 бит на координату ячейки
+const size_t PAIR_BLOCK = 1024;        ///< Частиц на одну задачу
+const double CELL_LIMIT = 4503599627370496.0;  ///< 2^52: предел номера ячейки, точный в double
+
+inline size_t hashKey(uint64_t key) {
+    uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 29;
+    return static_cast<size_t>(h);
+}
+
+inline size_t nextPowerOfTwo(size_t value) {
+    size_t result = 16;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+} // namespace
+
+const size_t SpatialHashGrid::NONE;
+
+// Конструктор
+SpatialHashGrid::SpatialHashGrid(double cellSize) : usedCells_(0) {
+    if (!(cellSize > 0.0)) {
+        throw std::invalid_argument("Размер ячейки должен быть положительным");
+    }
+    cellSize_ = cellSize;
+    inverseCellSize_ = 1.0 / cellSize;
+    table_.resize(16);
+    for (auto& cell : table_) {
+        cell.key = EMPTY_KEY;
+        cell.head = NONE;
+    }
+}
+
+// Вспомогательные методы
+int64_t SpatialHashGrid::cellCoord(double value) const {
+    // Приведение NaN, бесконечности или числа вне int64 - неопределенное
+    // поведение, поэтому номер ограничивается до приведения (NaN дает
+    // CELL_LIMIT). Ограничение монотонно и не разносит близкие точки
+    const double cell = std::floor(value * inverseCellSize_);
+    return static_cast<int64_t>(std::max(-CELL_LIMIT, std::min(CELL_LIMIT, cell)));
+}
+
+uint64_t SpatialHashGrid::packKey(int64_t cx, int64_t cy, int64_t cz) {
+    // Координаты берутся по модулю 2^21: совпадение ключей далеких ячеек
+    // дает лишних кандидатов, но не теряет пар
+    return ((static_cast<uint64_t>(cx) & COORD_MASK) << 42) |
+           ((static_cast<uint64_t>(cy) & COORD_MASK) << 21) |
+           (static_cast<uint64_t>(cz) & COORD_MASK);
+}
+
+uint64_t SpatialHashGrid::keyOf(double x, double y, double z) const {
+    return packKey(cellCoord(x), cellCoord(y), cellCoord(z));
+}
+
+size_t SpatialHashGrid::findSlot(uint64_t key) const {
+    const size_t mask = table_.size() - 1;
+    for (size_t slot = hashKey(key) & mask;; slot = (slot + 1) & mask) {
+        if (table_[slot].key == key) return slot;
+        if (table_[slot].key == EMPTY_KEY) return NONE;
+    }
+}
+
+size_t SpatialHashGrid::insertSlot(uint64_t key) {
+    if ((usedCells_ + 1) * 2 > table_.size()) {
+        rehash(table_.size() * 2);
+    }
+    const size_t mask = table_.size() - 1;
+    for (size_t slot = hashKey(key) & mask;; slot = (slot + 1) & mask) {
+        if (table_[slot].key == key) return slot;
+        if (table_[slot].key == EMPTY_KEY) {
+            table_[slot].key = key;
+            table_[slot].head = NONE;
+            ++usedCells_;
+            return slot;
+        }
+    }
+}
+
+void SpatialHashGrid::rehash(size_t capacity) {
+    // Старое содержимое копируется в запасной буфер: после прогрева
+    // его емкости хватает и перестройка не выделяет память
+    scratch_.assign(table_.begin(), table_.end());
+
+    size_t live = 0;
+    for (const auto& cell : scratch_) {
+        if (cell.key != EMPTY_KEY && cell.head != NONE) ++live;
+    }
+    // Если таблица заполнена в основном опустевшими ячейками, размер не растет
+    if (live * 4 <= table_.size() && capacity > table_.size()) {
+        capacity = table_.size();
+    }
+
+    table_.resize(nextPowerOfTwo(capacity));
+    for (auto& cell : table_) {
+        cell.key = EMPTY_KEY;
+        cell.head = NONE;
+    }
+    usedCells_ = 0;
+
+    // Опустевшие ячейки при перестройке отбрасываются
+    const size_t mask = table_.size() - 1;
+    for (const auto& cell : scratch_) {
+        if (cell.key == EMPTY_KEY || cell.head == NONE) continue;
+        size_t slot = hashKey(cell.key) & mask;
+        while (table_[slot].key != EMPTY_KEY) {
+            slot = (slot + 1) & mask;
+        }
+        table_[slot] = cell;
+        ++usedCells_;
+    }
+}
+
+void SpatialHashGrid::link(size_t index) {
+    Cell& cell = table_[insertSlot(cellKey_[index])];
+    prev_[index] = NONE;
+    next_[index] = cell.head;
+    if (cell.head != NONE) {
+        prev_[cell.head] = index;
+    }
+    cell.head = index;
+}
+
+void SpatialHashGrid::unlink(size_t index) {
+    if (prev_[index] != NONE) {
+        next_[prev_[index]] = next_[index];
+    } else {
+        table_[findSlot(cellKey_[index])].head = next_[index];
+    }
+    if (next_[index] != NONE) {
+        prev_[next_[index]] = prev_[index];
+    }
+}
+
+// Методы доступа
+double SpatialHashGrid::getCellSize() const {
+    return cellSize_;
+}
+
+size_t SpatialHashGrid::size() const {
+    return x_.size();
+}
+
+size_t SpatialHashGrid::cellCount() const {
+    size_t count = 0;
+    for (const auto& cell : table_) {
+        if (cell.key != EMPTY_KEY && cell.head != NONE) ++count;
+    }
+    return count;
+}
+
+Vector3D SpatialHashGrid::getPosition(size_t index) const {
+    if (index >= x_.size()) {
+        throw std::out_of_range("Индекс частицы вне границ");
+    }
+    return Vector3D(x_[index], y_[index], z_[index]);
+}
+
+// Построение и обновление
+void SpatialHashGrid::build(const std::vector<Vector3D>& points) {
+    const size_t n = points.size();
+    x_.resize(n);
+    y_.resize(n);
+    z_.resize(n);
+    cellKey_.resize(n);
+    next_.resize(n);
+    prev_.resize(n);
+
+    if (table_.size() < 2 * n) {
+        table_.resize(nextPowerOfTwo(2 * n));
+    }
+    for (auto& cell : table_) {
+        cell.key = EMPTY_KEY;
+        cell.head = NONE;
+    }
+    usedCells_ = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        x_[i] = points[i].getX();
+        y_[i] = points[i].getY();
+        z_[i] = points[i].getZ();
+        cellKey_[i] = keyOf(x_[i], y_[i], z_[i]);
+        link(i);
+    }
+}
+
+void SpatialHashGrid::update(size_t index, const Vector3D& position) {
+    if (index >= x_.size()) {
+        throw std::out_of_range("Индекс частицы вне границ");
+    }
+    x_[index] = position.getX();
+    y_[index] = position.getY();
+    z_[index] = position.getZ();
+
+    uint64_t key = keyOf(x_[index], y_[index], z_[index]);
+    if (key != cellKey_[index]) {
+        unlink(index);
+        cellKey_[index] = key;
+        link(index);
+    }
+}
+
+void SpatialHashGrid::updateAll(const std::vector<Vector3D>& positions) {
+    if (positions.size() != x_.size()) {
+        throw std::invalid_argument("Количество позиций не совпадает с количеством частиц");
+    }
+    for (size_t i = 0; i < positions.size(); ++i) {
+        update(i, positions[i]);
+    }
+}
+
+void SpatialHashGrid::clear() {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    cellKey_.clear();
+    next_.clear();
+    prev_.clear();
+    for (auto& cell : table_) {
+        cell.key = EMPTY_KEY;
+        cell.head = NONE;
+    }
+    usedCells_ = 0;
+}
+
+// Запросы
+void SpatialHashGrid::collectPairs(size_t begin, size_t end, double radius,
+                                   std::vector<CollisionPair>& pairs) const {
+    const double r2 = radius * radius;
+    const double reachCells = std::min(CELL_LIMIT, std::ceil(radius * inverseCellSize_));
+
+    // Если соседних ячеек больше, чем частиц, прямой перебор дешевле
+    // (и единственно возможен при огромном или бесконечном радиусе)
+    const double span = 2.0 * reachCells + 1.0;
+    if (span * span * span > static_cast<double>(x_.size())) {
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t j = i + 1; j < x_.size(); ++j) {
+                double ex = x_[j] - x_[i];
+                double ey = y_[j] - y_[i];
+                double ez = z_[j] - z_[i];
+                if (ex * ex + ey * ey + ez * ez <= r2) {
+                    CollisionPair pair;
+                    pair.first = i;
+                    pair.second = j;
+                    pairs.push_back(pair);
+                }
+            }
+        }
+        return;
+    }
+    const int64_t reach = static_cast<int64_t>(reachCells);
+
+    for (size_t i = begin; i < end; ++i) {
+        const double px = x_[i];
+        const double py = y_[i];
+        const double pz = z_[i];
+        const int64_t cx = cellCoord(px);
+        const int64_t cy = cellCoord(py);
+        const int64_t cz = cellCoord(pz);
+
+        for (int64_t dx = -reach; dx <= reach; ++dx) {
+            for (int64_t dy = -reach; dy <= reach; ++dy) {
+                for (int64_t dz = -reach; dz <= reach; ++dz) {
+                    size_t slot = findSlot(packKey(cx + dx, cy + dy, cz + dz));
+                    if (slot == NONE) continue;
+                    for (size_t j = table_[slot].head; j != NONE; j = next_[j]) {
+                        if (j <= i) continue;
+                        double ex = x_[j] - px;
+                        double ey = y_[j] - py;
+                        double ez = z_[j] - pz;
+                        if (ex * ex + ey * ey + ez * ez <= r2) {
+                            CollisionPair pair;
+                            pair.first = i;
+                            pair.second = j;
+                            pairs.push_back(pair);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void SpatialHashGrid::findPairs(double radius, std::vector<CollisionPair>& pairs, bool parallel) const {
+    pairs.clear();
+    if (!(radius >= 0.0) || x_.empty()) {
+        return;
+    }
+
+    const size_t n = x_.size();
+    if (!parallel || n < 2 * PAIR_BLOCK) {
+        collectPairs(0, n, radius, pairs);
+        return;
+    }
+
+    const size_t blocks = Parallel::blockCount(n, PAIR_BLOCK);
+    if (blockPairs_.size() < blocks) {
+        blockPairs_.resize(blocks);
+    }
+    Parallel::forEachBlock(n, PAIR_BLOCK, [&](size_t block, size_t begin, size_t end) {
+        blockPairs_[block].clear();
+        collectPairs(begin, end, radius, blockPairs_[block]);
+    });
+
+    // Склейка в порядке блоков делает результат независимым от числа потоков
+    for (size_t b = 0; b < blocks; ++b) {
+        pairs.insert(pairs.end(), blockPairs_[b].begin(), blockPairs_[b].end());
+    }
+}
+
+std::vector<CollisionPair> SpatialHashGrid::findPairs(double radius, bool parallel) const {
+    std::vector<CollisionPair> pairs;
+    findPairs(radius, pairs, parallel);
+    return pairs;
+}
+
+void SpatialHashGrid::queryRadius(const Vector3D& center, double radius,
+                                  std::vector<size_t>& result) const {
+    result.clear();
+    if (!(radius >= 0.0) || x_.empty()) {
+        return;
+    }
+
+    const double px = center.getX();
+    const double py = center.getY();
+    const double pz = center.getZ();
+    const double r2 = radius * radius;
+    const int64_t x0 = cellCoord(px - radius), x1 = cellCoord(px + radius);
+    const int64_t y0 = cellCoord(py - radius), y1 = cellCoord(py + radius);
+    const int64_t z0 = cellCoord(pz - radius), z1 = cellCoord(pz + radius);
+
+    // Ячеек в кубе запроса больше, чем частиц: прямой перебор
+    const double cells = static_cast<double>(x1 - x0 + 1) * static_cast<double>(y1 - y0 + 1) *
+                         static_cast<double>(z1 - z0 + 1);
+    if (cells > static_cast<double>(x_.size())) {
+        for (size_t j = 0; j < x_.size(); ++j) {
+            double ex = x_[j] - px;
+            double ey = y_[j] - py;
+            double ez = z_[j] - pz;
+            if (ex * ex + ey * ey + ez * ez <= r2) {
+                result.push_back(j);
+            }
+        }
+        return;
+    }
+
+    for (int64_t cx = x0; cx <= x1; ++cx) {
+        for (int64_t cy = y0; cy <= y1; ++cy) {
+            for (int64_t cz = z0; cz <= z1; ++cz) {
+                size_t slot = findSlot(packKey(cx, cy, cz));
+                if (slot == NONE) continue;
+                for (size_t j = table_[slot].head; j != NONE; j = next_[j]) {
+                    double ex = x_[j] - px;
+                    double ey = y_[j] - py;
+                    double ez = z_[j] - pz;
+                    if (ex * ex + ey * ey + ez * ez <= r2) {
+                        result.push_back(j);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,173 @@
+/**
+ * @file SpatialHashGrid.h
+ * @brief Пространственная хеш-сетка для поиска пар близких частиц
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef SPATIALHASHGRID_H
+#define SPATIALHASHGRID_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Vector3D.h"
+
+/**
+ * @struct CollisionPair
+ * @brief Пара индексов частиц-кандидатов на столкновение (first < second)
+ */
+struct CollisionPair {
+    size_t first;   ///< Индекс первой частицы
+    size_t second;  ///< Индекс второй частицы
+};
+
+/**
+ * @class SpatialHashGrid
+ * @brief Равномерная сетка с хешированием ячеек (broadphase)
+ *
+ * Пространство делится на кубические ячейки со стороной cellSize, непустые
+ * ячейки хранятся в хеш-таблице с открытой адресацией. Частицы одной ячейки
+ * связаны двусвязным списком, поэтому перемещение частицы в другую ячейку
+ * стоит O(1) и не требует перестройки всей сетки.
+ *
+ * Все внутренние массивы сохраняют емкость между кадрами: после первых
+ * кадров обновление и поиск пар не выделяют память, в том числе в
+ * многопоточном режиме (потоки Parallel создаются один раз).
+ *
+ * Номера ячеек ограничены по модулю 2^52, поэтому очень далекие и не
+ * конечные координаты попадают в крайние ячейки; частицы с NaN ни с чем
+ * не образуют пар. Если ячеек в радиусе запроса больше, чем частиц
+ * (например, радиус бесконечен), частицы перебираются напрямую.
+ */
+class SpatialHashGrid {
+private:
+    static const size_t NONE = static_cast<size_t>(-1);  ///< Пустая ссылка
+
+    /**
+     * @brief Ячейка хеш-таблицы
+     */
+    struct Cell {
+        uint64_t key;  ///< Упакованные координаты ячейки
+        size_t head;   ///< Первая частица в ячейке
+    };
+
+    double cellSize_;                 ///< Размер ячейки
+    double inverseCellSize_;          ///< 1 / cellSize_
+    std::vector<double> x_;           ///< Координаты X частиц
+    std::vector<double> y_;           ///< Координаты Y частиц
+    std::vector<double> z_;           ///< Координаты Z частиц
+    std::vector<uint64_t> cellKey_;   ///< Ключ ячейки каждой частицы
+    std::vector<size_t> next_;        ///< Следующая частица в ячейке
+    std::vector<size_t> prev_;        ///< Предыдущая частица в ячейке
+    std::vector<Cell> table_;         ///< Хеш-таблица ячеек
+    std::vector<Cell> scratch_;       ///< Запасной буфер для перестройки таблицы
+    size_t usedCells_;                ///< Количество занятых слотов таблицы
+    mutable std::vector<std::vector<CollisionPair> > blockPairs_;  ///< Буферы потоков
+
+    int64_t cellCoord(double value) const;
+    uint64_t keyOf(double x, double y, double z) const;
+    static uint64_t packKey(int64_t cx, int64_t cy, int64_t cz);
+    size_t findSlot(uint64_t key) const;
+    size_t insertSlot(uint64_t key);
+    void rehash(size_t capacity);
+    void link(size_t index);
+    void unlink(size_t index);
+    void collectPairs(size_t begin, size_t end, double radius,
+                      std::vector<CollisionPair>& pairs) const;
+
+public:
+    /**
+     * @brief Конструктор
+     * @param cellSize Размер ячейки (обычно равен радиусу взаимодействия)
+     * @throw std::invalid_argument если размер ячейки не положительный
+     */
+    explicit SpatialHashGrid(double cellSize = 1.0);
+
+    // Методы доступа
+    /**
+     * @brief Получить размер ячейки
+     * @return Размер ячейки
+     */
+    double getCellSize() const;
+
+    /**
+     * @brief Количество частиц в сетке
+     * @return Количество частиц
+     */
+    size_t size() const;
+
+    /**
+     * @brief Количество непустых ячеек
+     * @return Количество ячеек, в которых есть хотя бы одна частица
+     */
+    size_t cellCount() const;
+
+    /**
+     * @brief Получить позицию частицы
+     * @param index Индекс частицы
+     * @return Позиция
+     * @throw std::out_of_range если индекс вне границ
+     */
+    Vector3D getPosition(size_t index) const;
+
+    // Построение и обновление
+    /**
+     * @brief Заполнить сетку заново
+     * @param points Позиции частиц (индексы частиц совпадают с индексами массива)
+     */
+    void build(const std::vector<Vector3D>& points);
+
+    /**
+     * @brief Переместить одну частицу
+     * @param index Индекс частицы
+     * @param position Новая позиция
+     * @throw std::out_of_range если индекс вне границ
+     */
+    void update(size_t index, const Vector3D& position);
+
+    /**
+     * @brief Переместить все частицы
+     * @param positions Новые позиции
+     * @throw std::invalid_argument если количество позиций не совпадает
+     *
+     * Перевязываются только частицы, сменившие ячейку.
+     */
+    void updateAll(const std::vector<Vector3D>& positions);
+
+    /**
+     * @brief Очистить сетку с сохранением выделенной памяти
+     */
+    void clear();
+
+    // Запросы
+    /**
+     * @brief Найти все пары частиц на расстоянии не больше radius
+     * @param radius Радиус взаимодействия
+     * @param pairs Выходной массив (очищается, емкость сохраняется)
+     * @param parallel Использовать несколько потоков
+     *
+     * Пары упорядочены по первому индексу. Порядок одинаков при любом
+     * количестве потоков. Метод не предназначен для одновременного вызова
+     * из нескольких потоков на одном объекте.
+     */
+    void findPairs(double radius, std::vector<CollisionPair>& pairs, bool parallel = false) const;
+
+    /**
+     * @brief Найти все пары частиц на расстоянии не больше radius
+     * @param radius Радиус взаимодействия
+     * @param parallel Использовать несколько потоков
+     * @return Массив пар
+     */
+    std::vector<CollisionPair> findPairs(double radius, bool parallel = false) const;
+
+    /**
+     * @brief Найти частицы в радиусе от точки
+     * @param center Центр поиска
+     * @param radius Радиус поиска
+     * @param result Выходной массив индексов (очищается, емкость сохраняется)
+     */
+    void queryRadius(const Vector3D& center, double radius, std::vector<size_t>& result) const;
+};
+
+#endif // SPATIALHASHGRID_H
@@ -0,0 +1,199 @@
+/**
+ * @file SpatialOrder.cpp
+ * @brief Реализация упорядочивания точек вдоль пространственных кривых
+ */
+
+#include "SpatialOrder.h"
+#include "BoundingBox.h"
+#include "Parallel.h"
+#include <algorithm>
+
+namespace {
+
+const int CODE_BITS = 21;                     ///< Бит на координату
+const uint32_t CODE_MAX = (1u << CODE_BITS) - 1;
+const int RADIX_BITS = 11;                    ///< Бит на проход сортировки
+const size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+const int RADIX_PASSES = 6;                   ///< 6 * 11 >= 63
+const size_t SORT_BLOCK = 65536;              ///< Элементов на одну задачу
+
+inline uint64_t spreadBits(uint64_t v) {
+    v &= 0x1FFFFF;
+    v = (v | (v << 32)) & 0x1F00000000FFFFULL;
+    v = (v | (v << 16)) & 0x1F0000FF0000FFULL;
+    v = (v | (v << 8)) & 0x100F00F00F00F00FULL;
+    v = (v | (v << 4)) & 0x10C30C30C30C30C3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+/**
+ * @brief Устойчивая поразрядная сортировка пар (ключ, индекс)
+ *
+ * Проходы, в которых все ключи попадают в одну корзину, пропускаются.
+ */
+void radixSort(std::vector<uint64_t>& keys, std::vector<size_t>& values, bool parallel) {
+    const size_t n = keys.size();
+    if (n < 2) return;
+
+    const size_t blockSize = parallel ? SORT_BLOCK : n;
+    const size_t blocks = Parallel::blockCount(n, blockSize);
+    std::vector<size_t> histogram(blocks * RADIX_BUCKETS);
+    std::vector<uint64_t> keyBuffer(n);
+    std::vector<size_t> valueBuffer(n);
+
+    for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+        const int shift = pass * RADIX_BITS;
+        std::fill(histogram.begin(), histogram.end(), 0);
+
+        Parallel::forEachBlock(n, blockSize, [&](size_t block, size_t begin, size_t end) {
+            size_t* counts = &histogram[block * RADIX_BUCKETS];
+            for (size_t i = begin; i < end; ++i) {
+                counts[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+            }
+        });
+
+        // Префиксные суммы в порядке (корзина, блок) сохраняют устойчивость
+        bool trivial = false;
+        size_t running = 0;
+        for (size_t d = 0; d < RADIX_BUCKETS && !trivial; ++d) {
+            size_t bucketTotal = 0;
+            for (size_t b = 0; b < blocks; ++b) {
+                size_t count = histogram[b * RADIX_BUCKETS + d];
+                histogram[b * RADIX_BUCKETS + d] = running;
+                running += count;
+                bucketTotal += count;
+            }
+            trivial = bucketTotal == n;
+        }
+        if (trivial) continue;
+
+        Parallel::forEachBlock(n, blockSize, [&](size_t block, size_t begin, size_t end) {
+            size_t* offsets = &histogram[block * RADIX_BUCKETS];
+            for (size_t i = begin; i < end; ++i) {
+                size_t position = offsets[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+                keyBuffer[position] = keys[i];
+                valueBuffer[position] = values[i];
+            }
+        });
+
+        keys.swap(keyBuffer);
+        values.swap(valueBuffer);
+    }
+}
+
+} // namespace
+
+// Конструкторы
+SpatialOrder::SpatialOrder() : curve_(MORTON) {}
+
+SpatialOrder::SpatialOrder(const std::vector<Vector3D>& points, Curve curve, bool parallel)
+    : curve_(curve) {
+    const size_t n = points.size();
+    const size_t blockSize = parallel ? SORT_BLOCK : (n == 0 ? 1 : n);
+
+    // Границы набора: частичные параллелепипеды блоков объединяются по порядку
+    std::vector<BoundingBox> partial(Parallel::blockCount(n, blockSize));
+    Parallel::forEachBlock(n, blockSize, [&](size_t block, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            partial[block].expand(points[i]);
+        }
+    });
+    BoundingBox box;
+    for (const auto& part : partial) {
+        box.expand(part);
+    }
+
+    double origin[3] = { 0.0, 0.0, 0.0 };
+    double scale[3] = { 0.0, 0.0, 0.0 };
+    if (!box.isEmpty()) {
+        for (int a = 0; a < 3; ++a) {
+            origin[a] = box.minAt(a);
+            double extent = box.maxAt(a) - box.minAt(a);
+            scale[a] = extent > 0.0 ? CODE_MAX / extent : 0.0;
+        }
+    }
+
+    std::vector<uint64_t> keys(n);
+    permutation_.resize(n);
+    Parallel::forEachBlock(n, blockSize, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t q[3];
+            const double p[3] = { points[i].getX(), points[i].getY(), points[i].getZ() };
+            for (int a = 0; a < 3; ++a) {
+                double v = (p[a] - origin[a]) * scale[a];
+                q[a] = v <= 0.0 ? 0u : (v >= CODE_MAX ? CODE_MAX : static_cast<uint32_t>(v));
+            }
+            keys[i] = curve == HILBERT ? hilbertCode(q[0], q[1], q[2])
+                                       : mortonCode(q[0], q[1], q[2]);
+            permutation_[i] = i;
+        }
+    });
+
+    radixSort(keys, permutation_, parallel);
+}
+
+// Методы доступа
+const std::vector<size_t>& SpatialOrder::getPermutation() const {
+    return permutation_;
+}
+
+std::vector<size_t> SpatialOrder::inverse() const {
+    std::vector<size_t> result(permutation_.size());
+    for (size_t i = 0; i < permutation_.size(); ++i) {
+        result[permutation_[i]] = i;
+    }
+    return result;
+}
+
+SpatialOrder::Curve SpatialOrder::getCurve() const {
+    return curve_;
+}
+
+size_t SpatialOrder::size() const {
+    return permutation_.size();
+}
+
+// Статические методы
+uint64_t SpatialOrder::mortonCode(uint32_t x, uint32_t y, uint32_t z) {
+    return (spreadBits(x) << 2) | (spreadBits(y) << 1) | spreadBits(z);
+}
+
+uint64_t SpatialOrder::hilbertCode(uint32_t x, uint32_t y, uint32_t z) {
+    // Преобразование Скиллинга: координаты -> "транспонированный" индекс
+    uint32_t X[3] = { x & CODE_MAX, y & CODE_MAX, z & CODE_MAX };
+    const uint32_t M = 1u << (CODE_BITS - 1);
+
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        const uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i) {
+            if (X[i] & Q) {
+                X[0] ^= P;
+            } else {
+                uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Код Грея
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        if (X[2] & Q) t ^= Q - 1;
+    }
+    for (int i = 0; i < 3; ++i) {
+        X[i] ^= t;
+    }
+
+    // Чередование битов: X[0] - старший
+    return mortonCode(X[0], X[1], X[2]);
+}
+
+SpatialOrder SpatialOrder::sortPoints(std::vector<Vector3D>& points, Curve curve, bool parallel) {
+    SpatialOrder order(points, curve, parallel);
+    order.apply(points);
+    return order;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file SpatialOrder.h
+ * @brief Упорядочивание облаков точек вдоль кривых Мортона и Гильберта
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef SPATIALORDER_H
+#define SPATIALORDER_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "Vector3D.h"
+
+/**
+ * @class SpatialOrder
+ * @brief Перестановка точек в порядке обхода пространственной кривой
+ *
+ * Каждая точка квантуется до 21 бита на ось внутри ограничивающего
+ * параллелепипеда набора и получает 63-битный код кривой Мортона
+ * (Z-порядок) или Гильберта. Коды сортируются устойчивой поразрядной
+ * сортировкой за линейное время; при параллельном режиме гистограммы
+ * считаются по блокам фиксированного размера, поэтому перестановка
+ * не зависит от количества потоков.
+ *
+ * После сортировки близкие в пространстве точки оказываются рядом
+ * в памяти. Перестановку можно применить к любому массиву атрибутов,
+ * связанному с точками, чтобы переупорядочить его согласованно.
+ */
+class SpatialOrder {
+public:
+    /**
+     * @brief Тип пространственной кривой
+     */
+    enum Curve {
+        MORTON,   ///< Кривая Мортона (Z-порядок), быстрое вычисление кода
+        HILBERT   ///< Кривая Гильберта, лучшая локальность
+    };
+
+private:
+    std::vector<size_t> permutation_;  ///< permutation_[i] - старый индекс i-й точки
+    Curve curve_;                      ///< Использованная кривая
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустую перестановку
+     */
+    SpatialOrder();
+
+    /**
+     * @brief Построить перестановку для облака точек
+     * @param points Точки
+     * @param curve Тип кривой
+     * @param parallel Использовать несколько потоков
+     */
+    explicit SpatialOrder(const std::vector<Vector3D>& points, Curve curve = MORTON,
+                          bool parallel = false);
+
+    // Методы доступа
+    /**
+     * @brief Получить перестановку
+     * @return Массив, где i-й элемент - исходный индекс точки на позиции i
+     */
+    const std::vector<size_t>& getPermutation() const;
+
+    /**
+     * @brief Получить обратную перестановку
+     * @return Массив, где i-й элемент - новая позиция исходной точки i
+     */
+    std::vector<size_t> inverse() const;
+
+    /**
+     * @brief Получить тип кривой
+     * @return Тип кривой
+     */
+    Curve getCurve() const;
+
+    /**
+     * @brief Количество точек
+     * @return Размер перестановки
+     */
+    size_t size() const;
+
+    // Применение перестановки
+    /**
+     * @brief Переупорядочить массив атрибутов на месте
+     * @param values Массив той же длины, что и набор точек
+     * @throw std::invalid_argument если длина массива не совпадает
+     */
+    template <typename T>
+    void apply(std::vector<T>& values) const {
+        std::vector<T> reordered = applied(values);
+        values.swap(reordered);
+    }
+
+    /**
+     * @brief Получить переупорядоченную копию массива атрибутов
+     * @param values Массив той же длины, что и набор точек
+     * @return Переупорядоченный массив
+     * @throw std::invalid_argument если длина массива не совпадает
+     */
+    template <typename T>
+    std::vector<T> applied(const std::vector<T>& values) const {
+        if (values.size() != permutation_.size()) {
+            throw std::invalid_argument("Размер массива не совпадает с размером перестановки");
+        }
+        std::vector<T> result;
+        result.reserve(values.size());
+        for (size_t i = 0; i < permutation_.size(); ++i) {
+            result.push_back(values[permutation_[i]]);
+        }
+        return result;
+    }
+
+    // Статические методы
+    /**
+     * @brief Код Мортона для квантованных координат
+     * @param x Координата X (используются младшие 21 бит)
+     * @param y Координата Y (используются младшие 21 бит)
+     * @param z Координата Z (используются младшие 21 бит)
+     * @return 63-битный код
+     */
+    static uint64_t mortonCode(uint32_t x, uint32_t y, uint32_t z);
+
+    /**
+     * @brief Код Гильберта для квантованных координат
+     * @param x Координата X (используются младшие 21 бит)
+     * @param y Координата Y (используются младшие 21 бит)
+     * @param z Координата Z (используются младшие 21 бит)
+     * @return 63-битный код
+     */
+    static uint64_t hilbertCode(uint32_t x, uint32_t y, uint32_t z);
+
+    /**
+     * @brief Упорядочить точки на месте
+     * @param points Точки
+     * @param curve Тип кривой
+     * @param parallel Использовать несколько потоков
+     * @return Перестановка для согласованного переупорядочивания атрибутов
+     */
+    static SpatialOrder sortPoints(std::vector<Vector3D>& points, Curve curve = MORTON,
+                                   bool parallel = false);
+};
+
+#endif // SPATIALORDER_H
@@ -0,0 +1,142 @@
+/**
+ * @file SymmetricMatrix.cpp
+ * @brief Реализация упакованной симметричной матрицы
+ */
+
+#include "SymmetricMatrix.h"
+#include "Gemm.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const size_t PACKED_COLUMN_BLOCK = 64;  ///< Столбцов правой части в задаче одного потока
+const size_t SYRK_ROW_BLOCK = 32;       ///< Строк результата в задаче одного потока
+
+} // namespace
+
+// Конструкторы
+SymmetricMatrix::SymmetricMatrix() : size_(0) {}
+
+SymmetricMatrix::SymmetricMatrix(size_t size) : size_(size), data_(rowOffset(size), 0.0) {}
+
+SymmetricMatrix::SymmetricMatrix(const Matrix& matrix) : size_(matrix.getRows()) {
+    if (!matrix.isSquare()) {
+        throw std::invalid_argument("Симметричная матрица должна быть квадратной");
+    }
+    data_.resize(rowOffset(size_));
+    for (size_t i = 0; i < size_; ++i) {
+        const std::vector<double>& row = matrix[i];
+        std::copy(row.begin(), row.begin() + i + 1, data_.begin() + rowOffset(i));
+    }
+}
+
+// Методы доступа
+double SymmetricMatrix::get(size_t row, size_t col) const {
+    if (row >= size_ || col >= size_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    return data_[index(row, col)];
+}
+
+void SymmetricMatrix::set(size_t row, size_t col, double value) {
+    if (row >= size_ || col >= size_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    data_[index(row, col)] = value;
+}
+
+Matrix SymmetricMatrix::toMatrix() const {
+    Matrix result(size_, size_);
+    for (size_t i = 0; i < size_; ++i) {
+        const double* packed = &data_[rowOffset(i)];
+        std::vector<double>& row = result[i];
+        for (size_t j = 0; j <= i; ++j) {
+            row[j] = packed[j];
+            result[j][i] = packed[j];
+        }
+    }
+    return result;
+}
+
+size_t SymmetricMatrix::memoryUsage() const {
+    return sizeof(*this) + data_.size() * sizeof(double);
+}
+
+// Умножение
+std::vector<double> SymmetricMatrix::multiply(const std::vector<double>& x) const {
+    if (x.size() != size_) {
+        throw std::invalid_argument("Длина вектора не совпадает с порядком матрицы");
+    }
+    std::vector<double> y(size_, 0.0);
+    for (size_t i = 0; i < size_; ++i) {
+        const double* row = &data_[rowOffset(i)];
+        const double xi = x[i];
+        double sum = 0.0;
+        for (size_t j = 0; j < i; ++j) {
+            sum += row[j] * x[j];
+            y[j] += row[j] * xi;
+        }
+        y[i] += sum + row[i] * xi;
+    }
+    return y;
+}
+
+Matrix SymmetricMatrix::multiply(const Matrix& b) const {
+    if (b.getRows() != size_) {
+        throw std::invalid_argument("Несовместимые размеры для умножения матриц");
+    }
+    const size_t p = b.getCols();
+    Matrix result(size_, p);
+    // Потоки делят столбцы: элемент (i, j) обновляет строки i и j результата
+    Parallel::forEachBlock(p, PACKED_COLUMN_BLOCK, [&](size_t, size_t begin, size_t end) {
+        const size_t width = end - begin;
+        for (size_t i = 0; i < size_; ++i) {
+            const double* row = &data_[rowOffset(i)];
+            const double* bi = &b[i][begin];
+            double* ci = &result[i][begin];
+            for (size_t j = 0; j < i; ++j) {
+                const double a = row[j];
+                const double* bj = &b[j][begin];
+                double* cj = &result[j][begin];
+                for (size_t c = 0; c < width; ++c) {
+                    ci[c] += a * bj[c];
+                    cj[c] += a * bi[c];
+                }
+            }
+            for (size_t c = 0; c < width; ++c) ci[c] += row[i] * bi[c];
+        }
+    });
+    return result;
+}
+
+SymmetricMatrix SymmetricMatrix::syrk(const Matrix& a) {
+    const size_t n = a.getRows();
+    const size_t k = a.getCols();
+    SymmetricMatrix result(n);
+    if (n == 0 || k == 0) return result;
+
+    std::vector<double> transposed(k * n);
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<double>& row = a[i];
+        for (size_t p = 0; p < k; ++p) transposed[p * n + i] = row[p];
+    }
+    // Блок строк [begin, end) умножается только на столбцы [0, end) из A^T:
+    // верхний треугольник вне диагональных блоков не вычисляется
+    Parallel::forEachBlock(n, SYRK_ROW_BLOCK, [&](size_t, size_t begin, size_t end) {
+        const size_t rows = end - begin;
+        std::vector<double> panel(rows * k);
+        for (size_t i = 0; i < rows; ++i) {
+            const std::vector<double>& row = a[begin + i];
+            std::copy(row.begin(), row.end(), panel.begin() + i * k);
+        }
+        std::vector<double> block(rows * end);
+        Gemm::multiply(rows, end, k, panel.data(), k, transposed.data(), n, block.data(), end, false, false);
+        for (size_t i = 0; i < rows; ++i) {
+            const double* source = &block[i * end];
+            std::copy(source, source + begin + i + 1, result.data_.begin() + rowOffset(begin + i));
+        }
+    });
+    return result;
+}
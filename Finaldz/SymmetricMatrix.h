@@ -0,0 +1,103 @@
+/**
+ * @file SymmetricMatrix.h
+ * @brief Симметричная матрица в упакованном виде
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef SYMMETRICMATRIX_H
+#define SYMMETRICMATRIX_H
+
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * @class SymmetricMatrix
+ * @brief Симметричная матрица, хранящая только нижний треугольник
+ *
+ * Строка i нижнего треугольника (столбцы 0..i) лежит в непрерывном
+ * массиве с позиции i * (i + 1) / 2, всего n * (n + 1) / 2 чисел вместо
+ * n^2. Элемент (i, j) выше диагонали берется из (j, i).
+ *
+ * Умножение проходит упакованный треугольник один раз, используя каждый
+ * недиагональный элемент дважды. syrk() вычисляет A * A^T, считая только
+ * нижний треугольник результата, - вдвое меньше операций, чем A * A.transpose().
+ */
+class SymmetricMatrix {
+private:
+    size_t size_;               ///< Порядок матрицы
+    std::vector<double> data_;  ///< Нижний треугольник по строкам
+
+    static size_t rowOffset(size_t row) { return row * (row + 1) / 2; }
+    size_t index(size_t row, size_t col) const {
+        return row >= col ? rowOffset(row) + col : rowOffset(col) + row;
+    }
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустую матрицу
+     */
+    SymmetricMatrix();
+
+    /**
+     * @brief Конструктор нулевой матрицы
+     * @param size Порядок матрицы
+     */
+    explicit SymmetricMatrix(size_t size);
+
+    /**
+     * @brief Упаковать матрицу
+     * @param matrix Квадратная матрица; используется ее нижний треугольник
+     * @throw std::invalid_argument если матрица не квадратная
+     */
+    explicit SymmetricMatrix(const Matrix& matrix);
+
+    // Методы доступа
+    size_t size() const { return size_; }
+    const std::vector<double>& data() const { return data_; }
+
+    /**
+     * @brief Получить элемент
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t row, size_t col) const;
+
+    /**
+     * @brief Установить элементы (row, col) и (col, row)
+     * @throw std::out_of_range если индексы вне границ
+     */
+    void set(size_t row, size_t col, double value);
+
+    /**
+     * @brief Развернуть в обычную матрицу
+     */
+    Matrix toMatrix() const;
+
+    /**
+     * @brief Объем занимаемой памяти в байтах
+     */
+    size_t memoryUsage() const;
+
+    // Умножение
+    /**
+     * @brief Произведение A * x
+     * @throw std::invalid_argument если длина x не совпадает с порядком
+     */
+    std::vector<double> multiply(const std::vector<double>& x) const;
+
+    /**
+     * @brief Произведение A * B
+     * @throw std::invalid_argument если число строк B не совпадает с порядком
+     */
+    Matrix multiply(const Matrix& b) const;
+
+    /**
+     * @brief Симметричное произведение A * A^T
+     * @param a Матрица A (n x k)
+     * @return Упакованная матрица n x n
+     */
+    static SymmetricMatrix syrk(const Matrix& a);
+};
+
+#endif // SYMMETRICMATRIX_H
@@ -0,0 +1,707 @@
+/**
+ * @file TextIO.cpp
+ * @brief Реализация быстрого разбора и форматирования текста
+ */
+
+#include "TextIO.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <clocale>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+const unsigned long long MAX_EXACT_MANTISSA = 1ULL << 53;  ///< Целые до 2^53 точно представимы в double
+const int MAX_EXACT_POW10 = 22;                           ///< 10^22 - наибольшая точная степень десяти
+const int MAX_MANTISSA_DIGITS = 19;                       ///< Столько цифр гарантированно помещается в 64 бита
+
+const double POW10[MAX_EXACT_POW10 + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline char toLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+const char* skipSpaces(const char* p, const char* end) {
+    while (p != end && isSpace(*p)) ++p;
+    return p;
+}
+
+/**
+ * @brief Пропустить пробелы и табуляции, не переходя на новую строку
+ */
+const char* skipBlanks(const char* p, const char* end) {
+    while (p != end && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+/**
+ * @brief Проверить слово без учета регистра
+ */
+bool matchWord(const char* p, const char* end, const char* word) {
+    for (; *word; ++word, ++p) {
+        if (p == end || toLower(*p) != *word) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Разобрать число через strtod, подставив десятичный разделитель локали
+ */
+double parseSlow(const char* begin, const char* end) {
+    char local[64];
+    std::string heap;
+    const size_t length = static_cast<size_t>(end - begin);
+    char* buffer = local;
+    if (length >= sizeof(local)) {
+        heap.resize(length + 1);
+        buffer = &heap[0];
+    }
+    const char point = *std::localeconv()->decimal_point;
+    for (size_t i = 0; i < length; ++i) {
+        buffer[i] = begin[i] == '.' ? point : begin[i];
+    }
+    buffer[length] = '\0';
+    return std::strtod(buffer, nullptr);
+}
+
+/**
+ * @brief Разобрать целое со знаком
+ * @return Указатель за числом или nullptr при ошибке или переполнении
+ */
+const char* parseInteger(const char* p, const char* end, long long& value) {
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        ++p;
+    }
+    if (p == end || !isDigit(*p)) return nullptr;
+    const unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+    unsigned long long magnitude = 0;
+    for (; p != end && isDigit(*p); ++p) {
+        const unsigned digit = static_cast<unsigned>(*p - '0');
+        if (magnitude > (limit - digit) / 10) return nullptr;
+        magnitude = magnitude * 10 + digit;
+    }
+    value = negative ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+    return p;
+}
+
+/**
+ * @brief Записать целое без знака, возвращает указатель за последней цифрой
+ */
+char* formatUnsigned(char* out, unsigned long long value) {
+    char digits[24];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (count > 0) *out++ = digits[--count];
+    return out;
+}
+
+char* formatInteger(char* out, long long value) {
+    if (value < 0) {
+        *out++ = '-';
+        return formatUnsigned(out, 0ULL - static_cast<unsigned long long>(value));
+    }
+    return formatUnsigned(out, static_cast<unsigned long long>(value));
+}
+
+char* formatFraction(char* out, const Fraction& value) {
+    out = formatInteger(out, value.getNumerator());
+    if (value.getDenominator() != 1) {
+        *out++ = '/';
+        out = formatUnsigned(out, static_cast<unsigned long long>(value.getDenominator()));
+    }
+    return out;
+}
+
+char* formatComplex(char* out, const Complex& value) {
+    out = TextIO::format(out, value.getReal());
+    const double imag = value.getImag();
+    if (std::signbit(imag) && !std::isnan(imag)) {
+        std::memcpy(out, " - ", 3);
+        out = TextIO::format(out + 3, -imag);
+    } else {
+        std::memcpy(out, " + ", 3);
+        out = TextIO::format(out + 3, imag);
+    }
+    *out++ = 'i';
+    return out;
+}
+
+char* formatVector(char* out, const Vector3D& value) {
+    *out++ = '(';
+    out = TextIO::format(out, value.getX());
+    *out++ = ',';
+    *out++ = ' ';
+    out = TextIO::format(out, value.getY());
+    *out++ = ',';
+    *out++ = ' ';
+    out = TextIO::format(out, value.getZ());
+    *out++ = ')';
+    return out;
+}
+
+const size_t FORMAT_BUFFER = 128;  ///< Хватает на любое форматируемое значение
+const int SIGNIFICANT_DIGITS = 17;  ///< Значащих цифр достаточно для точной записи любого double
+const int FAST_DIGITS = 15;         ///< Цифр в быстром пути форматирования (10^15 < 2^53)
+const int FAST_MIN_EXPONENT = 8;    ///< Быстрый путь для чисел не меньше 10^-8
+
+/**
+ * @brief Округлить запись d.ddd * 10^exponent до precision цифр
+ * @param up true - в большую сторону по модулю, false - отбросить лишние цифры
+ */
+void roundDigits(const char* digits, int precision, bool up, char* rounded, int exponent, int& roundedExponent) {
+    std::memcpy(rounded, digits, precision);
+    roundedExponent = exponent;
+    if (!up) return;
+    int i = precision - 1;
+    while (i >= 0 && rounded[i] == '9') rounded[i--] = '0';
+    if (i >= 0) {
+        ++rounded[i];
+    } else {
+        // 99...9 -> 100...0
+        rounded[0] = '1';
+        ++roundedExponent;
+    }
+}
+
+/**
+ * @brief Значение записи d.ddd * 10^exponent из count цифр
+ */
+double digitsToDouble(const char* digits, int count, int exponent) {
+    unsigned long long mantissa = 0;
+    for (int i = 0; i < count; ++i) mantissa = mantissa * 10 + static_cast<unsigned>(digits[i] - '0');
+    const int scale = exponent - (count - 1);
+    if (mantissa <= MAX_EXACT_MANTISSA && scale >= -MAX_EXACT_POW10 && scale <= MAX_EXACT_POW10) {
+        const double m = static_cast<double>(mantissa);
+        return scale < 0 ? m / POW10[-scale] : m * POW10[scale];
+    }
+    char text[48];
+    char* last = text;
+    std::memcpy(last, digits, count);
+    last += count;
+    *last++ = 'e';
+    last = formatInteger(last, scale);
+    return parseSlow(text, last);
+}
+
+/**
+ * @brief Записать цифры в стиле %g: обычная запись при -4 <= exponent < 17,
+ *        иначе экспоненциальная
+ */
+char* writeDigits(char* out, const char* digits, int count, int exponent) {
+    if (exponent >= -4 && exponent < SIGNIFICANT_DIGITS) {
+        if (exponent < 0) {
+            *out++ = '0';
+            *out++ = '.';
+            for (int i = -1; i > exponent; --i) *out++ = '0';
+            std::memcpy(out, digits, count);
+            return out + count;
+        }
+        const int whole = exponent + 1;
+        for (int i = 0; i < whole; ++i) *out++ = i < count ? digits[i] : '0';
+        if (count > whole) {
+            *out++ = '.';
+            std::memcpy(out, digits + whole, count - whole);
+            out += count - whole;
+        }
+        return out;
+    }
+    *out++ = digits[0];
+    if (count > 1) {
+        *out++ = '.';
+        std::memcpy(out, digits + 1, count - 1);
+        out += count - 1;
+    }
+    *out++ = 'e';
+    *out++ = exponent < 0 ? '-' : '+';
+    const unsigned magnitude = static_cast<unsigned>(exponent < 0 ? -exponent : exponent);
+    if (magnitude < 10) *out++ = '0';
+    return formatUnsigned(out, magnitude);
+}
+
+/**
+ * @brief Разобрать строку целиком: значение и только пробелы вокруг
+ */
+template <typename T>
+bool parseWhole(const std::string& text, T& value) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    T parsed;
+    const char* p = TextIO::parse(begin, end, parsed);
+    if (p == nullptr || skipSpaces(p, end) != end) return false;
+    value = parsed;
+    return true;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть файл: " + path);
+    }
+    file.seekg(0, std::ios::end);
+    const std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::string text(size > 0 ? static_cast<size_t>(size) : 0, '\0');
+    if (size > 0 && !file.read(&text[0], size)) {
+        throw std::runtime_error("Ошибка чтения файла: " + path);
+    }
+    // Метка порядка байтов UTF-8 не относится к данным
+    if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        text.erase(0, 3);
+    }
+    return text;
+}
+
+void writeFile(const std::string& path, const std::string& text) {
+    std::ofstream file(path.c_str(), std::ios::binary);
+    if (!file || !file.write(text.data(), static_cast<std::streamsize>(text.size()))) {
+        throw std::runtime_error("Не удалось записать файл: " + path);
+    }
+}
+
+void parseError(const std::string& what, const char* begin, const char* position, const std::string& path) {
+    size_t line = 1;
+    for (const char* p = begin; p != position; ++p) {
+        if (*p == '\n') ++line;
+    }
+    char number[24];
+    *formatUnsigned(number, line) = '\0';
+    throw std::runtime_error("Ошибка разбора " + what + " в строке " + number + " файла " + path);
+}
+
+inline bool isSeparator(char c) {
+    return isSpace(c) || c == ',' || c == ';';
+}
+
+/**
+ * @brief Прочитать все значения файла, разделенные пробелами, запятыми или точками с запятой
+ */
+template <typename T>
+std::vector<T> readAll(const std::string& path, const std::string& what) {
+    const std::string text = readFile(path);
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    std::vector<T> values;
+    const char* p = begin;
+    while (true) {
+        while (p != end && isSeparator(*p)) ++p;
+        if (p == end) break;
+        T value;
+        const char* next = TextIO::parse(p, end, value);
+        if (next == nullptr || (next != end && !isSeparator(*next))) {
+            parseError(what, begin, p, path);
+        }
+        values.push_back(value);
+        p = next;
+    }
+    return values;
+}
+
+template <typename T, typename Format>
+void writeAll(const std::string& path, const std::vector<T>& values, Format format) {
+    std::string text;
+    text.reserve(values.size() * 24);
+    char buffer[FORMAT_BUFFER];
+    for (size_t i = 0; i < values.size(); ++i) {
+        char* last = format(buffer, values[i]);
+        *last++ = '\n';
+        text.append(buffer, last);
+    }
+    writeFile(path, text);
+}
+
+} // namespace
+
+// Разбор
+const char* TextIO::parse(const char* begin, const char* end, double& value) {
+    const char* p = skipSpaces(begin, end);
+    const char* start = p;
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    if (p != end && !isDigit(*p) && *p != '.') {
+        if (matchWord(p, end, "inf")) {
+            p += matchWord(p, end, "infinity") ? 8 : 3;
+            value = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+            return p;
+        }
+        if (matchWord(p, end, "nan")) {
+            value = negative ? -std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::quiet_NaN();
+            return p + 3;
+        }
+        return nullptr;
+    }
+
+    // Мантисса: до 19 значащих цифр, остальные только сдвигают порядок
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool any = false;
+    for (; p != end && isDigit(*p); ++p) {
+        any = true;
+        if (digits < MAX_MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+            if (mantissa != 0) ++digits;
+        } else {
+            ++exponent;
+            truncated |= *p != '0';
+        }
+    }
+    if (p != end && *p == '.') {
+        ++p;
+        for (; p != end && isDigit(*p); ++p) {
+            any = true;
+            if (digits < MAX_MANTISSA_DIGITS) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+                if (mantissa != 0) ++digits;
+                --exponent;
+            } else {
+                truncated |= *p != '0';
+            }
+        }
+    }
+    if (!any) return nullptr;
+
+    // Порядок разбирается, только если за 'e' следуют цифры
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool negativeExp = false;
+        if (q != end && (*q == '+' || *q == '-')) {
+            negativeExp = *q == '-';
+            ++q;
+        }
+        if (q != end && isDigit(*q)) {
+            int e = 0;
+            for (; q != end && isDigit(*q); ++q) {
+                if (e < 100000) e = e * 10 + (*q - '0');
+            }
+            exponent += negativeExp ? -e : e;
+            p = q;
+        }
+    }
+
+    if (!truncated && mantissa <= MAX_EXACT_MANTISSA &&
+        exponent >= -MAX_EXACT_POW10 && exponent <= MAX_EXACT_POW10) {
+        // Оба операнда точны, значит одно умножение или деление дает
+        // правильно округленный результат (алгоритм Клингера)
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / POW10[-exponent] : result * POW10[exponent];
+        value = negative ? -result : result;
+        return p;
+    }
+    if (mantissa == 0 && !truncated) {
+        value = negative ? -0.0 : 0.0;
+        return p;
+    }
+    value = parseSlow(start, p);
+    return p;
+}
+
+const char* TextIO::parse(const char* begin, const char* end, Fraction& value) {
+    const char* p = skipSpaces(begin, end);
+    long long numerator = 0;
+    p = parseInteger(p, end, numerator);
+    if (p == nullptr) return nullptr;
+
+    long long denominator = 1;
+    const char* q = skipBlanks(p, end);
+    if (q != end && *q == '/') {
+        q = skipBlanks(q + 1, end);
+        if (q == end || !isDigit(*q)) return nullptr;
+        q = parseInteger(q, end, denominator);
+        if (q == nullptr || denominator == 0) return nullptr;
+        p = q;
+    }
+    value = Fraction(numerator, denominator);
+    return p;
+}
+
+const char* TextIO::parse(const char* begin, const char* end, Complex& value) {
+    const char* p = skipSpaces(begin, end);
+    double first = 0.0;
+    const char* q = parse(p, end, first);
+    if (q == nullptr) {
+        // Мнимая единица без коэффициента: "i", "-i"
+        const char* r = p;
+        double sign = 1.0;
+        if (r != end && (*r == '+' || *r == '-')) {
+            sign = *r == '-' ? -1.0 : 1.0;
+            ++r;
+        }
+        if (r == end || *r != 'i') return nullptr;
+        value = Complex(0.0, sign);
+        return r + 1;
+    }
+    if (q != end && *q == 'i') {
+        value = Complex(0.0, first);
+        return q + 1;
+    }
+
+    // Необязательная мнимая часть; если ее нет, число действительное
+    const char* r = skipBlanks(q, end);
+    if (r != end && (*r == '+' || *r == '-')) {
+        const double sign = *r == '-' ? -1.0 : 1.0;
+        r = skipBlanks(r + 1, end);
+        double second = 1.0;
+        if (r != end && *r != 'i') {
+            if (*r == '+' || *r == '-') r = nullptr;
+            else r = parse(r, end, second);
+        }
+        if (r != nullptr && r != end && *r == 'i') {
+            value = Complex(first, sign * second);
+            return r + 1;
+        }
+    }
+    value = Complex(first, 0.0);
+    return q;
+}
+
+const char* TextIO::parse(const char* begin, const char* end, Vector3D& value) {
+    const char* p = skipSpaces(begin, end);
+    const bool bracketed = p != end && *p == '(';
+    if (bracketed) ++p;
+
+    double coordinates[3];
+    for (int i = 0; i < 3; ++i) {
+        if (i > 0) {
+            p = skipSpaces(p, end);
+            if (p != end && *p == ',') ++p;
+        }
+        p = parse(p, end, coordinates[i]);
+        if (p == nullptr) return nullptr;
+    }
+    if (bracketed) {
+        p = skipSpaces(p, end);
+        if (p == end || *p != ')') return nullptr;
+        ++p;
+    }
+    value = Vector3D(coordinates[0], coordinates[1], coordinates[2]);
+    return p;
+}
+
+bool TextIO::parse(const std::string& text, double& value) {
+    return parseWhole(text, value);
+}
+
+bool TextIO::parse(const std::string& text, Fraction& value) {
+    return parseWhole(text, value);
+}
+
+bool TextIO::parse(const std::string& text, Complex& value) {
+    return parseWhole(text, value);
+}
+
+bool TextIO::parse(const std::string& text, Vector3D& value) {
+    return parseWhole(text, value);
+}
+
+// Форматирование
+char* TextIO::format(char* out, double value) {
+    if (std::isnan(value)) {
+        std::memcpy(out, "nan", 3);
+        return out + 3;
+    }
+    if (std::isinf(value)) {
+        if (value < 0) *out++ = '-';
+        std::memcpy(out, "inf", 3);
+        return out + 3;
+    }
+
+    if (value == 0.0) {
+        if (std::signbit(value)) *out++ = '-';
+        *out++ = '0';
+        return out;
+    }
+    if (value < 0) {
+        *out++ = '-';
+        value = -value;
+    }
+
+    // Быстрый путь: если value точно восстанавливается из 15 цифр, они
+    // получаются одним округлением value * 10^scale до целого
+    int exponent10 = 0;
+    if (value >= 1.0) {
+        while (exponent10 < MAX_EXACT_POW10 && POW10[exponent10 + 1] <= value) ++exponent10;
+    } else {
+        while (exponent10 > -FAST_MIN_EXPONENT && value * POW10[-exponent10] < 1.0) --exponent10;
+    }
+    const int scale = FAST_DIGITS - 1 - exponent10;
+    if (exponent10 < MAX_EXACT_POW10 && scale >= -MAX_EXACT_POW10 && scale <= MAX_EXACT_POW10) {
+        const double scaled = scale < 0 ? value / POW10[-scale] : value * POW10[scale];
+        const unsigned long long mantissa = static_cast<unsigned long long>(scaled + 0.5);
+        if (mantissa < 1000000000000000ULL) {
+            const double m = static_cast<double>(mantissa);
+            if ((scale < 0 ? m * POW10[-scale] : m / POW10[scale]) == value) {
+                char digits[24];
+                const int count = static_cast<int>(formatUnsigned(digits, mantissa) - digits);
+                int used = count;
+                while (used > 1 && digits[used - 1] == '0') --used;
+                return writeDigits(out, digits, used, count - 1 - scale);
+            }
+        }
+    }
+
+    // Одна запись с 17 значащими цифрами (их достаточно для любого double),
+    // затем проверяются ее округления до 15 и 16 цифр: выбирается кратчайшая,
+    // которая читается обратно точно
+    char scientific[32];
+    std::snprintf(scientific, sizeof(scientific), "%.16e", value);
+    char digits[SIGNIFICANT_DIGITS];
+    digits[0] = scientific[0];
+    const char* p = scientific + 1;
+    while (!isDigit(*p)) ++p;  // десятичный разделитель локали
+    for (int i = 1; i < SIGNIFICANT_DIGITS; ++i) digits[i] = *p++;
+    exponent10 = std::atoi(p + 1);
+
+    int count = SIGNIFICANT_DIGITS;
+    for (int precision = 15; precision < SIGNIFICANT_DIGITS && count == SIGNIFICANT_DIGITS; ++precision) {
+        // Сначала ближайшее округление, затем соседнее: 17 цифр сами
+        // округлены, поэтому ближайшее к ним не всегда ближайшее к value
+        const bool nearestUp = digits[precision] >= '5';
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            char rounded[SIGNIFICANT_DIGITS];
+            int roundedExponent = 0;
+            roundDigits(digits, precision, nearestUp != (attempt == 1), rounded, exponent10, roundedExponent);
+            if (digitsToDouble(rounded, precision, roundedExponent) == value) {
+                std::memcpy(digits, rounded, precision);
+                exponent10 = roundedExponent;
+                count = precision;
+                break;
+            }
+        }
+    }
+    while (count > 1 && digits[count - 1] == '0') --count;
+    return writeDigits(out, digits, count, exponent10);
+}
+
+std::string TextIO::toString(double value) {
+    char buffer[FORMAT_BUFFER];
+    return std::string(buffer, format(buffer, value));
+}
+
+std::string TextIO::toString(const Fraction& value) {
+    char buffer[FORMAT_BUFFER];
+    return std::string(buffer, formatFraction(buffer, value));
+}
+
+std::string TextIO::toString(const Complex& value) {
+    char buffer[FORMAT_BUFFER];
+    return std::string(buffer, formatComplex(buffer, value));
+}
+
+std::string TextIO::toString(const Vector3D& value) {
+    char buffer[FORMAT_BUFFER];
+    return std::string(buffer, formatVector(buffer, value));
+}
+
+std::string TextIO::toString(const Matrix& value) {
+    std::string text;
+    text.reserve(value.getRows() * value.getCols() * 24);
+    char buffer[FORMAT_BUFFER];
+    for (size_t i = 0; i < value.getRows(); ++i) {
+        if (i > 0) text += '\n';
+        const std::vector<double>& row = value[i];
+        for (size_t j = 0; j < row.size(); ++j) {
+            char* last = buffer;
+            if (j > 0) *last++ = ' ';
+            last = format(last, row[j]);
+            text.append(buffer, last);
+        }
+    }
+    return text;
+}
+
+// Файлы
+std::vector<double> TextIO::readDoubles(const std::string& path) {
+    return readAll<double>(path, "числа");
+}
+
+std::vector<Fraction> TextIO::readFractions(const std::string& path) {
+    return readAll<Fraction>(path, "дроби");
+}
+
+std::vector<Complex> TextIO::readComplexes(const std::string& path) {
+    return readAll<Complex>(path, "комплексного числа");
+}
+
+std::vector<Vector3D> TextIO::readVectors(const std::string& path) {
+    return readAll<Vector3D>(path, "вектора");
+}
+
+Matrix TextIO::readMatrix(const std::string& path) {
+    const std::string text = readFile(path);
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+
+    std::vector<std::vector<double> > rows;
+    const char* p = begin;
+    while (p != end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (lineEnd == nullptr) lineEnd = end;
+
+        std::vector<double> row;
+        const char* q = p;
+        while (true) {
+            while (q != lineEnd && (isSpace(*q) || *q == ',' || *q == '[' || *q == ']' || *q == ';')) ++q;
+            if (q == lineEnd) break;
+            double value = 0.0;
+            const char* next = parse(q, lineEnd, value);
+            if (next == nullptr) parseError("элемента матрицы", begin, q, path);
+            row.push_back(value);
+            q = next;
+        }
+        if (!row.empty()) {
+            if (!rows.empty() && row.size() != rows[0].size()) {
+                parseError("матрицы: строки разной длины,", begin, p, path);
+            }
+            rows.push_back(row);
+        }
+        p = lineEnd == end ? end : lineEnd + 1;
+    }
+    return rows.empty() ? Matrix() : Matrix(rows);
+}
+
+void TextIO::write(const std::string& path, const std::vector<double>& values) {
+    writeAll(path, values, [](char* out, double value) { return format(out, value); });
+}
+
+void TextIO::write(const std::string& path, const std::vector<Fraction>& values) {
+    writeAll(path, values, formatFraction);
+}
+
+void TextIO::write(const std::string& path, const std::vector<Complex>& values) {
+    writeAll(path, values, formatComplex);
+}
+
+void TextIO::write(const std::string& path, const std::vector<Vector3D>& values) {
+    writeAll(path, values, formatVector);
+}
+
+void TextIO::write(const std::string& path, const Matrix& matrix) {
+    std::string text = toString(matrix);
+    if (!text.empty()) text += '\n';
+    writeFile(path, text);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file TextIO.h
+ * @brief Быстрый неинтерактивный разбор и форматирование текста
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef TEXTIO_H
+#define TEXTIO_H
+
+#include <string>
+#include <vector>
+#include "Fraction.h"
+#include "Complex.h"
+#include "Vector3D.h"
+#include "Matrix.h"
+
+/**
+ * @class TextIO
+ * @brief Разбор и форматирование чисел, дробей, комплексных чисел, векторов и матриц
+ *
+ * В отличие от операторов ввода, методы не выводят подсказок и не зависят
+ * от локали: разделителем дробной части всегда является точка. Разбор
+ * работает с диапазоном символов [begin, end) в стиле std::from_chars:
+ * возвращает указатель за разобранным значением или nullptr при ошибке.
+ * Пробельные символы перед значением пропускаются.
+ *
+ * Вещественные числа разбираются собственным разборщиком: до 2^53
+ * значащих единиц мантиссы и порядка до 22 значение вычисляется одним
+ * точным умножением или делением; остальные случаи передаются strtod.
+ * Форматирование выдает кратчайшее из представлений с 15, 16 или 17
+ * значащими цифрами, которое читается обратно без потери точности.
+ *
+ * Текстовые форматы:
+ * - дробь: "3/4", "-5" (знаменатель можно опустить);
+ * - комплексное число: "1.5+2i", "1.5 - 2i", "3", "-2i";
+ * - вектор: "(1, 2, 3)" или "1 2 3";
+ * - матрица: по строке текста на строку матрицы, элементы через пробел
+ *   или запятую, необязательные скобки [ ] вокруг строки.
+ */
+class TextIO {
+public:
+    // Разбор
+    /**
+     * @brief Разобрать вещественное число
+     * @param begin Начало текста
+     * @param end Конец текста
+     * @param value Результат
+     * @return Указатель за числом или nullptr при ошибке
+     */
+    static const char* parse(const char* begin, const char* end, double& value);
+    static const char* parse(const char* begin, const char* end, Fraction& value);
+    static const char* parse(const char* begin, const char* end, Complex& value);
+    static const char* parse(const char* begin, const char* end, Vector3D& value);
+
+    /**
+     * @brief Разобрать строку целиком
+     * @param text Текст (допускаются пробелы по краям)
+     * @param value Результат
+     * @return true если текст содержит ровно одно значение
+     */
+    static bool parse(const std::string& text, double& value);
+    static bool parse(const std::string& text, Fraction& value);
+    static bool parse(const std::string& text, Complex& value);
+    static bool parse(const std::string& text, Vector3D& value);
+
+    // Форматирование
+    /**
+     * @brief Записать вещественное число в буфер
+     * @param out Буфер не менее 32 символов
+     * @param value Число
+     * @return Указатель за последним записанным символом
+     */
+    static char* format(char* out, double value);
+
+    static std::string toString(double value);
+    static std::string toString(const Fraction& value);
+    static std::string toString(const Complex& value);
+    static std::string toString(const Vector3D& value);
+    static std::string toString(const Matrix& value);
+
+    // Файлы
+    /**
+     * @brief Прочитать все значения из файла
+     * @param path Путь к файлу
+     * @return Значения в порядке следования (разделители - пробельные символы)
+     * @throw std::runtime_error если файл не открывается или содержит ошибку
+     *        (в сообщении указывается номер строки)
+     */
+    static std::vector<double> readDoubles(const std::string& path);
+    static std::vector<Fraction> readFractions(const std::string& path);
+    static std::vector<Complex> readComplexes(const std::string& path);
+    static std::vector<Vector3D> readVectors(const std::string& path);
+
+    /**
+     * @brief Прочитать матрицу из файла
+     * @param path Путь к файлу
+     * @return Матрица (пустые строки файла пропускаются)
+     * @throw std::runtime_error если файл не открывается, содержит ошибку
+     *        или строки разной длины
+     */
+    static Matrix readMatrix(const std::string& path);
+
+    /**
+     * @brief Записать значения в файл, по одному в строке
+     * @param path Путь к файлу
+     * @param values Значения
+     * @throw std::runtime_error если файл не удается записать
+     */
+    static void write(const std::string& path, const std::vector<double>& values);
+    static void write(const std::string& path, const std::vector<Fraction>& values);
+    static void write(const std::string& path, const std::vector<Complex>& values);
+    static void write(const std::string& path, const std::vector<Vector3D>& values);
+    static void write(const std::string& path, const Matrix& matrix);
+};
+
+#endif // TEXTIO_H
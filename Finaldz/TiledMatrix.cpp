@@ -0,0 +1,450 @@
+/**
+ * @file TiledMatrix.cpp
+ * @brief Реализация матрицы во внешней памяти
+ */
+
+#include "TiledMatrix.h"
+#include "Gemm.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+const size_t TiledMatrix::DEFAULT_TILE_SIZE;
+
+/**
+ * @brief Открытый файл матрицы; доступ к потоку защищен мьютексом,
+ *        так как плитки читаются и из фонового потока предвыборки
+ */
+struct TiledMatrix::Storage {
+    std::string path;
+    size_t rows;
+    size_t cols;
+    size_t tileSize;
+    size_t tileRows;
+    size_t tileCols;
+    std::fstream file;
+    std::mutex mutex;
+
+    uint64_t tileBytes() const {
+        return static_cast<uint64_t>(tileSize) * tileSize * sizeof(double);
+    }
+
+    uint64_t tileOffset(size_t tileRow, size_t tileCol) const;
+    void read(uint64_t offset, void* data, size_t bytes);
+    void write(uint64_t offset, const void* data, size_t bytes);
+};
+
+namespace {
+
+const char MAGIC[8] = { 'F', 'D', 'Z', 'T', 'I', 'L', 'E', 'S' };
+const uint32_t VERSION = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+const uint64_t HEADER_SIZE = 64;  ///< Плитки начинаются с выровненного смещения
+
+/**
+ * @brief Заголовок файла, 64 байта
+ */
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t tileSize;
+    uint64_t reserved[3];
+};
+
+static_assert(sizeof(Header) == HEADER_SIZE, "Заголовок должен занимать 64 байта");
+
+size_t ceilDiv(size_t a, size_t b) {
+    return (a + b - 1) / b;
+}
+
+/**
+ * @brief Последовательное чтение плиток в заданном порядке
+ *
+ * При включенной предвыборке следующая плитка читается в фоновом потоке
+ * во второй буфер, пока вызывающий обрабатывает текущую.
+ */
+class TileStream {
+private:
+    TiledMatrix source_;
+    std::vector<std::pair<size_t, size_t> > order_;
+    bool prefetch_;
+    size_t position_;
+    std::vector<double> buffers_[2];
+    std::future<void> pending_;  ///< Объявлен последним: при разрушении сначала дожидается чтения
+
+    void load(size_t index, size_t slot) {
+        source_.readTile(order_[index].first, order_[index].second, &buffers_[slot][0]);
+    }
+
+public:
+    TileStream(const TiledMatrix& source, const std::vector<std::pair<size_t, size_t> >& order, bool prefetch)
+        : source_(source), order_(order), prefetch_(prefetch), position_(0) {
+        const size_t tileElements = source.getTileSize() * source.getTileSize();
+        buffers_[0].resize(tileElements);
+        if (prefetch_) buffers_[1].resize(tileElements);
+    }
+
+    /**
+     * @brief Следующая плитка; буфер действителен до следующего вызова
+     */
+    const double* next() {
+        const size_t slot = prefetch_ ? position_ % 2 : 0;
+        if (pending_.valid()) {
+            pending_.get();
+        } else {
+            load(position_, slot);
+        }
+        if (prefetch_ && position_ + 1 < order_.size()) {
+            const size_t index = position_ + 1;
+            const size_t other = 1 - slot;
+            pending_ = std::async(std::launch::async, [this, index, other]() { load(index, other); });
+        }
+        ++position_;
+        return &buffers_[slot][0];
+    }
+};
+
+/**
+ * @brief Проверить, что лимит памяти вмещает нужное число плиток
+ * @return Сколько плиток вмещает лимит
+ */
+size_t tileBudget(const OutOfCoreOptions& options, uint64_t tileBytes, size_t minimum) {
+    const size_t budget = static_cast<size_t>(options.memoryLimit / tileBytes);
+    if (budget < minimum) {
+        throw std::invalid_argument("Лимит памяти меньше необходимого числа плиток");
+    }
+    return budget;
+}
+
+void checkResultPath(const TiledMatrix& operand, const std::string& resultPath) {
+    if (operand.getPath() == resultPath) {
+        throw std::invalid_argument("Файл результата совпадает с файлом операнда");
+    }
+}
+
+} // namespace
+
+// Storage
+uint64_t TiledMatrix::Storage::tileOffset(size_t tileRow, size_t tileCol) const {
+    return HEADER_SIZE + (static_cast<uint64_t>(tileRow) * tileCols + tileCol) * tileBytes();
+}
+
+void TiledMatrix::Storage::read(uint64_t offset, void* data, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    if (!file.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes))) {
+        file.clear();
+        throw std::runtime_error("Ошибка чтения файла: " + path);
+    }
+}
+
+void TiledMatrix::Storage::write(uint64_t offset, const void* data, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    file.seekp(static_cast<std::streamoff>(offset), std::ios::beg);
+    if (!file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes))) {
+        file.clear();
+        throw std::runtime_error("Ошибка записи файла: " + path);
+    }
+}
+
+// Конструкторы
+TiledMatrix::TiledMatrix(const std::shared_ptr<Storage>& storage) : storage_(storage) {}
+
+TiledMatrix TiledMatrix::create(const std::string& path, size_t rows, size_t cols, size_t tileSize) {
+    if (tileSize == 0) {
+        throw std::invalid_argument("Размер плитки должен быть положительным");
+    }
+    std::shared_ptr<Storage> storage(new Storage());
+    storage->path = path;
+    storage->rows = rows;
+    storage->cols = cols;
+    storage->tileSize = tileSize;
+    storage->tileRows = ceilDiv(rows, tileSize);
+    storage->tileCols = ceilDiv(cols, tileSize);
+    storage->file.open(path.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!storage->file) {
+        throw std::runtime_error("Не удалось создать файл: " + path);
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.rows = rows;
+    header.cols = cols;
+    header.tileSize = tileSize;
+    storage->write(0, &header, sizeof(header));
+
+    // Файл сразу получает полный размер; незаписанные плитки читаются как нули
+    const uint64_t size = storage->tileOffset(storage->tileRows, 0);
+    if (size > HEADER_SIZE) {
+        const char zero = 0;
+        storage->write(size - 1, &zero, 1);
+    }
+    return TiledMatrix(storage);
+}
+
+TiledMatrix TiledMatrix::open(const std::string& path) {
+    std::shared_ptr<Storage> storage(new Storage());
+    storage->path = path;
+    storage->file.open(path.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    if (!storage->file) {
+        throw std::runtime_error("Не удалось открыть файл: " + path);
+    }
+    storage->file.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(storage->file.tellg());
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    if (fileSize < HEADER_SIZE) {
+        throw std::runtime_error("Файл не содержит матрицу из плиток: " + path);
+    }
+    storage->read(0, &header, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.tileSize == 0) {
+        throw std::runtime_error("Файл не содержит матрицу из плиток: " + path);
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        throw std::runtime_error("Файл матрицы записан с другим порядком байтов: " + path);
+    }
+    if (header.version == 0 || header.version > VERSION) {
+        throw std::runtime_error("Неподдерживаемая версия формата матрицы: " + path);
+    }
+    storage->rows = static_cast<size_t>(header.rows);
+    storage->cols = static_cast<size_t>(header.cols);
+    storage->tileSize = static_cast<size_t>(header.tileSize);
+    storage->tileRows = ceilDiv(storage->rows, storage->tileSize);
+    storage->tileCols = ceilDiv(storage->cols, storage->tileSize);
+    if (storage->tileOffset(storage->tileRows, 0) > fileSize) {
+        throw std::runtime_error("Размер файла не соответствует заголовку матрицы: " + path);
+    }
+    return TiledMatrix(storage);
+}
+
+TiledMatrix TiledMatrix::fromMatrix(const std::string& path, const Matrix& matrix, size_t tileSize) {
+    TiledMatrix result = create(path, matrix.getRows(), matrix.getCols(), tileSize);
+    std::vector<double> tile(tileSize * tileSize);
+    for (size_t ti = 0; ti < result.tileRows(); ++ti) {
+        for (size_t tj = 0; tj < result.tileCols(); ++tj) {
+            std::fill(tile.begin(), tile.end(), 0.0);
+            const size_t rowEnd = std::min(matrix.getRows(), (ti + 1) * tileSize);
+            const size_t colBegin = tj * tileSize;
+            const size_t colEnd = std::min(matrix.getCols(), colBegin + tileSize);
+            for (size_t r = ti * tileSize; r < rowEnd; ++r) {
+                const std::vector<double>& row = matrix[r];
+                std::copy(row.begin() + colBegin, row.begin() + colEnd, tile.begin() + (r - ti * tileSize) * tileSize);
+            }
+            result.writeTile(ti, tj, &tile[0]);
+        }
+    }
+    return result;
+}
+
+// Методы доступа
+size_t TiledMatrix::getRows() const {
+    return storage_->rows;
+}
+
+size_t TiledMatrix::getCols() const {
+    return storage_->cols;
+}
+
+size_t TiledMatrix::getTileSize() const {
+    return storage_->tileSize;
+}
+
+const std::string& TiledMatrix::getPath() const {
+    return storage_->path;
+}
+
+size_t TiledMatrix::tileRows() const {
+    return storage_->tileRows;
+}
+
+size_t TiledMatrix::tileCols() const {
+    return storage_->tileCols;
+}
+
+double TiledMatrix::get(size_t row, size_t col) const {
+    if (row >= storage_->rows || col >= storage_->cols) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    const size_t t = storage_->tileSize;
+    const uint64_t offset = storage_->tileOffset(row / t, col / t) + ((row % t) * t + col % t) * sizeof(double);
+    double value = 0.0;
+    storage_->read(offset, &value, sizeof(value));
+    return value;
+}
+
+void TiledMatrix::set(size_t row, size_t col, double value) {
+    if (row >= storage_->rows || col >= storage_->cols) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    const size_t t = storage_->tileSize;
+    const uint64_t offset = storage_->tileOffset(row / t, col / t) + ((row % t) * t + col % t) * sizeof(double);
+    storage_->write(offset, &value, sizeof(value));
+}
+
+void TiledMatrix::readTile(size_t tileRow, size_t tileCol, double* buffer) const {
+    if (tileRow >= storage_->tileRows || tileCol >= storage_->tileCols) {
+        throw std::out_of_range("Номер плитки вне границ матрицы");
+    }
+    storage_->read(storage_->tileOffset(tileRow, tileCol), buffer, static_cast<size_t>(storage_->tileBytes()));
+}
+
+void TiledMatrix::writeTile(size_t tileRow, size_t tileCol, const double* buffer) {
+    if (tileRow >= storage_->tileRows || tileCol >= storage_->tileCols) {
+        throw std::out_of_range("Номер плитки вне границ матрицы");
+    }
+    storage_->write(storage_->tileOffset(tileRow, tileCol), buffer, static_cast<size_t>(storage_->tileBytes()));
+}
+
+// Операции
+TiledMatrix TiledMatrix::multiply(const TiledMatrix& other, const std::string& resultPath,
+                                  const OutOfCoreOptions& options) const {
+    if (getCols() != other.getRows()) {
+        throw std::invalid_argument("Несовместимые размеры для умножения матриц");
+    }
+    if (getTileSize() != other.getTileSize()) {
+        throw std::invalid_argument("Размеры плиток матриц различаются");
+    }
+    checkResultPath(*this, resultPath);
+    checkResultPath(other, resultPath);
+
+    const size_t t = getTileSize();
+    const size_t tileElements = t * t;
+    const size_t streamBuffers = options.prefetch ? 2 : 1;
+    // Плитка C, буферы потока плиток B и хотя бы одна плитка A
+    const size_t budget = tileBudget(options, storage_->tileBytes(), streamBuffers + 2);
+
+    const size_t depth = tileCols();
+    const size_t panel = std::min(depth, budget - streamBuffers - 1);
+    TiledMatrix result = create(resultPath, getRows(), other.getCols(), t);
+    if (depth == 0) return result;
+
+    std::vector<double> aPanel(panel * tileElements);
+    std::vector<double> cTile(tileElements);
+    for (size_t i = 0; i < tileRows(); ++i) {
+        const size_t mi = std::min(t, getRows() - i * t);
+        // Полоса плиток A(i, *) читается частями по panel плиток; при нехватке
+        // памяти на всю полосу частичные суммы C накапливаются в файле
+        for (size_t pc = 0; pc < depth; pc += panel) {
+            const size_t pn = std::min(panel, depth - pc);
+            for (size_t q = 0; q < pn; ++q) {
+                readTile(i, pc + q, &aPanel[q * tileElements]);
+            }
+            std::vector<std::pair<size_t, size_t> > order;
+            order.reserve(result.tileCols() * pn);
+            for (size_t j = 0; j < result.tileCols(); ++j) {
+                for (size_t q = 0; q < pn; ++q) order.push_back(std::make_pair(pc + q, j));
+            }
+            TileStream bStream(other, order, options.prefetch);
+
+            for (size_t j = 0; j < result.tileCols(); ++j) {
+                const size_t nj = std::min(t, other.getCols() - j * t);
+                if (pc == 0) {
+                    std::fill(cTile.begin(), cTile.end(), 0.0);
+                } else {
+                    result.readTile(i, j, &cTile[0]);
+                }
+                for (size_t q = 0; q < pn; ++q) {
+                    const size_t kq = std::min(t, getCols() - (pc + q) * t);
+                    Gemm::multiply(mi, nj, kq, &aPanel[q * tileElements], t, bStream.next(), t,
+                                   &cTile[0], t, true);
+                }
+                result.writeTile(i, j, &cTile[0]);
+            }
+        }
+    }
+    return result;
+}
+
+TiledMatrix TiledMatrix::transpose(const std::string& resultPath, const OutOfCoreOptions& options) const {
+    checkResultPath(*this, resultPath);
+    const size_t t = getTileSize();
+    tileBudget(options, storage_->tileBytes(), (options.prefetch ? 2 : 1) + 1);
+
+    TiledMatrix result = create(resultPath, getCols(), getRows(), t);
+    std::vector<std::pair<size_t, size_t> > order;
+    order.reserve(tileRows() * tileCols());
+    for (size_t i = 0; i < tileRows(); ++i) {
+        for (size_t j = 0; j < tileCols(); ++j) order.push_back(std::make_pair(i, j));
+    }
+    TileStream stream(*this, order, options.prefetch);
+
+    const size_t block = 16;  // транспонирование квадратами, помещающимися в кэш
+    std::vector<double> out(t * t);
+    for (size_t n = 0; n < order.size(); ++n) {
+        const double* in = stream.next();
+        for (size_t r0 = 0; r0 < t; r0 += block) {
+            const size_t r1 = std::min(t, r0 + block);
+            for (size_t c0 = 0; c0 < t; c0 += block) {
+                const size_t c1 = std::min(t, c0 + block);
+                for (size_t r = r0; r < r1; ++r) {
+                    for (size_t c = c0; c < c1; ++c) out[c * t + r] = in[r * t + c];
+                }
+            }
+        }
+        result.writeTile(order[n].second, order[n].first, &out[0]);
+    }
+    return result;
+}
+
+TiledMatrix TiledMatrix::add(const TiledMatrix& other, const std::string& resultPath,
+                             const OutOfCoreOptions& options) const {
+    if (getRows() != other.getRows() || getCols() != other.getCols()) {
+        throw std::invalid_argument("Размеры матриц не совпадают для сложения");
+    }
+    if (getTileSize() != other.getTileSize()) {
+        throw std::invalid_argument("Размеры плиток матриц различаются");
+    }
+    checkResultPath(*this, resultPath);
+    checkResultPath(other, resultPath);
+    const size_t t = getTileSize();
+    tileBudget(options, storage_->tileBytes(), 2 * (options.prefetch ? 2 : 1) + 1);
+
+    TiledMatrix result = create(resultPath, getRows(), getCols(), t);
+    std::vector<std::pair<size_t, size_t> > order;
+    order.reserve(tileRows() * tileCols());
+    for (size_t i = 0; i < tileRows(); ++i) {
+        for (size_t j = 0; j < tileCols(); ++j) order.push_back(std::make_pair(i, j));
+    }
+    TileStream aStream(*this, order, options.prefetch);
+    TileStream bStream(other, order, options.prefetch);
+
+    std::vector<double> out(t * t);
+    for (size_t n = 0; n < order.size(); ++n) {
+        const double* a = aStream.next();
+        const double* b = bStream.next();
+        for (size_t e = 0; e < out.size(); ++e) out[e] = a[e] + b[e];
+        result.writeTile(order[n].first, order[n].second, &out[0]);
+    }
+    return result;
+}
+
+Matrix TiledMatrix::toMatrix() const {
+    const size_t t = getTileSize();
+    Matrix result(getRows(), getCols());
+    std::vector<double> tile(t * t);
+    for (size_t ti = 0; ti < tileRows(); ++ti) {
+        for (size_t tj = 0; tj < tileCols(); ++tj) {
+            readTile(ti, tj, &tile[0]);
+            const size_t rowEnd = std::min(getRows(), (ti + 1) * t);
+            const size_t width = std::min(t, getCols() - tj * t);
+            for (size_t r = ti * t; r < rowEnd; ++r) {
+                const double* src = &tile[(r - ti * t) * t];
+                std::copy(src, src + width, result[r].begin() + tj * t);
+            }
+        }
+    }
+    return result;
+}
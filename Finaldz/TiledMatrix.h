@@ -0,0 +1,168 @@
+/**
+ * @file TiledMatrix.h
+ * @brief Матрица во внешней памяти, хранимая квадратными плитками
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef TILEDMATRIX_H
+#define TILEDMATRIX_H
+
+#include <string>
+#include <memory>
+#include "Matrix.h"
+
+/**
+ * @struct OutOfCoreOptions
+ * @brief Параметры операций над матрицами во внешней памяти
+ */
+struct OutOfCoreOptions {
+    size_t memoryLimit;   ///< Наибольший объем буферов плиток в байтах
+    bool prefetch;        ///< Читать следующую плитку в фоне во время вычислений
+
+    OutOfCoreOptions() : memoryLimit(256u * 1024u * 1024u), prefetch(true) {}
+};
+
+/**
+ * @class TiledMatrix
+ * @brief Матрица в файле, разбитая на плитки tileSize x tileSize
+ *
+ * Каждая плитка хранится в файле непрерывно (по строкам, крайние плитки
+ * дополнены нулями), поэтому чтение плитки - одна последовательная
+ * операция ввода-вывода. Операции проходят по плиткам через буферы,
+ * общий объем которых ограничен OutOfCoreOptions::memoryLimit, и
+ * подгружают следующую плитку в фоновом потоке, пока текущая
+ * обрабатывается. Произведение плиток вычисляется тем же ядром Gemm,
+ * что и Matrix::operator*.
+ *
+ * Копии объекта ссылаются на один и тот же файл.
+ */
+class TiledMatrix {
+private:
+    struct Storage;
+    std::shared_ptr<Storage> storage_;  ///< Открытый файл и размеры
+
+    explicit TiledMatrix(const std::shared_ptr<Storage>& storage);
+
+public:
+    static const size_t DEFAULT_TILE_SIZE = 256;  ///< Плитка 256x256 занимает 512 КБ
+
+    /**
+     * @brief Создать файл с нулевой матрицей
+     * @param path Путь к файлу (существующий файл перезаписывается)
+     * @param rows Количество строк
+     * @param cols Количество столбцов
+     * @param tileSize Сторона плитки
+     * @return Матрица, связанная с файлом
+     * @throw std::invalid_argument если tileSize равен нулю
+     * @throw std::runtime_error если файл не удается создать
+     */
+    static TiledMatrix create(const std::string& path, size_t rows, size_t cols,
+                              size_t tileSize = DEFAULT_TILE_SIZE);
+
+    /**
+     * @brief Открыть существующий файл
+     * @param path Путь к файлу
+     * @return Матрица, связанная с файлом
+     * @throw std::runtime_error если файл не открывается или поврежден
+     */
+    static TiledMatrix open(const std::string& path);
+
+    /**
+     * @brief Записать обычную матрицу в файл плитками
+     * @param path Путь к файлу
+     * @param matrix Матрица
+     * @param tileSize Сторона плитки
+     * @return Матрица, связанная с файлом
+     */
+    static TiledMatrix fromMatrix(const std::string& path, const Matrix& matrix,
+                                  size_t tileSize = DEFAULT_TILE_SIZE);
+
+    // Методы доступа
+    size_t getRows() const;
+    size_t getCols() const;
+    size_t getTileSize() const;
+    const std::string& getPath() const;
+
+    /**
+     * @brief Количество плиток по строкам и по столбцам
+     */
+    size_t tileRows() const;
+    size_t tileCols() const;
+
+    /**
+     * @brief Получить элемент (читает его из файла)
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t row, size_t col) const;
+
+    /**
+     * @brief Установить элемент (записывает его в файл)
+     * @throw std::out_of_range если индексы вне границ
+     */
+    void set(size_t row, size_t col, double value);
+
+    /**
+     * @brief Прочитать плитку
+     * @param tileRow Номер плитки по строкам
+     * @param tileCol Номер плитки по столбцам
+     * @param buffer Буфер из tileSize * tileSize элементов
+     * @throw std::out_of_range если номер плитки вне границ
+     */
+    void readTile(size_t tileRow, size_t tileCol, double* buffer) const;
+
+    /**
+     * @brief Записать плитку
+     * @param tileRow Номер плитки по строкам
+     * @param tileCol Номер плитки по столбцам
+     * @param buffer Буфер из tileSize * tileSize элементов
+     * @throw std::out_of_range если номер плитки вне границ
+     */
+    void writeTile(size_t tileRow, size_t tileCol, const double* buffer);
+
+    // Операции
+    /**
+     * @brief Произведение this * other во внешней памяти
+     * @param other Правый множитель с той же стороной плитки
+     * @param resultPath Файл результата
+     * @param options Лимит памяти и предвыборка
+     * @return Результат в файле resultPath
+     * @throw std::invalid_argument если размеры несовместимы, стороны плиток
+     *        различаются, resultPath совпадает с файлом операнда или лимит
+     *        памяти меньше четырех плиток (трех без предвыборки)
+     */
+    TiledMatrix multiply(const TiledMatrix& other, const std::string& resultPath,
+                         const OutOfCoreOptions& options = OutOfCoreOptions()) const;
+
+    /**
+     * @brief Транспонирование во внешней памяти
+     * @param resultPath Файл результата
+     * @param options Лимит памяти и предвыборка
+     * @return Результат в файле resultPath
+     * @throw std::invalid_argument если resultPath совпадает с файлом матрицы
+     *        или лимит памяти меньше трех плиток (двух без предвыборки)
+     */
+    TiledMatrix transpose(const std::string& resultPath,
+                          const OutOfCoreOptions& options = OutOfCoreOptions()) const;
+
+    /**
+     * @brief Сумма this + other во внешней памяти
+     * @param other Слагаемое той же формы и с той же стороной плитки
+     * @param resultPath Файл результата
+     * @param options Лимит памяти и предвыборка
+     * @return Результат в файле resultPath
+     * @throw std::invalid_argument если размеры или стороны плиток различаются,
+     *        resultPath совпадает с файлом операнда или лимит памяти меньше
+     *        пяти плиток (трех без предвыборки)
+     */
+    TiledMatrix add(const TiledMatrix& other, const std::string& resultPath,
+                    const OutOfCoreOptions& options = OutOfCoreOptions()) const;
+
+    /**
+     * @brief Загрузить матрицу в память целиком
+     * @return Обычная матрица
+     */
+    Matrix toMatrix() const;
+};
+
+#endif // TILEDMATRIX_H
@@ -0,0 +1,173 @@
+/**
+ * @file TriangularMatrix.cpp
+ * @brief Реализация упакованной треугольной матрицы
+ */
+
+#include "TriangularMatrix.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const size_t PACKED_COLUMN_BLOCK = 64;  ///< Столбцов правой части в задаче одного потока
+
+} // namespace
+
+// Конструкторы
+TriangularMatrix::TriangularMatrix() : size_(0), shape_(LOWER) {}
+
+TriangularMatrix::TriangularMatrix(size_t size, Shape shape)
+    : size_(size), shape_(shape), data_(size * (size + 1) / 2, 0.0) {}
+
+TriangularMatrix::TriangularMatrix(const Matrix& matrix, Shape shape)
+    : size_(matrix.getRows()), shape_(shape), data_(size_ * (size_ + 1) / 2) {
+    if (!matrix.isSquare()) {
+        throw std::invalid_argument("Треугольная матрица должна быть квадратной");
+    }
+    for (size_t i = 0; i < size_; ++i) {
+        const std::vector<double>& row = matrix[i];
+        std::copy(row.begin() + rowBegin(i), row.begin() + rowEnd(i), data_.begin() + rowOffset(i));
+    }
+}
+
+// Методы доступа
+double TriangularMatrix::get(size_t row, size_t col) const {
+    if (row >= size_ || col >= size_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    if (col < rowBegin(row) || col >= rowEnd(row)) return 0.0;
+    return data_[rowOffset(row) + col - rowBegin(row)];
+}
+
+void TriangularMatrix::set(size_t row, size_t col, double value) {
+    if (row >= size_ || col >= size_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    if (col < rowBegin(row) || col >= rowEnd(row)) {
+        throw std::invalid_argument("Элемент вне заполненного треугольника");
+    }
+    data_[rowOffset(row) + col - rowBegin(row)] = value;
+}
+
+Matrix TriangularMatrix::toMatrix() const {
+    Matrix result(size_, size_);
+    for (size_t i = 0; i < size_; ++i) {
+        const double* packed = &data_[rowOffset(i)];
+        std::copy(packed, packed + rowEnd(i) - rowBegin(i), result[i].begin() + rowBegin(i));
+    }
+    return result;
+}
+
+TriangularMatrix TriangularMatrix::transpose() const {
+    TriangularMatrix result(size_, shape_ == LOWER ? UPPER : LOWER);
+    for (size_t i = 0; i < size_; ++i) {
+        const double* packed = &data_[rowOffset(i)];
+        for (size_t j = rowBegin(i); j < rowEnd(i); ++j) {
+            result.data_[result.rowOffset(j) + i - result.rowBegin(j)] = packed[j - rowBegin(i)];
+        }
+    }
+    return result;
+}
+
+size_t TriangularMatrix::memoryUsage() const {
+    return sizeof(*this) + data_.size() * sizeof(double);
+}
+
+// Операции
+double TriangularMatrix::determinant() const {
+    double det = 1.0;
+    for (size_t i = 0; i < size_; ++i) det *= diagonal(i);
+    return det;
+}
+
+bool TriangularMatrix::isSingular() const {
+    for (size_t i = 0; i < size_; ++i) {
+        if (diagonal(i) == 0.0) return true;
+    }
+    return false;
+}
+
+std::vector<double> TriangularMatrix::multiply(const std::vector<double>& x) const {
+    if (x.size() != size_) {
+        throw std::invalid_argument("Длина вектора не совпадает с порядком матрицы");
+    }
+    std::vector<double> y(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        const double* row = &data_[rowOffset(i)];
+        const double* xs = &x[rowBegin(i)];
+        const size_t length = rowEnd(i) - rowBegin(i);
+        double sum = 0.0;
+        for (size_t j = 0; j < length; ++j) sum += row[j] * xs[j];
+        y[i] = sum;
+    }
+    return y;
+}
+
+Matrix TriangularMatrix::multiply(const Matrix& b) const {
+    if (b.getRows() != size_) {
+        throw std::invalid_argument("Несовместимые размеры для умножения матриц");
+    }
+    Matrix result(size_, b.getCols());
+    Parallel::forEachBlock(b.getCols(), PACKED_COLUMN_BLOCK, [&](size_t, size_t begin, size_t end) {
+        const size_t width = end - begin;
+        for (size_t i = 0; i < size_; ++i) {
+            const double* row = &data_[rowOffset(i)];
+            double* ci = &result[i][begin];
+            for (size_t j = rowBegin(i); j < rowEnd(i); ++j) {
+                const double a = row[j - rowBegin(i)];
+                const double* bj = &b[j][begin];
+                for (size_t c = 0; c < width; ++c) ci[c] += a * bj[c];
+            }
+        }
+    });
+    return result;
+}
+
+std::vector<double> TriangularMatrix::solve(const std::vector<double>& b) const {
+    if (b.size() != size_) {
+        throw std::invalid_argument("Длина правой части не совпадает с порядком матрицы");
+    }
+    if (isSingular()) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    std::vector<double> x(b);
+    // Строка i использует уже найденные x[j] из своей ненулевой части
+    for (size_t step = 0; step < size_; ++step) {
+        const size_t i = shape_ == LOWER ? step : size_ - 1 - step;
+        const double* row = &data_[rowOffset(i)];
+        const size_t first = rowBegin(i);
+        double sum = x[i];
+        for (size_t j = offDiagonalBegin(i); j < offDiagonalEnd(i); ++j) sum -= row[j - first] * x[j];
+        x[i] = sum / row[i - first];
+    }
+    return x;
+}
+
+Matrix TriangularMatrix::solve(const Matrix& b) const {
+    if (b.getRows() != size_) {
+        throw std::invalid_argument("Число строк правой части не совпадает с порядком матрицы");
+    }
+    if (isSingular()) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    Matrix result(b);
+    // Подстановка по строкам: внутренний цикл идет по непрерывной строке X
+    Parallel::forEachBlock(b.getCols(), PACKED_COLUMN_BLOCK, [&](size_t, size_t begin, size_t end) {
+        const size_t width = end - begin;
+        for (size_t step = 0; step < size_; ++step) {
+            const size_t i = shape_ == LOWER ? step : size_ - 1 - step;
+            const double* row = &data_[rowOffset(i)];
+            const size_t first = rowBegin(i);
+            double* xi = &result[i][begin];
+            for (size_t j = offDiagonalBegin(i); j < offDiagonalEnd(i); ++j) {
+                const double a = row[j - first];
+                const double* xj = &result[j][begin];
+                for (size_t c = 0; c < width; ++c) xi[c] -= a * xj[c];
+            }
+            const double inv = 1.0 / row[i - first];
+            for (size_t c = 0; c < width; ++c) xi[c] *= inv;
+        }
+    });
+    return result;
+}
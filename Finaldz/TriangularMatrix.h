@@ -0,0 +1,143 @@
+/**
+ * @file TriangularMatrix.h
+ * @brief Треугольная матрица в упакованном виде
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef TRIANGULARMATRIX_H
+#define TRIANGULARMATRIX_H
+
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * @class TriangularMatrix
+ * @brief Нижне- или верхнетреугольная матрица без хранения нулей
+ *
+ * Ненулевая часть каждой строки (столбцы 0..i для LOWER, i..n-1 для
+ * UPPER) лежит в непрерывном массиве из n * (n + 1) / 2 чисел.
+ * Умножение и решение систем обходят только ненулевой треугольник:
+ * n^2 операций на вектор вместо 2 * n^2 у плотной матрицы.
+ *
+ * solve() - прямая или обратная подстановка за O(n^2) без разложения;
+ * для нескольких правых частей столбцы делятся между потоками.
+ */
+class TriangularMatrix {
+public:
+    /**
+     * @brief Заполненный треугольник
+     */
+    enum Shape {
+        LOWER,  ///< Нули выше диагонали
+        UPPER   ///< Нули ниже диагонали
+    };
+
+private:
+    size_t size_;               ///< Порядок матрицы
+    Shape shape_;               ///< Заполненный треугольник
+    std::vector<double> data_;  ///< Ненулевые части строк подряд
+
+    size_t rowOffset(size_t row) const {
+        return shape_ == LOWER ? row * (row + 1) / 2 : row * size_ - row * (row - 1) / 2;
+    }
+    size_t rowBegin(size_t row) const { return shape_ == LOWER ? 0 : row; }
+    size_t rowEnd(size_t row) const { return shape_ == LOWER ? row + 1 : size_; }
+    size_t offDiagonalBegin(size_t row) const { return shape_ == LOWER ? 0 : row + 1; }
+    size_t offDiagonalEnd(size_t row) const { return shape_ == LOWER ? row : size_; }
+    double diagonal(size_t row) const { return data_[rowOffset(row) + row - rowBegin(row)]; }
+
+public:
+    /**
+     * @brief Конструктор по умолчанию
+     * Создает пустую нижнетреугольную матрицу
+     */
+    TriangularMatrix();
+
+    /**
+     * @brief Конструктор нулевой матрицы
+     * @param size Порядок матрицы
+     * @param shape Заполненный треугольник
+     */
+    TriangularMatrix(size_t size, Shape shape);
+
+    /**
+     * @brief Упаковать треугольник матрицы
+     * @param matrix Квадратная матрица; элементы другого треугольника отбрасываются
+     * @param shape Заполненный треугольник
+     * @throw std::invalid_argument если матрица не квадратная
+     */
+    TriangularMatrix(const Matrix& matrix, Shape shape);
+
+    // Методы доступа
+    size_t size() const { return size_; }
+    Shape getShape() const { return shape_; }
+    const std::vector<double>& data() const { return data_; }
+
+    /**
+     * @brief Получить элемент (вне треугольника - ноль)
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t row, size_t col) const;
+
+    /**
+     * @brief Установить элемент треугольника
+     * @throw std::out_of_range если индексы вне границ
+     * @throw std::invalid_argument если элемент вне треугольника
+     */
+    void set(size_t row, size_t col, double value);
+
+    /**
+     * @brief Развернуть в обычную матрицу
+     */
+    Matrix toMatrix() const;
+
+    /**
+     * @brief Транспонированная матрица (LOWER становится UPPER и наоборот)
+     */
+    TriangularMatrix transpose() const;
+
+    /**
+     * @brief Объем занимаемой памяти в байтах
+     */
+    size_t memoryUsage() const;
+
+    // Операции
+    /**
+     * @brief Определитель - произведение диагонали
+     */
+    double determinant() const;
+
+    /**
+     * @brief Есть ли на диагонали ноль
+     */
+    bool isSingular() const;
+
+    /**
+     * @brief Произведение A * x
+     * @throw std::invalid_argument если длина x не совпадает с порядком
+     */
+    std::vector<double> multiply(const std::vector<double>& x) const;
+
+    /**
+     * @brief Произведение A * B
+     * @throw std::invalid_argument если число строк B не совпадает с порядком
+     */
+    Matrix multiply(const Matrix& b) const;
+
+    /**
+     * @brief Решить систему A * x = b подстановкой
+     * @throw std::invalid_argument если длина b не совпадает с порядком
+     *        или на диагонали есть ноль
+     */
+    std::vector<double> solve(const std::vector<double>& b) const;
+
+    /**
+     * @brief Решить систему A * X = B для нескольких правых частей
+     * @throw std::invalid_argument если число строк B не совпадает с порядком
+     *        или на диагонали есть ноль
+     */
+    Matrix solve(const Matrix& b) const;
+};
+
+#endif // TRIANGULARMATRIX_H
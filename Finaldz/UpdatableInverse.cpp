@@ -0,0 +1,309 @@
+/**
+ * @file UpdatableInverse.cpp
+ * @brief Реализация обновляемой обратной матрицы
+ */
+
+#include "UpdatableInverse.h"
+#include "LUDecomposition.h"
+#include "Gemm.h"
+#include <cmath>
+#include <stdexcept>
+
+const size_t UpdatableInverse::DEFAULT_REFACTOR_INTERVAL;
+
+namespace {
+
+/// Знаменатель обновления меньше этой доли от |v^T A^-1 u| считается
+/// потерей точности: результат получен бы вычитанием близких чисел
+const double UPDATE_TOLERANCE = 1e-8;
+
+bool stableDenominator(double denominator, double term) {
+    const double scale = std::abs(term) > 1.0 ? std::abs(term) : 1.0;
+    return std::abs(denominator) > UPDATE_TOLERANCE * scale;
+}
+
+} // namespace
+
+// Конструктор
+UpdatableInverse::UpdatableInverse(const Matrix& matrix, size_t refactorInterval)
+    : size_(matrix.getRows()), determinant_(0.0), singular_(false), updates_(0),
+      refactorInterval_(refactorInterval) {
+    if (!matrix.isSquare()) {
+        throw std::invalid_argument("Обратная матрица существует только для квадратных матриц");
+    }
+    matrix_.resize(size_ * size_);
+    for (size_t i = 0; i < size_; ++i) {
+        const std::vector<double>& row = matrix[i];
+        for (size_t j = 0; j < size_; ++j) matrix_[i * size_ + j] = row[j];
+    }
+    refactorize();
+    if (singular_) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+}
+
+// Методы доступа
+Matrix UpdatableInverse::matrix() const {
+    Matrix result(size_, size_);
+    for (size_t i = 0; i < size_; ++i) {
+        std::vector<double>& row = result[i];
+        for (size_t j = 0; j < size_; ++j) row[j] = matrix_[i * size_ + j];
+    }
+    return result;
+}
+
+double UpdatableInverse::get(size_t row, size_t col) const {
+    if (row >= size_ || col >= size_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    return matrix_[row * size_ + col];
+}
+
+Matrix UpdatableInverse::inverse() const {
+    if (singular_) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    Matrix result(size_, size_);
+    for (size_t i = 0; i < size_; ++i) {
+        std::vector<double>& row = result[i];
+        for (size_t j = 0; j < size_; ++j) row[j] = inverse_[i * size_ + j];
+    }
+    return result;
+}
+
+std::vector<double> UpdatableInverse::solve(const std::vector<double>& b) const {
+    if (b.size() != size_) {
+        throw std::invalid_argument("Длина правой части не совпадает с порядком матрицы");
+    }
+    if (singular_) {
+        throw std::invalid_argument("Матрица вырожденная (определитель равен нулю)");
+    }
+    std::vector<double> x(size_, 0.0);
+    for (size_t i = 0; i < size_; ++i) {
+        const double* row = &inverse_[i * size_];
+        double sum = 0.0;
+        for (size_t j = 0; j < size_; ++j) sum += row[j] * b[j];
+        x[i] = sum;
+    }
+    return x;
+}
+
+// Обновления
+void UpdatableInverse::applyRankOne(const std::vector<double>& inverseU, const std::vector<double>& vInverse,
+                                    double denominator) {
+    const size_t n = size_;
+    const double scale = 1.0 / denominator;
+    for (size_t i = 0; i < n; ++i) {
+        const double factor = inverseU[i] * scale;
+        double* row = &inverse_[i * n];
+        for (size_t j = 0; j < n; ++j) row[j] -= factor * vInverse[j];
+    }
+    determinant_ *= denominator;
+}
+
+void UpdatableInverse::afterUpdate(bool stable) {
+    ++updates_;
+    if (!stable || (refactorInterval_ != 0 && updates_ >= refactorInterval_)) {
+        refactorize();
+    }
+}
+
+void UpdatableInverse::set(size_t row, size_t col, double value) {
+    if (row >= size_ || col >= size_) {
+        throw std::out_of_range("Индекс вне границ матрицы");
+    }
+    const size_t n = size_;
+    const double delta = value - matrix_[row * n + col];
+    if (delta == 0.0) return;
+    matrix_[row * n + col] = value;
+    if (singular_) {
+        refactorize();
+        return;
+    }
+
+    // u = delta * e_row, v = e_col: A^-1 u - столбец row, v^T A^-1 - строка col
+    std::vector<double> inverseU(n);
+    for (size_t i = 0; i < n; ++i) inverseU[i] = delta * inverse_[i * n + row];
+    const std::vector<double> vInverse(inverse_.begin() + col * n, inverse_.begin() + (col + 1) * n);
+    const double term = delta * inverse_[col * n + row];
+    const double denominator = 1.0 + term;
+    const bool stable = stableDenominator(denominator, term);
+    if (stable) applyRankOne(inverseU, vInverse, denominator);
+    afterUpdate(stable);
+}
+
+void UpdatableInverse::setRow(size_t row, const std::vector<double>& values) {
+    if (row >= size_) {
+        throw std::out_of_range("Индекс строки вне границ");
+    }
+    if (values.size() != size_) {
+        throw std::invalid_argument("Длина строки не совпадает с порядком матрицы");
+    }
+    const size_t n = size_;
+    // u = e_row, v = новая строка - старая строка
+    std::vector<double> v(n);
+    for (size_t j = 0; j < n; ++j) {
+        v[j] = values[j] - matrix_[row * n + j];
+        matrix_[row * n + j] = values[j];
+    }
+    if (singular_) {
+        refactorize();
+        return;
+    }
+
+    std::vector<double> inverseU(n);
+    for (size_t i = 0; i < n; ++i) inverseU[i] = inverse_[i * n + row];
+    std::vector<double> vInverse(n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        const double vi = v[i];
+        const double* inv = &inverse_[i * n];
+        for (size_t j = 0; j < n; ++j) vInverse[j] += vi * inv[j];
+    }
+    const double term = vInverse[row];
+    const double denominator = 1.0 + term;
+    const bool stable = stableDenominator(denominator, term);
+    if (stable) applyRankOne(inverseU, vInverse, denominator);
+    afterUpdate(stable);
+}
+
+void UpdatableInverse::setColumn(size_t col, const std::vector<double>& values) {
+    if (col >= size_) {
+        throw std::out_of_range("Индекс столбца вне границ");
+    }
+    if (values.size() != size_) {
+        throw std::invalid_argument("Длина столбца не совпадает с порядком матрицы");
+    }
+    const size_t n = size_;
+    // u = новый столбец - старый столбец, v = e_col
+    std::vector<double> u(n);
+    for (size_t i = 0; i < n; ++i) {
+        u[i] = values[i] - matrix_[i * n + col];
+        matrix_[i * n + col] = values[i];
+    }
+    if (singular_) {
+        refactorize();
+        return;
+    }
+
+    std::vector<double> inverseU(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double* inv = &inverse_[i * n];
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j) sum += inv[j] * u[j];
+        inverseU[i] = sum;
+    }
+    const std::vector<double> vInverse(inverse_.begin() + col * n, inverse_.begin() + (col + 1) * n);
+    const double term = inverseU[col];
+    const double denominator = 1.0 + term;
+    const bool stable = stableDenominator(denominator, term);
+    if (stable) applyRankOne(inverseU, vInverse, denominator);
+    afterUpdate(stable);
+}
+
+void UpdatableInverse::rankOneUpdate(const std::vector<double>& u, const std::vector<double>& v) {
+    if (u.size() != size_ || v.size() != size_) {
+        throw std::invalid_argument("Длины векторов не совпадают с порядком матрицы");
+    }
+    const size_t n = size_;
+    for (size_t i = 0; i < n; ++i) {
+        double* row = &matrix_[i * n];
+        for (size_t j = 0; j < n; ++j) row[j] += u[i] * v[j];
+    }
+    if (singular_) {
+        refactorize();
+        return;
+    }
+
+    std::vector<double> inverseU(n);
+    std::vector<double> vInverse(n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        const double* inv = &inverse_[i * n];
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j) sum += inv[j] * u[j];
+        inverseU[i] = sum;
+        const double vi = v[i];
+        for (size_t j = 0; j < n; ++j) vInverse[j] += vi * inv[j];
+    }
+    double term = 0.0;
+    for (size_t i = 0; i < n; ++i) term += v[i] * inverseU[i];
+    const double denominator = 1.0 + term;
+    const bool stable = stableDenominator(denominator, term);
+    if (stable) applyRankOne(inverseU, vInverse, denominator);
+    afterUpdate(stable);
+}
+
+void UpdatableInverse::update(const Matrix& u, const Matrix& v) {
+    const size_t n = size_;
+    const size_t k = u.getCols();
+    if (u.getRows() != n || v.getRows() != n || v.getCols() != k) {
+        throw std::invalid_argument("Матрицы обновления должны иметь размер n x k");
+    }
+    if (k == 0) return;
+
+    std::vector<double> uData(n * k);
+    std::vector<double> vTransposed(k * n);
+    for (size_t i = 0; i < n; ++i) {
+        const std::vector<double>& uRow = u[i];
+        const std::vector<double>& vRow = v[i];
+        for (size_t c = 0; c < k; ++c) {
+            uData[i * k + c] = uRow[c];
+            vTransposed[c * n + i] = vRow[c];
+        }
+    }
+    // A += U * V^T
+    Gemm::multiply(n, n, k, &uData[0], k, &vTransposed[0], n, &matrix_[0], n, true);
+    if (singular_) {
+        refactorize();
+        return;
+    }
+
+    // X = A^-1 U (n x k), Y = V^T A^-1 (k x n), C = I + V^T X (k x k)
+    std::vector<double> x(n * k);
+    std::vector<double> y(k * n);
+    std::vector<double> capacitance(k * k);
+    Gemm::multiply(n, k, n, &inverse_[0], n, &uData[0], k, &x[0], k);
+    Gemm::multiply(k, n, n, &vTransposed[0], n, &inverse_[0], n, &y[0], n);
+    Gemm::multiply(k, k, n, &vTransposed[0], n, &x[0], k, &capacitance[0], k);
+    Matrix c(k, k);
+    for (size_t r = 0; r < k; ++r) {
+        for (size_t s = 0; s < k; ++s) c.set(r, s, capacitance[r * k + s] + (r == s ? 1.0 : 0.0));
+    }
+    const LUDecomposition factor(c);
+    const double capacitanceDeterminant = factor.determinant();
+    const bool stable = !factor.isSingular() && std::abs(capacitanceDeterminant) > UPDATE_TOLERANCE;
+    if (stable) {
+        // A^-1 -= X * (C^-1 Y)
+        Matrix yMatrix(k, n);
+        for (size_t r = 0; r < k; ++r) {
+            std::vector<double>& row = yMatrix[r];
+            for (size_t j = 0; j < n; ++j) row[j] = y[r * n + j];
+        }
+        const Matrix z = factor.solve(yMatrix);
+        std::vector<double> zData(k * n);
+        for (size_t r = 0; r < k; ++r) {
+            const std::vector<double>& row = z[r];
+            for (size_t j = 0; j < n; ++j) zData[r * n + j] = row[j];
+        }
+        for (size_t e = 0; e < x.size(); ++e) x[e] = -x[e];
+        Gemm::multiply(n, n, k, &x[0], k, &zData[0], n, &inverse_[0], n, true);
+        determinant_ *= capacitanceDeterminant;
+    }
+    afterUpdate(stable);
+}
+
+void UpdatableInverse::refactorize() {
+    const LUDecomposition factor(matrix());
+    updates_ = 0;
+    singular_ = factor.isSingular();
+    if (singular_) {
+        determinant_ = 0.0;
+        return;
+    }
+    determinant_ = factor.determinant();
+    const Matrix inv = factor.inverse();
+    inverse_.resize(size_ * size_);
+    for (size_t i = 0; i < size_; ++i) {
+        const std::vector<double>& row = inv[i];
+        for (size_t j = 0; j < size_; ++j) inverse_[i * size_ + j] = row[j];
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file UpdatableInverse.h
+ * @brief Обратная матрица и определитель с быстрым обновлением малого ранга
+ * @author Ваше имя
+ * @date 2024
+ */
+
+#ifndef UPDATABLEINVERSE_H
+#define UPDATABLEINVERSE_H
+
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * @class UpdatableInverse
+ * @brief Поддерживает A^-1 и det(A) при изменениях A малого ранга
+ *
+ * Изменение A + u * v^T пересчитывается по формуле Шермана - Моррисона
+ * за O(n^2) вместо O(n^3):
+ *   (A + u v^T)^-1 = A^-1 - (A^-1 u)(v^T A^-1) / (1 + v^T A^-1 u),
+ * а определитель - по лемме об определителе матрицы:
+ *   det(A + u v^T) = det(A) * (1 + v^T A^-1 u).
+ * Изменение ранга k (A + U V^T) пересчитывается по формуле
+ * Вудбери за O(n^2 k + k^3).
+ *
+ * Замена элемента, строки или столбца - частные случаи ранга 1.
+ * Погрешность округления накапливается с каждым обновлением, поэтому
+ * через заданное число обновлений обратная матрица вычисляется заново
+ * через LU-разложение (refactorize). Если знаменатель обновления близок
+ * к нулю, пересчет выполняется сразу.
+ */
+class UpdatableInverse {
+private:
+    size_t size_;                  ///< Порядок матрицы
+    std::vector<double> matrix_;   ///< Текущая A по строкам
+    std::vector<double> inverse_;  ///< A^-1 по строкам
+    double determinant_;           ///< det(A)
+    bool singular_;                ///< A вырождена, A^-1 не определена
+    size_t updates_;               ///< Обновлений после последнего пересчета
+    size_t refactorInterval_;      ///< Пересчитывать после стольких обновлений (0 - никогда)
+
+    void applyRankOne(const std::vector<double>& inverseU, const std::vector<double>& vInverse, double denominator);
+    void afterUpdate(bool stable);
+
+public:
+    static const size_t DEFAULT_REFACTOR_INTERVAL = 64;  ///< Обновлений между пересчетами по умолчанию
+
+    /**
+     * @brief Конструктор
+     * @param matrix Квадратная невырожденная матрица
+     * @param refactorInterval Число обновлений между полными пересчетами (0 - только по требованию)
+     * @throw std::invalid_argument если матрица не квадратная или вырожденная
+     */
+    explicit UpdatableInverse(const Matrix& matrix, size_t refactorInterval = DEFAULT_REFACTOR_INTERVAL);
+
+    // Методы доступа
+    size_t size() const { return size_; }
+    bool isSingular() const { return singular_; }
+    size_t updatesSinceRefactor() const { return updates_; }
+    size_t getRefactorInterval() const { return refactorInterval_; }
+    void setRefactorInterval(size_t interval) { refactorInterval_ = interval; }
+
+    /**
+     * @brief Текущая матрица A
+     */
+    Matrix matrix() const;
+
+    /**
+     * @brief Элемент текущей матрицы
+     * @throw std::out_of_range если индексы вне границ
+     */
+    double get(size_t row, size_t col) const;
+
+    /**
+     * @brief Обратная матрица A^-1
+     * @throw std::invalid_argument если матрица вырожденная
+     */
+    Matrix inverse() const;
+
+    /**
+     * @brief Определитель det(A) (0 для вырожденной матрицы)
+     */
+    double determinant() const { return singular_ ? 0.0 : determinant_; }
+
+    /**
+     * @brief Решить A * x = b умножением на A^-1 за O(n^2)
+     * @param b Правая часть
+     * @return Решение x
+     * @throw std::invalid_argument если длина b не совпадает с порядком
+     *        или матрица вырожденная
+     */
+    std::vector<double> solve(const std::vector<double>& b) const;
+
+    // Обновления
+    /**
+     * @brief Заменить элемент A[row][col]
+     * @throw std::out_of_range если индексы вне границ
+     */
+    void set(size_t row, size_t col, double value);
+
+    /**
+     * @brief Заменить строку
+     * @throw std::out_of_range если номер строки вне границ
+     * @throw std::invalid_argument если длина строки не совпадает с порядком
+     */
+    void setRow(size_t row, const std::vector<double>& values);
+
+    /**
+     * @brief Заменить столбец
+     * @throw std::out_of_range если номер столбца вне границ
+     * @throw std::invalid_argument если длина столбца не совпадает с порядком
+     */
+    void setColumn(size_t col, const std::vector<double>& values);
+
+    /**
+     * @brief Обновление ранга 1: A += u * v^T
+     * @throw std::invalid_argument если длины векторов не совпадают с порядком
+     */
+    void rankOneUpdate(const std::vector<double>& u, const std::vector<double>& v);
+
+    /**
+     * @brief Обновление ранга k: A += U * V^T
+     * @param u Матрица n x k
+     * @param v Матрица n x k
+     * @throw std::invalid_argument если размеры U и V не n x k
+     */
+    void update(const Matrix& u, const Matrix& v);
+
+    /**
+     * @brief Пересчитать A^-1 и det(A) заново через LU-разложение
+     */
+    void refactorize();
+};
+
+#endif // UPDATABLEINVERSE_H
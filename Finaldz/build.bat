@@ -10,7 +10,7 @@ if exist "%InstallDir%\VC\Auxiliary\Build\vcvars64.bat" (
     echo Найден Visual Studio, инициализация среды...
     call "%InstallDir%\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
     echo Компиляция с помощью cl.exe...
-    cl /EHsc /std:c++14 Finaldz.cpp Complex.cpp Vector3D.cpp Matrix.cpp Fraction.cpp /Fe:math_library.exe
+    cl /EHsc /O2 /std:c++14 Finaldz.cpp Complex.cpp Vector3D.cpp Matrix.cpp Fraction.cpp Parallel.cpp BoundingBox.cpp BVH.cpp SpatialHashGrid.cpp SpatialOrder.cpp PointReduction.cpp AffineTransform.cpp FFT.cpp ComplexArray.cpp Convolution.cpp Polynomial.cpp Fractal.cpp FractionReduction.cpp TextIO.cpp MatrixFile.cpp Gemm.cpp TiledMatrix.cpp LUDecomposition.cpp MatrixCache.cpp UpdatableInverse.cpp SmallMatrix.cpp MatrixBatch.cpp MatrixChain.cpp QuantizedMatrix.cpp SymmetricMatrix.cpp TriangularMatrix.cpp BandMatrix.cpp /Fe:math_library.exe
     if errorlevel 0 (
         echo Компиляция успешна!
         echo Запуск программы...
@@ -23,7 +23,7 @@ if exist "%InstallDir%\VC\Auxiliary\Build\vcvars64.bat" (
     echo Попытка использовать g++...
     g++ --version >nul 2>&1
     if errorlevel 0 (
-        g++ -std=c++11 -o math_library.exe Finaldz.cpp Complex.cpp Vector3D.cpp Matrix.cpp Fraction.cpp
+        g++ -std=c++11 -O2 -pthread -o math_library.exe Finaldz.cpp Complex.cpp Vector3D.cpp Matrix.cpp Fraction.cpp Parallel.cpp BoundingBox.cpp BVH.cpp SpatialHashGrid.cpp SpatialOrder.cpp PointReduction.cpp AffineTransform.cpp FFT.cpp ComplexArray.cpp Convolution.cpp Polynomial.cpp Fractal.cpp FractionReduction.cpp TextIO.cpp MatrixFile.cpp Gemm.cpp TiledMatrix.cpp LUDecomposition.cpp MatrixCache.cpp UpdatableInverse.cpp SmallMatrix.cpp MatrixBatch.cpp MatrixChain.cpp QuantizedMatrix.cpp SymmetricMatrix.cpp TriangularMatrix.cpp BandMatrix.cpp
         if errorlevel 0 (
             echo Компиляция с g++ успешна!
             echo Запуск программы...